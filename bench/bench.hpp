@@ -0,0 +1,55 @@
+/**
+ * @file bench.hpp
+ * @brief Defines the timing of the benchmarks : each case is run several
+ * times, and the best time is printed.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef BENCH_HPP_INCLUDED
+#define BENCH_HPP_INCLUDED
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+/**
+ * @brief Run \a work \a runs times, and print its best time.
+ * @param[in] name  What is measured.
+ * @param[in] work  The work to measure.
+ * @param[in] runs  The number of runs.
+ * @return The best time, in milliseconds.
+ */
+inline double measure(const std::string &name, std::function<void(void)> work, int runs = 5)
+{
+	double best = 0.0;
+	for (int run = 0; run < runs; ++run)
+	{
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		work();
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if (run == 0 || ms < best)
+			best = ms;
+	}
+	std::printf("%-48s %10.2f ms\n", name.c_str(), best);
+	return best;
+}
+
+/**
+ * @brief Keep \a value from being optimized away : the compiler is told it is
+ * read, without any store.
+ */
+template<typename T>
+inline void keep(const T &value)
+{
+#if defined(__GNUC__)
+	asm volatile("" : : "g"(&value) : "memory");
+#else
+	static const void *volatile sink = nullptr;
+	sink = &value;
+	(void)sink;
+#endif
+}
+
+#endif
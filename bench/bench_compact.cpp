@@ -0,0 +1,71 @@
+/**
+ * @file bench_compact.cpp
+ * @brief Measures walking a document loaded lazily and expanded piece by piece,
+ * before and after it is compacted, and the memory the process holds for it.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <fstream>
+#include <iostream>
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+/**
+ * @brief The memory resident in the process, in MB, as the system counts it.
+ */
+static size_t residentMB(void)
+{
+	std::ifstream status("/proc/self/status");
+	std::string key;
+	size_t kb = 0;
+	while (status >> key)
+	{
+		if (key == "VmRSS:")
+		{
+			status >> kb;
+			break;
+		}
+	}
+	return kb / 1024;
+}
+
+/**
+ * @brief Read every price and tag.
+ */
+static double walk(XmlLoader &loader)
+{
+	double sum = 0.0;
+	for (XmlCursor record : loader.backToRoot().children("record"))
+	{
+		sum += record.element("price").text<double>();
+		for (XmlCursor tag : record.element("tags").children("tag"))
+			sum += tag.text<std::string>().size();
+	}
+	return sum;
+}
+
+int main(void)
+{
+	writeFile("bench-compact.xml", catalog(500000));
+	const size_t empty = residentMB();
+	XmlOptions options;
+	options.lazyDepth = 1;
+	XmlLoader loader("bench-compact.xml", options);
+	// Expanded out of document order, as a long lived document is read.
+	for (size_t step : {7, 3, 1})
+	{
+		size_t i = 0;
+		loader.backToRoot().forEachNodeNamed("record", [&](XmlCursor record) {
+			if (i++ % step == 0)
+				keep(record.element("price").text<double>());
+		});
+	}
+	std::cout << "resident, loaded then expanded               " << residentMB() - empty << " MB" << std::endl;
+	measure("walk, expanded out of order", [&]() { keep(walk(loader)); });
+	loader.compact();
+	std::cout << "resident, compacted                          " << residentMB() - empty << " MB" << std::endl;
+	measure("walk, compacted", [&]() { keep(walk(loader)); });
+	return 0;
+}
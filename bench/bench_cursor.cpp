@@ -0,0 +1,54 @@
+/**
+ * @file bench_cursor.cpp
+ * @brief Measures reading the 40 fields of each record in document order :
+ * searched from the first child each time, with the cursor mode, and in a
+ * single explicit pass with nextElement().
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <vector>
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+static const int fields = 40; //!< The fields of each record.
+
+int main(void)
+{
+	std::vector<std::string> names;
+	for (int f = 0; f < fields; ++f)
+		names.push_back("f" + std::to_string(f));
+	std::string xml("<records>\n");
+	for (int i = 0; i < 20000; ++i)
+	{
+		xml += "<r>";
+		for (int f = 0; f < fields; ++f)
+			xml += "<" + names[f] + ">" + std::to_string(i + f) + "</" + names[f] + ">";
+		xml += "</r>\n";
+	}
+	XmlLoader loader(writeFile("bench-cursor.xml", xml + "</records>\n"));
+
+	for (bool cursor : {false, true})
+	{
+		loader.cursorMode(cursor);
+		measure(cursor ? "40 fields in order, cursor mode" : "40 fields in order, from the first child", [&]() {
+			long sum = 0;
+			loader.backToRoot().forEachNodeNamed("r", [&]() {
+				for (const std::string &name : names)
+					sum += loader.element(name).text<int>();
+			});
+			keep(sum);
+		});
+	}
+	loader.cursorMode(false);
+	measure("40 fields, nextElement()", [&]() {
+		long sum = 0;
+		loader.backToRoot().forEachNodeNamed("r", [&]() {
+			while (loader.nextElement())
+				sum += loader.text<int>();
+		});
+		keep(sum);
+	});
+	return 0;
+}
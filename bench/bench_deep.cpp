@@ -0,0 +1,45 @@
+/**
+ * @file bench_deep.cpp
+ * @brief Measures parsing, printing and deleting chains of nested elements,
+ * from 10 levels to 1M deep. Each case handles 1M levels in all, so the
+ * times stay flat when the cost per level does not depend on the depth.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <memory>
+#include <vector>
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+int main(void)
+{
+	const size_t levels = 1000000;
+	for (size_t depth = 10; depth <= levels; depth *= 10)
+	{
+		const std::string xml   = deep(depth);
+		const std::string label = ", depth " + std::to_string(depth);
+		std::vector<std::unique_ptr<xml2::XMLDocument> > docs;
+		measure("parse" + label, [&]() {
+			docs.clear();
+			for (size_t i = 0; i < levels / depth; ++i)
+			{
+				docs.emplace_back(new xml2::XMLDocument());
+				docs.back()->Parse(xml.data(), xml.size());
+			}
+		}, 1);
+		measure("print" + label, [&]() {
+			for (const std::unique_ptr<xml2::XMLDocument> &doc : docs)
+			{
+				xml2::XMLPrinter printer(nullptr, true);
+				doc->Print(&printer);
+				keep(printer.CStrSize());
+			}
+		}, 1);
+		measure("delete" + label, [&]() {
+			docs.clear();
+		}, 1);
+	}
+	return 0;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file bench_flat.cpp
+ * @brief Measures reading every record of a catalog through the pointers of
+ * the document, then through the frozen flat copy (see XmlFlat).
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+/**
+ * @brief Select a few fields of every record, as a reader does.
+ */
+static void walk(XmlLoader &loader)
+{
+	size_t found = 0;
+	loader.forEachNodeNamed("record", [&]() {
+		found += loader.element("price").rawText().size;
+		found += loader.element("name").rawText().size;
+		loader.node("tags").forEachElementNamed("tag", [&]() { ++found; });
+		loader.prev();
+	});
+	keep(found);
+}
+
+int main(void)
+{
+	XmlLoader loader(writeFile("bench-flat.xml", catalog(300000)));
+	measure("300k records, pointer document", [&]() { walk(loader); });
+	measure("reload and freeze", [&]() { loader.reload("bench-flat.xml").freeze(); }, 1);
+	measure("300k records, frozen document", [&]() { walk(loader); });
+	return 0;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file bench_hash.cpp
+ * @brief Measures XmlLoader::hashAll() on a catalog of about 100 MB, from 1
+ * thread to one per core : each case reloads and freezes the document, whose
+ * own cost is measured first.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <algorithm>
+#include <thread>
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+int main(void)
+{
+	const std::string xml = catalog(750000);
+	XmlLoader loader(writeFile("bench-hash.xml", xml));
+	std::printf("%-48s %10zu MB\n", "document", xml.size() / (1024 * 1024));
+
+	measure("reload and freeze", [&]() { loader.reload("bench-hash.xml").freeze(); }, 3);
+	const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned threads = 1; threads <= std::max(4u, cores); threads *= 2)
+	{
+		measure("reload, freeze and hashAll, " + std::to_string(threads) + " thread(s)", [&]() {
+			keep(loader.reload("bench-hash.xml").freeze().hashAll(threads).hash());
+		}, 3);
+	}
+
+	// Once hashed, comparing two records costs the same whatever their size.
+	measure("750k records compared to the first, by hash", [&]() {
+		const uint64_t first = loader.backToRoot().node("record").hash();
+		size_t equal = 0;
+		loader.backToRoot().forEachNodeNamed("record", [&]() { equal += (loader.hash() == first) ? 1 : 0; });
+		keep(equal);
+	});
+	std::printf("%u core(s)\n", cores);
+	return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file bench_hugepages.cpp
+ * @brief Measures parsing and walking a big document allocated from the heap,
+ * and in regions the kernel can back with huge pages.
+ * What the system offers is printed first : without transparent huge pages
+ * nor reserved ones, the three modes allocate the same way. The misses of
+ * the data TLB of one parse and one walk are counted with perf_event_open(),
+ * where the kernel and the processor allow it.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+#if defined(__linux__)
+#	include <linux/perf_event.h>
+#	include <sys/ioctl.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#	define RWXML_WITH_PERF_EVENTS
+#endif
+
+/**
+ * @brief A counter of the read misses of the data TLB, of this thread, out of the kernel.
+ */
+class DtlbMisses final
+{
+	private:
+		int         fd;    //!< The perf event, or -1.
+		std::string error; //!< Why there is none.
+
+	public:
+		DtlbMisses(void) : fd(-1)
+		{
+#ifdef RWXML_WITH_PERF_EVENTS
+			struct perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size           = sizeof(attr);
+			attr.type           = PERF_TYPE_HW_CACHE;
+			attr.config         = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			attr.disabled       = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv     = 1;
+			this->fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+			if (this->fd < 0)
+			{
+				// ENOENT : no such event on this processor ; EACCES : perf_event_paranoid forbids it.
+				this->error = std::strerror(errno);
+			}
+#else
+			this->error = "no perf_event_open";
+#endif
+		}
+
+		DtlbMisses(const DtlbMisses &other)            = delete;
+		DtlbMisses& operator=(const DtlbMisses &other) = delete;
+
+		~DtlbMisses(void)
+		{
+#ifdef RWXML_WITH_PERF_EVENTS
+			if (this->fd >= 0)
+				close(this->fd);
+#endif
+		}
+
+		/**
+		 * @brief Count the misses of \a work, and print them as \a name.
+		 */
+		void count(const std::string &name, std::function<void(void)> work)
+		{
+#ifdef RWXML_WITH_PERF_EVENTS
+			if (this->fd >= 0)
+			{
+				ioctl(this->fd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(this->fd, PERF_EVENT_IOC_ENABLE, 0);
+				work();
+				ioctl(this->fd, PERF_EVENT_IOC_DISABLE, 0);
+				uint64_t misses = 0;
+				if (read(this->fd, &misses, sizeof(misses)) == sizeof(misses))
+				{
+					std::printf("%-48s %10llu\n", name.c_str(), static_cast<unsigned long long>(misses));
+					return;
+				}
+			}
+#endif
+			std::printf("%-48s %13s (%s)\n", name.c_str(), "unavailable", this->error.empty() ? "read failed" : this->error.c_str());
+		}
+};
+
+/**
+ * @brief Read the price and the tags of every record.
+ */
+static double walk(XmlLoader &loader)
+{
+	double sum = 0.0;
+	for (XmlCursor record : loader.backToRoot().children("record"))
+	{
+		sum += record.element("price").text<double>();
+		sum += record.element("tags").children("tag").empty() ? 0 : 1;
+	}
+	return sum;
+}
+
+int main(void)
+{
+	std::cout << "transparent huge pages : " << readFile("/sys/kernel/mm/transparent_hugepage/enabled");
+	writeFile("bench-hugepages.xml", catalog(800000));
+	const std::pair<xml2::HugePages, std::string> modes[] = {
+		{xml2::NO_HUGE_PAGES,          "heap"},
+		{xml2::TRANSPARENT_HUGE_PAGES, "transparent huge pages"},
+		{xml2::RESERVED_HUGE_PAGES,    "reserved huge pages"}
+	};
+	DtlbMisses misses;
+	for (const auto &mode : modes)
+	{
+		XmlOptions options;
+		options.hugePages = mode.first;
+		XmlLoader loader("bench-hugepages.xml", options);
+		measure("parse, " + mode.second, [&]() { loader.reload("bench-hugepages.xml"); }, 3);
+		measure("walk, " + mode.second, [&]() { keep(walk(loader)); });
+		misses.count("dTLB misses, parse, " + mode.second, [&]() { loader.reload("bench-hugepages.xml"); });
+		misses.count("dTLB misses, walk, " + mode.second, [&]() { keep(walk(loader)); });
+	}
+	return 0;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file bench_index.cpp
+ * @brief Measures reading a few records of a big catalog by their key : through
+ * its sidecar index, against loading the whole file to find them.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+int main(void)
+{
+	const size_t records = 300000;
+	const int    lookups = 100;
+	writeFile("bench-index.xml", catalog(records));
+	measure("build the index", [&]() {
+		keep(XmlIndex::build("bench-index.xml", "catalog/record", "id"));
+	}, 1);
+
+	measure("100 records, whole file loaded", [&]() {
+		XmlLoader loader("bench-index.xml");
+		double sum = 0.0;
+		for (int i = 0; i < lookups; ++i)
+		{
+			const std::string key = "sku-" + std::to_string((i * 7919) % records);
+			loader.backToRoot().forEachNodeNamed("record", [&]() {
+				if (loader.attribute<std::string>("id") == key)
+					sum += loader.element("price").text<double>();
+			});
+		}
+		keep(sum);
+	}, 1);
+	measure("100 records, through the index", [&]() {
+		XmlIndex index("bench-index.xml");
+		double sum = 0.0;
+		for (int i = 0; i < lookups; ++i)
+		{
+			XmlLoader loader(index, index.find("sku-" + std::to_string((i * 7919) % records)));
+			sum += loader.element("price").text<double>();
+		}
+		keep(sum);
+	});
+	return 0;
+}
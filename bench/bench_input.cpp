@@ -0,0 +1,126 @@
+/**
+ * @file bench_input.cpp
+ * @brief Measures loading a gzip file decompressed on the fly into the parse
+ * buffer, against decompressing it into a file first, then loading this file,
+ * and loading a zstd file the same way.
+ * It also measures the UTF-16 transcoder of XmlUnicode, against iconv where
+ * the C library has it, on ASCII text and on text with accents.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <cstdio>
+#include <vector>
+#include "XmlLoader.hpp"
+#include "XmlUnicode.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+#if defined(__GLIBC__)
+#	include <iconv.h>
+
+/**
+ * @brief Transcode \a text with iconv, from \a from to \a to.
+ * @return The characters written into \a out.
+ */
+static size_t convert(const char *from, const char *to, const std::string &text, std::vector<char> &out)
+{
+	iconv_t cd = iconv_open(to, from);
+	char *src = const_cast<char*>(text.data());
+	size_t srcLeft = text.size();
+	char *dst = out.data();
+	size_t dstLeft = out.size();
+	iconv(cd, &src, &srcLeft, &dst, &dstLeft);
+	iconv_close(cd);
+	return out.size() - dstLeft;
+}
+#endif
+
+/**
+ * @brief Measure transcoding \a text, in UTF-8, once brought to UTF-16 little endian.
+ */
+static void transcode(const std::string &what, const std::string &text)
+{
+	std::vector<char> out(text.size() * 3 + 16);
+	std::string wide;
+#if defined(__GLIBC__)
+	wide.assign(out.data(), convert("UTF-8", "UTF-16LE", text, out));
+#else
+	for (char c : text)
+	{
+		wide += c;
+		wide += '\0';
+	}
+#endif
+	measure("UTF-16 " + what + ", XmlUnicode", [&]() {
+		const char *src = wide.data();
+		char *dst = out.data();
+		keep(XmlUnicode::utf16ToUtf8(src, src + wide.size(), dst, dst + out.size(), false));
+		keep(dst - out.data());
+	});
+#if defined(__GLIBC__)
+	measure("UTF-16 " + what + ", iconv", [&]() {
+		keep(convert("UTF-16LE", "UTF-8", wide, out));
+	});
+#endif
+	writeFile("bench-input-16.xml", std::string("\xFF\xFE", 2) + wide);
+	measure("UTF-16 " + what + " file, transcoded while loaded", [&]() {
+		XmlLoader loader("bench-input-16.xml");
+		keep(loader.name().size());
+	});
+#if defined(__GLIBC__)
+	XmlLoader loader("bench-input.xml");
+	measure("UTF-16 " + what + " file, iconv then loaded", [&]() {
+		const std::string file = readFile("bench-input-16.xml");
+		const size_t size = convert("UTF-16", "UTF-8", file, out);
+		keep(loader.reload(out.data(), size).name().size());
+	});
+#endif
+}
+
+int main(void)
+{
+	const std::string xml = catalog(150000);
+	writeFile("bench-input.xml", xml);
+	measure("plain file", [&]() {
+		XmlLoader loader("bench-input.xml");
+		keep(loader.name().size());
+	});
+#ifdef RWXML_WITH_ZLIB
+	writeGzip("bench-input.xml.gz", xml);
+	measure("gzip file, decompressed while loaded", [&]() {
+		XmlLoader loader("bench-input.xml.gz");
+		keep(loader.name().size());
+	});
+	measure("gzip file, decompressed into a file first", [&]() {
+		gzFile in = gzopen("bench-input.xml.gz", "rb");
+		FILE *out = fopen("bench-input-unpacked.xml", "wb");
+		char chunk[256*1024];
+		int got = 0;
+		while ((got = gzread(in, chunk, sizeof(chunk))) > 0)
+			fwrite(chunk, 1, static_cast<size_t>(got), out);
+		fclose(out);
+		gzclose(in);
+		XmlLoader loader("bench-input-unpacked.xml");
+		keep(loader.name().size());
+	});
+#else
+	std::printf("gzip cases skipped : built without zlib\n");
+#endif
+#ifdef RWXML_WITH_ZSTD
+	writeZstd("bench-input.xml.zst", xml);
+	measure("zstd file, decompressed while loaded", [&]() {
+		XmlLoader loader("bench-input.xml.zst");
+		keep(loader.name().size());
+	});
+#else
+	std::printf("zstd cases skipped : built without zstd\n");
+#endif
+
+	transcode("ASCII", xml);
+	std::string accents = xml;
+	for (size_t at = accents.find("item"); at != std::string::npos; at = accents.find("item", at))
+		accents.replace(at, 4, "\xC3\xADt\xE2\x82\xAC\xC3\xA9");
+	transcode("with accents", accents);
+	return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file bench_namespaces.cpp
+ * @brief Measures looking a child up by namespace and local name, with the
+ * atoms of XmlLoader::qname(), against splitting the prefix of each child and
+ * walking up to the \b xmlns attribute binding it, as done by hand.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <cstring>
+#include <vector>
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+static const size_t records = 300000; //!< Of 5 elements each, the namespace being declared 4 levels up.
+static const size_t lookups = 20;     //!< Per record, for the lookups to outweigh the walk.
+
+/**
+ * @brief The first child of \a parent in the namespace \a ns named \a local,
+ * its prefix being looked up in the \b xmlns attributes of its ancestors.
+ */
+static const xml2::XMLElement* byHand(const xml2::XMLElement *parent, const char *ns, const char *local)
+{
+	for (const xml2::XMLElement *child = parent->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+	{
+		const char *name  = child->Name();
+		const char *colon = std::strchr(name, ':');
+		if (std::strcmp(colon != nullptr ? colon + 1 : name, local) != 0)
+			continue;
+		const std::string binding = (colon != nullptr) ? "xmlns:" + std::string(name, colon) : std::string("xmlns");
+		for (const xml2::XMLNode *up = child; up != nullptr && up->ToElement() != nullptr; up = up->Parent())
+		{
+			const char *uri = up->ToElement()->Attribute(binding.c_str());
+			if (uri != nullptr)
+			{
+				if (std::strcmp(uri, ns) == 0)
+					return child;
+				break;
+			}
+		}
+	}
+	return nullptr;
+}
+
+int main(void)
+{
+	std::string xml("<s:Envelope xmlns:s=\"urn:soap\" xmlns:c=\"urn:catalog\"><s:Body><c:list><c:group>\n");
+	for (size_t i = 0; i < records; ++i)
+	{
+		const std::string n = std::to_string(i);
+		xml += "<c:record><c:id>" + n + "</c:id><c:name>item " + n + "</c:name><c:kind>" + std::to_string(i % 7) +
+		       "</c:kind><c:price>" + n + ".5</c:price></c:record>\n";
+	}
+	XmlLoader loader(writeFile("bench-namespaces.xml", xml + "</c:group></c:list></s:Body></s:Envelope>\n"));
+
+	measure("reload", [&]() { loader.reload("bench-namespaces.xml"); }, 3);
+	measure("reload, freeze and resolve", [&]() {
+		keep(loader.reload("bench-namespaces.xml").qname("urn:catalog", "price").local);
+	}, 3);
+	const XmlQName price = loader.qname("urn:catalog", "price");
+	const auto walk = [&](std::function<void(void)> lookup) {
+		loader.backToRoot().node("s:Body").node("c:list").node("c:group").forEachNodeNamed("c:record", lookup);
+	};
+	const double alone = measure("300k records, no lookup", [&]() { walk([]() {}); });
+	const double atoms = measure("300k records, 20 x element(qname)", [&]() {
+		size_t found = 0;
+		walk([&]() {
+			for (size_t i = 0; i < lookups; ++i)
+				found += loader.element(price).name().size();
+		});
+		keep(found);
+	});
+	const double named = measure("300k records, 20 x element(\"c:price\")", [&]() {
+		size_t found = 0;
+		walk([&]() {
+			for (size_t i = 0; i < lookups; ++i)
+				found += loader.element("c:price").name().size();
+		});
+		keep(found);
+	});
+
+	std::vector<const xml2::XMLElement*> all;
+	for (XmlCursor record : loader.backToRoot().node("s:Body").node("c:list").node("c:group").children("c:record"))
+		all.push_back(record.get());
+	const double hand = measure("300k records, 20 x by hand", [&]() {
+		size_t found = 0;
+		for (const xml2::XMLElement *record : all)
+		{
+			for (size_t i = 0; i < lookups; ++i)
+				found += std::strlen(byHand(record, "urn:catalog", "price")->Name());
+		}
+		keep(found);
+	});
+
+	// The names are read the same way in every case : only the lookup differs.
+	const double ns = 1e6 / (records * lookups);
+	std::printf("%-48s %10.1f ns\n", "per lookup, element(qname)", (atoms - alone) * ns);
+	std::printf("%-48s %10.1f ns\n", "per lookup, element(\"c:price\")", (named - alone) * ns);
+	std::printf("%-48s %10.1f ns\n", "per lookup, by hand", hand * ns);
+	return 0;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file bench_parallel.cpp
+ * @brief Measures reading every record of a catalog with parallelForEachNodeNamed(),
+ * from 1 thread to one per core.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+int main(void)
+{
+	XmlLoader loader(writeFile("bench-parallel.xml", catalog(300000)));
+	const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned threads = 1; threads <= std::max(4u, cores); threads *= 2)
+	{
+		measure("300k records, " + std::to_string(threads) + " thread(s)", [&]() {
+			std::atomic<long> sum(0);
+			loader.parallelForEachNodeNamed("record", [&](XmlCursor record) {
+				// Some work per record, as a real reader does.
+				long local = static_cast<long>(record.element("price").text<double>());
+				local += record.attribute<int>("kind");
+				for (XmlCursor tag : record.element("tags").children("tag"))
+					local += static_cast<long>(tag.rawText().size);
+				sum += local;
+			}, threads);
+			keep(sum.load());
+		});
+	}
+	std::printf("%u core(s)\n", cores);
+	return 0;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file bench_pipeline.cpp
+ * @brief Measures parsing a big file while another thread reads it, against
+ * reading it whole into a buffer first, then parsing the buffer.
+ * The file is in the page cache after its first read : the reads are copies
+ * here, a cold cache is where the pipeline saves the most.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlInput.hpp"
+#include "XmlUnicode.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+int main(void)
+{
+	for (size_t records : {40000, 600000})
+	{
+		writeFile("bench-pipeline.xml", catalog(records));
+		const std::string size = std::to_string(readFile("bench-pipeline.xml").size() / (1024 * 1024)) + " MB";
+		for (bool validate : {false, true})
+		{
+			const std::string what = size + (validate ? ", UTF-8 checked" : "");
+			measure(what + ", read then parsed", [&]() {
+				const std::string xml = readFile("bench-pipeline.xml");
+				if (validate)
+					keep(XmlUnicode::validUtf8(xml.data(), xml.size()));
+				xml2::XMLDocument doc;
+				keep(doc.Parse(xml.data(), xml.size()));
+			});
+			measure(what + ", parsed while read", [&]() {
+				xml2::XMLDocument doc;
+				keep(XmlInput::open("bench-pipeline.xml")->parse(doc, validate));
+			});
+		}
+	}
+	return 0;
+}
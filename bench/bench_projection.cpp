@@ -0,0 +1,57 @@
+/**
+ * @file bench_projection.cpp
+ * @brief Measures loading a big catalog whole, against keeping only the name
+ * of each record (see XmlOptions::keepPaths) : the load, the reload, and the
+ * heap the document holds, its character buffer included.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <cstdio>
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+#	include <malloc.h>
+#	define RWXML_WITH_MALLINFO
+#endif
+
+/**
+ * @brief The bytes allocated from the heap, or 0 if it cannot be told.
+ */
+static size_t heap(void)
+{
+#ifdef RWXML_WITH_MALLINFO
+	const struct mallinfo2 info = mallinfo2();
+	return info.uordblks + info.hblkhd;
+#else
+	return 0;
+#endif
+}
+
+int main(void)
+{
+	writeFile("bench-projection.xml", catalog(600000));
+	XmlOptions names;
+	names.keepPaths = {"catalog/record/name"};
+	for (const XmlOptions &options : {XmlOptions(), names})
+	{
+		const std::string what = options.keepPaths.empty() ? "whole" : "names only";
+		measure("load, " + what, [&]() {
+			XmlLoader loader("bench-projection.xml", options);
+			keep(loader.name().size());
+		}, 3);
+		const size_t before = heap();
+		XmlLoader loader("bench-projection.xml", options);
+		const size_t held = heap() - before;
+		measure("reload, " + what, [&]() {
+			keep(loader.reload("bench-projection.xml").name().size());
+		}, 3);
+		if (held > 0)
+			std::printf("%-48s %10zu MB\n", ("heap, " + what).c_str(), held / (1024 * 1024));
+		else
+			std::printf("%-48s %13s\n", ("heap, " + what).c_str(), "unavailable");
+	}
+	return 0;
+}
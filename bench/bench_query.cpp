@@ -0,0 +1,71 @@
+/**
+ * @file bench_query.cpp
+ * @brief Measures compiled queries run by XmlLoader::select(), against the
+ * same selections written with forEachNodeNamed().
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+int main(void)
+{
+	XmlLoader loader(writeFile("bench-query.xml", catalog(600000)));
+
+	const XmlQuery kind("record[@kind='3']/name");
+	measure("record[@kind='3']/name, select", [&]() { keep(loader.select(kind).size()); });
+	measure("record[@kind='3']/name, forEachNodeNamed", [&]() {
+		size_t count = 0;
+		loader.backToRoot().forEachNodeNamed("record", [&]() {
+			if (loader.attribute<std::string>("kind") == "3")
+				count += loader.element("name").name().size();
+		});
+		keep(count);
+	});
+
+	const XmlQuery position("record[5000]/tags/tag[2]");
+	measure("record[5000]/tags/tag[2], select", [&]() { keep(loader.select(position).size()); });
+	measure("record[5000]/tags/tag[2], forEachNodeNamed", [&]() {
+		size_t index = 0;
+		std::string tag;
+		loader.backToRoot().forEachNodeNamed("record", [&]() {
+			if (++index == 5000)
+			{
+				loader.node("tags").cursorMode(true);
+				loader.element("tag");
+				tag = loader.element("tag").text<std::string>();
+				loader.cursorMode(false).prev();
+			}
+		});
+		keep(tag.size());
+	});
+
+	const XmlQuery text("record/tags/tag[.='b9']");
+	measure("record/tags/tag[.='b9'], select", [&]() { keep(loader.select(text).size()); });
+	measure("record/tags/tag[.='b9'], forEachNodeNamed", [&]() {
+		size_t count = 0;
+		loader.backToRoot().forEachNodeNamed("record", [&]() {
+			loader.node("tags").forEachElementNamed("tag", [&]() {
+				count += loader.text<std::string>() == "b9" ? 1 : 0;
+			});
+			loader.prev();
+		});
+		keep(count);
+	});
+
+	const XmlQuery descendant("//tag[.='b9']");
+	measure("//tag[.='b9'], select", [&]() { keep(loader.select(descendant).size()); });
+
+	const XmlQuery child("record[price='55.5']");
+	measure("record[price='55.5'], select", [&]() { keep(loader.select(child).size()); });
+	measure("record[price='55.5'], forEachNodeNamed", [&]() {
+		size_t count = 0;
+		loader.backToRoot().forEachNodeNamed("record", [&]() {
+			count += loader.element("price").text<std::string>() == "55.5" ? 1 : 0;
+		});
+		keep(count);
+	});
+	return 0;
+}
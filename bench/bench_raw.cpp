@@ -0,0 +1,72 @@
+/**
+ * @file bench_raw.cpp
+ * @brief Measures forwarding one attribute and one text of each record, with
+ * entities and CRLF in them, through the raw views of XmlLoader against
+ * text<std::string>() and attribute<std::string>(), the first time and once
+ * they are decoded. The reloads are not timed.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <memory>
+#include <vector>
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+static const size_t records = 300000; //!< Of an attribute and a text each.
+static const int    runs    = 5;      //!< Of each case, on as many documents.
+
+int main(void)
+{
+	std::string xml("<catalog>\r\n");
+	for (size_t i = 0; i < records; ++i)
+	{
+		const std::string n = std::to_string(i);
+		xml += "<record id=\"sku-" + n + " &amp; co\"><name>item &lt;" + n + "&gt;\r\nline &#233;</name></record>\r\n";
+	}
+	writeFile("bench-raw.xml", xml + "</catalog>\r\n");
+	// text() decodes in place the first time : each run gets a document not read yet, reloaded before it.
+	std::vector<std::unique_ptr<XmlLoader>> loaders;
+	for (int run = 0; run < runs; ++run)
+		loaders.emplace_back(new XmlLoader("bench-raw.xml"));
+	const auto fresh = [&]() {
+		for (std::unique_ptr<XmlLoader> &loader : loaders)
+			loader->reload("bench-raw.xml");
+	};
+	std::string out;
+	out.reserve(xml.size());
+	size_t next = 0;
+
+	fresh();
+	measure("forward, raw views", [&]() {
+		XmlLoader &loader = *loaders[next++ % runs];
+		out.clear();
+		loader.forEachNodeNamed("record", [&]() {
+			const XmlView id   = loader.rawAttribute("id");
+			const XmlView name = loader.element("name").rawText();
+			out.append(id.data, id.size).append(name.data, name.size);
+		});
+		keep(out.size());
+	}, runs);
+	fresh();
+	measure("forward, std::string", [&]() {
+		XmlLoader &loader = *loaders[next++ % runs];
+		out.clear();
+		loader.forEachNodeNamed("record", [&]() {
+			out += loader.attribute<std::string>("id");
+			out += loader.element("name").text<std::string>();
+		});
+		keep(out.size());
+	}, runs);
+	measure("forward, std::string, decoded before", [&]() {
+		XmlLoader &loader = *loaders[next++ % runs];
+		out.clear();
+		loader.forEachNodeNamed("record", [&]() {
+			out += loader.attribute<std::string>("id");
+			out += loader.element("name").text<std::string>();
+		});
+		keep(out.size());
+	}, runs);
+	return 0;
+}
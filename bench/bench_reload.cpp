@@ -0,0 +1,37 @@
+/**
+ * @file bench_reload.cpp
+ * @brief Measures loading many files of the same shape with a new XmlLoader
+ * each, then with a single one reloaded.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <memory>
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+int main(void)
+{
+	const int files = 200;
+	writeFile("bench-reload.xml", catalog(2000));
+	const std::string buffer = readFile("bench-reload.xml");
+
+	measure("200 files, a new loader each", [&]() {
+		for (int i = 0; i < files; ++i)
+		{
+			std::unique_ptr<XmlLoader> loader(new XmlLoader("bench-reload.xml"));
+			keep(loader->name().size());
+		}
+	});
+	XmlLoader loader("bench-reload.xml");
+	measure("200 files, one loader reloaded", [&]() {
+		for (int i = 0; i < files; ++i)
+			keep(loader.reload("bench-reload.xml").name().size());
+	});
+	measure("200 buffers, one loader reloaded", [&]() {
+		for (int i = 0; i < files; ++i)
+			keep(loader.reload(buffer.data(), buffer.size()).name().size());
+	});
+	return 0;
+}
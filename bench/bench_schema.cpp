@@ -0,0 +1,71 @@
+/**
+ * @file bench_schema.cpp
+ * @brief Measures the load of a big catalog with and without XmlOptions::schema,
+ * and XmlSchema::validate() alone on a parsed document : the first time, when
+ * each text is normalized as it is read, then again.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <cstdio>
+#include <memory>
+#include "XmlLoader.hpp"
+#include "XmlSchema.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+static const char *xsd =
+	"<xs:schema xmlns:xs=\"http://www.w3.org/2001/XMLSchema\">"
+	"<xs:simpleType name=\"sku\"><xs:restriction base=\"xs:string\"><xs:pattern value=\"sku-[0-9]+\"/></xs:restriction></xs:simpleType>"
+	"<xs:simpleType name=\"price\"><xs:restriction base=\"xs:decimal\"><xs:minInclusive value=\"0\"/></xs:restriction></xs:simpleType>"
+	"<xs:element name=\"catalog\"><xs:complexType><xs:sequence>"
+	"<xs:element name=\"record\" minOccurs=\"0\" maxOccurs=\"unbounded\"><xs:complexType><xs:sequence>"
+	"<xs:element name=\"name\" type=\"xs:string\"/>"
+	"<xs:element name=\"price\" type=\"price\"/>"
+	"<xs:element name=\"tags\"><xs:complexType><xs:sequence>"
+	"<xs:element name=\"tag\" type=\"xs:string\" maxOccurs=\"unbounded\"/>"
+	"</xs:sequence></xs:complexType></xs:element>"
+	"</xs:sequence>"
+	"<xs:attribute name=\"id\" type=\"sku\" use=\"required\"/>"
+	"<xs:attribute name=\"kind\" type=\"xs:unsignedByte\"/>"
+	"</xs:complexType></xs:element>"
+	"</xs:sequence></xs:complexType></xs:element>"
+	"</xs:schema>"; //!< The schema of the catalog of fixtures.hpp.
+
+int main(void)
+{
+	const std::string xml = catalog(750000);
+	writeFile("bench-schema.xml", xml);
+	std::printf("%-48s %10zu MB\n", "document", xml.size() / (1024 * 1024));
+
+	XmlOptions checked;
+	checked.schema = std::make_shared<XmlSchema>(writeFile("bench-schema.xsd", xsd));
+	XmlLoader plain("bench-schema.xml");
+	const double parse = measure("reload", [&]() {
+		keep(plain.reload("bench-schema.xml").name().size());
+	}, 3);
+	XmlLoader loader("bench-schema.xml", checked);
+	const double valid = measure("reload, schema", [&]() {
+		keep(loader.reload("bench-schema.xml").name().size());
+	}, 3);
+
+	// The first pass reads each text for the first time, and normalizes it : the next ones do not.
+	xml2::XMLDocument doc;
+	std::string error;
+	double first = 0;
+	for (int run = 0; run < 3; ++run)
+	{
+		doc.Parse(xml.c_str(), xml.size());
+		const double took = measure("validate alone, first pass", [&]() {
+			keep(checked.schema->validate(doc.RootElement(), error));
+		}, 1);
+		first = (run == 0 || took < first) ? took : first;
+	}
+	const double again = measure("validate alone, again", [&]() {
+		keep(checked.schema->validate(doc.RootElement(), error));
+	}, 3);
+	std::printf("%-48s %+10.1f %%\n", "reload overhead, schema", 100.0 * (valid - parse) / parse);
+	std::printf("%-48s %10.1f %%\n", "first validate / reload", 100.0 * first / parse);
+	std::printf("%-48s %10.1f %%\n", "validate again / reload", 100.0 * again / parse);
+	return 0;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file bench_stream.cpp
+ * @brief Measures reading every record of a file streamed through the window,
+ * against loading it at once, with records larger and smaller than the window.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+/**
+ * @brief Count the items of every record.
+ */
+static size_t items(XmlLoader &loader)
+{
+	size_t count = 0;
+	loader.forEachNodeNamed("record", [&](XmlCursor record) {
+		for (XmlCursor item : record.children("item"))
+			count += item.attribute<unsigned int>("n") > 0 ? 1 : 0;
+	});
+	return count;
+}
+
+int main(void)
+{
+	XmlOptions streaming;
+	streaming.streaming = true;
+	for (size_t bytes : {4 * 1024 * 1024, 200})
+	{
+		writeFile("bench-stream.xml", bigRecords(64 * 1024 * 1024 / bytes, bytes));
+		const std::string size = "64 MB of " + std::to_string(bytes) + " bytes records";
+		measure(size + ", loaded at once", []() {
+			XmlLoader loader("bench-stream.xml");
+			keep(items(loader));
+		}, 3);
+		measure(size + ", streamed", [&]() {
+			XmlLoader loader("bench-stream.xml", streaming);
+			keep(items(loader));
+		}, 3);
+	}
+	return 0;
+}
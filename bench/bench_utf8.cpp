@@ -0,0 +1,52 @@
+/**
+ * @file bench_utf8.cpp
+ * @brief Measures the cost of XmlOptions::validateUtf8 on the load of a catalog,
+ * ASCII only then with accented names, and XmlUnicode::validUtf8() alone on
+ * the same bytes. Build with RWXML_WITH_SSSE3=OFF to measure it without SSSE3.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "XmlUnicode.hpp"
+#include "bench.hpp"
+#include "fixtures.hpp"
+
+int main(void)
+{
+	const std::string ascii = catalog(400000);
+	std::string accented;
+	accented.reserve(ascii.size() * 2);
+	for (size_t at = 0, item; at < ascii.size(); at = item + 4)
+	{
+		item = ascii.find("item", at);
+		if (item == std::string::npos)
+			item = ascii.size();
+		accented.append(ascii, at, item - at);
+		if (item < ascii.size())
+			accented += "\xC3\xA9l\xC3\xA9ment \xE2\x82\xAC \xF0\x9F\x93\xA6";
+	}
+
+	XmlOptions validated;
+	validated.validateUtf8 = true;
+	for (const std::string *xml : {&ascii, static_cast<const std::string*>(&accented)})
+	{
+		const std::string what = (xml == &ascii) ? "ASCII" : "accented";
+		writeFile("bench-utf8.xml", *xml);
+		XmlLoader loader("bench-utf8.xml");
+		const double plain = measure("load, " + what, [&]() {
+			keep(loader.reload("bench-utf8.xml").name().size());
+		});
+		XmlLoader checked("bench-utf8.xml", validated);
+		const double valid = measure("load, " + what + ", validateUtf8", [&]() {
+			keep(checked.reload("bench-utf8.xml").name().size());
+		});
+		const double alone = measure("validUtf8 alone, " + what, [&]() {
+			keep(XmlUnicode::validUtf8(xml->data(), xml->size()));
+		});
+		// The difference of the loads is as noisy as they are : the check alone tells its share.
+		std::printf("%-48s %+10.1f %%\n", ("load overhead, " + what).c_str(), 100.0 * (valid - plain) / plain);
+		std::printf("%-48s %10.1f %%\n", ("validUtf8 alone / load, " + what).c_str(), 100.0 * alone / plain);
+	}
+	return 0;
+}
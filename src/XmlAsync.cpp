@@ -0,0 +1,64 @@
+#include "XmlAsync.hpp"
+
+#ifdef RWXML_WITH_COROUTINES
+
+#include <thread>
+
+#include "XmlLoader.hpp"
+
+
+XmlLoading::XmlLoading(const std::string &fname, Executor executor, const XmlOptions &options) :
+	fname(fname), options(options), executor(std::move(executor))
+{
+
+}
+
+XmlLoading::XmlLoading(XmlLoading &&other) :
+	fname(std::move(other.fname)), options(std::move(other.options)), executor(std::move(other.executor)),
+	loader(std::move(other.loader)), error(std::move(other.error))
+{
+
+}
+
+XmlLoading::~XmlLoading(void)
+{
+
+}
+
+bool XmlLoading::await_ready(void) const noexcept
+{
+	return false;
+}
+
+void XmlLoading::await_suspend(std::coroutine_handle<> handle)
+{
+	std::thread([this, handle]() {
+		try
+		{
+			this->loader.reset(new XmlLoader(this->fname, this->options));
+		}
+		catch(...)
+		{
+			this->error = std::current_exception();
+		}
+		// Once resumed, the coroutine may destroy this at any time : nothing of it is used after.
+		const Executor executor = this->executor;
+		executor([handle]() { handle.resume(); });
+	}).detach();
+}
+
+std::unique_ptr<XmlLoader> XmlLoading::await_resume(void)
+{
+	if (this->error)
+	{
+		std::rethrow_exception(this->error);
+	}
+	return std::move(this->loader);
+}
+
+XmlLoading XmlLoader::openAsync(const std::string &fname, XmlLoading::Executor executor, const XmlOptions &options)
+{
+	return XmlLoading(fname, std::move(executor), options);
+}
+
+#endif
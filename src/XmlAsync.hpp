@@ -0,0 +1,90 @@
+/**
+ * @file XmlAsync.hpp
+ * @brief Defines the awaitable loading of a XmlLoader, for C++20 coroutines.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ *
+ * It only exists with \b RWXML_WITH_COROUTINES defined, as the C++20 library
+ * \b rwxml_async does for the targets linked to it.
+ */
+#ifndef XMLASYNC_HPP_INCLUDED
+#define XMLASYNC_HPP_INCLUDED
+
+#ifdef RWXML_WITH_COROUTINES
+
+#ifndef __cpp_impl_coroutine
+#	error "RWXML_WITH_COROUTINES needs a compiler with C++20 coroutines (-std=c++20)"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include "XmlOptions.hpp"
+
+class XmlLoader;
+
+
+/**
+ * @brief The loading of a file by XmlLoader::openAsync(), to \b co_await.
+ *
+ * The coroutine awaiting it is suspended, the file is read and parsed on a
+ * thread of its own, and the coroutine is then handed over to the executor
+ * to be resumed there, with the loader ready (or the exception it threw).
+ * The thread awaiting it is never blocked, whatever the size of the file.
+ * @author MTLCRBN
+ */
+class XmlLoading final
+{
+	public:
+		//! @brief Run a function on the executor the coroutine has to be resumed on.
+		typedef std::function<void(std::function<void(void)>)> Executor;
+
+	private:
+		std::string                fname;    //!< The file to load.
+		XmlOptions                 options;  //!< The options to load it with.
+		Executor                   executor; //!< Where to resume the coroutine.
+		std::unique_ptr<XmlLoader> loader;   //!< The loader, once loaded.
+		std::exception_ptr         error;    //!< What the loading threw, if it did.
+
+		XmlLoading(const XmlLoading &other)            = delete;
+		XmlLoading& operator=(const XmlLoading &other) = delete;
+
+	public:
+		/**
+		 * @brief Prepare the loading, which only starts once awaited.
+		 * @param[in] fname    The file to load.
+		 * @param[in] executor Where to resume the coroutine.
+		 * @param[in] options  The options to load with.
+		 */
+		XmlLoading(const std::string &fname, Executor executor, const XmlOptions &options);
+
+		//! @brief Moved out of XmlLoader::openAsync().
+		XmlLoading(XmlLoading &&other);
+
+		//! @brief Destroy the loader if it was never taken.
+		~XmlLoading(void);
+
+		/**
+		 * @brief Never ready before being awaited : the loading has not started.
+		 */
+		bool await_ready(void) const noexcept;
+
+		/**
+		 * @brief Start the loading on its own thread, which resumes \a handle through the executor.
+		 */
+		void await_suspend(std::coroutine_handle<> handle);
+
+		/**
+		 * @brief Get the loader, once resumed.
+		 * @throw std::string what XmlLoader(fname, options) threw.
+		 * @return The loader, ready to use.
+		 */
+		std::unique_ptr<XmlLoader> await_resume(void);
+};
+
+#endif
+
+#endif
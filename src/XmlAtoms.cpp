@@ -0,0 +1,44 @@
+#include "XmlAtoms.hpp"
+
+
+const uint32_t XmlAtoms::none;
+
+XmlAtoms::XmlAtoms(void)
+{
+
+}
+
+uint32_t XmlAtoms::intern(const std::string &name)
+{
+	auto found = this->ids.find(name);
+	if (found != this->ids.end())
+	{
+		return found->second;
+	}
+	const uint32_t atom = static_cast<uint32_t>(this->names.size());
+	auto inserted = this->ids.emplace(name, atom).first;
+	this->names.push_back(&inserted->first);
+	return atom;
+}
+
+uint32_t XmlAtoms::find(const std::string &name) const
+{
+	auto found = this->ids.find(name);
+	return (found == this->ids.end()) ? XmlAtoms::none : found->second;
+}
+
+const std::string& XmlAtoms::name(uint32_t atom) const
+{
+	return *this->names[atom];
+}
+
+uint32_t XmlAtoms::size(void) const
+{
+	return static_cast<uint32_t>(this->names.size());
+}
+
+void XmlAtoms::clear(void)
+{
+	this->ids.clear();
+	this->names.clear();
+}
@@ -0,0 +1,69 @@
+/**
+ * @file XmlAtoms.hpp
+ * @brief Defines a table of interned names.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef XMLATOMS_HPP_INCLUDED
+#define XMLATOMS_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+
+/**
+ * @brief Give each distinct name a small integer (an atom), so that names
+ * can be compared, stored and hashed as integers.
+ * @author MTLCRBN
+ */
+class XmlAtoms final
+{
+	private:
+		std::unordered_map<std::string, uint32_t> ids;   //!< The atom of each name.
+		std::vector<const std::string*>           names; //!< The name of each atom (keys of ids).
+
+		XmlAtoms(const XmlAtoms &other)            = delete;
+		XmlAtoms& operator=(const XmlAtoms &other) = delete;
+
+	public:
+		static const uint32_t none = 0xFFFFFFFF; //!< The atom of nothing.
+
+		//! @brief Create an empty table.
+		XmlAtoms(void);
+
+		/**
+		 * @brief Get the atom of \a name, creating it if needed.
+		 * @param[in] name The name to intern.
+		 * @return Its atom.
+		 */
+		uint32_t intern(const std::string &name);
+
+		/**
+		 * @brief Get the atom of \a name, without creating it.
+		 * @param[in] name The name to look for.
+		 * @return Its atom, or \b none if it was never interned.
+		 */
+		uint32_t find(const std::string &name) const;
+
+		/**
+		 * @brief Get the name of \a atom.
+		 * @param[in] atom An atom given by this table.
+		 * @return Its name.
+		 */
+		const std::string& name(uint32_t atom) const;
+
+		/**
+		 * @brief The number of atoms.
+		 */
+		uint32_t size(void) const;
+
+		/**
+		 * @brief Forget every atom.
+		 */
+		void clear(void);
+};
+
+#endif
@@ -0,0 +1,380 @@
+/**
+ * @file XmlAttributeMap.hpp
+ * @brief Defines the reading of many attributes of an element at once, into a struct.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef XMLATTRIBUTEMAP_HPP_INCLUDED
+#define XMLATTRIBUTEMAP_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <type_traits>
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <cerrno>
+#include <climits>
+#include "tinyxml2.h"
+
+namespace xml2 = tinyxml2;
+
+
+/**
+ * @brief An attribute, and the member of a \b S of type \b T it is read into
+ * (see XmlAttributeMap and xmlField()).
+ * @author MTLCRBN
+ */
+template<typename S, typename T>
+class XmlField final
+{
+	public:
+		std::string name;   //!< The name of the attribute.
+		T S::*      member; //!< The member it is read into.
+
+		/**
+		 * @brief Read the attribute \a name into \a member.
+		 * @param[in] name   The name of the attribute.
+		 * @param[in] member The member of \b S to read it into.
+		 */
+		XmlField(const char *name, T S::*member) : name(name), member(member)
+		{
+
+		}
+};
+
+/**
+ * @brief The attributes to read into the members of a \b S, with the
+ * conversion of each one, to read them all in a single walk over the
+ * attributes of an element (see XmlLoader::attributes()).
+ *
+ * Reading \b k attributes one by one with XmlLoader::attribute() walks
+ * the attributes of the element \b k times, comparing every name, and
+ * converts each value with sscanf(). A map finds the member of each
+ * attribute with one hash and one comparison, through a perfect hash
+ * found once for its names, and converts the value in place with the
+ * strto* functions.
+ *
+ * The fields \b F are a list known at compile time (each one a XmlField),
+ * so the conversion of each member is chosen by its type, and inlined :
+ * @code
+ * struct Record
+ * {
+ * 	int         id    = 0;
+ * 	double      price = 0;
+ * 	std::string name;
+ * };
+ * static const auto fields = xmlAttributes(
+ * 	xmlField("id",    &Record::id),
+ * 	xmlField("price", &Record::price),
+ * 	xmlField("name",  &Record::name));
+ * loader.forEachNodeNamed("record", [&]() {
+ * 	Record record;
+ * 	loader.attributes(fields, record);
+ * });
+ * @endcode
+ * The members can be \b bool, \b int, \b unsigned \b int, \b int64_t,
+ * \b uint64_t, \b float, \b double or \b std::string, read as
+ * XmlLoader::attribute() reads them : another type does not compile.
+ * A map never changes once built : it can be shared by many threads.
+ * @author MTLCRBN
+ */
+template<typename S, typename... F>
+class XmlAttributeMap final
+{
+	private:
+		static const int16_t empty = -1; //!< The slot of no field.
+
+		std::tuple<F...>         fields; //!< The attributes to read.
+		std::vector<std::string> names;  //!< Their names, in the same order.
+		std::vector<int16_t>     slots;  //!< The field of each hash, or empty.
+		uint32_t             seed;   //!< The seed making the hash of the names perfect.
+		uint32_t             mask;   //!< The number of slots, minus 1.
+
+		/**
+		 * @brief Hash the name \a name with \a seed (FNV-1a), and measure it.
+		 * @param[in]  name   The name.
+		 * @param[out] length Its number of characters.
+		 * @param[in]  seed   The seed.
+		 * @return Its hash.
+		 */
+		static uint32_t hash(const char *name, size_t &length, uint32_t seed)
+		{
+			uint32_t hash = 2166136261u ^ seed;
+			const char *at = name;
+			for(; *at != '\0'; ++at)
+			{
+				hash = (hash ^ static_cast<unsigned char>(*at)) * 16777619u;
+			}
+			length = static_cast<size_t>(at - name);
+			return hash ^ (hash >> 16);
+		}
+
+		/**
+		 * @brief Try to place every name with \a seed in \a count slots.
+		 * @return false if two of them collide.
+		 */
+		bool place(uint32_t seed, uint32_t count)
+		{
+			this->slots.assign(count, static_cast<int16_t>(empty));
+			for(size_t i = 0; i < this->names.size(); ++i)
+			{
+				size_t length = 0;
+				int16_t &slot = this->slots[hash(this->names[i].c_str(), length, seed) & (count - 1)];
+				if (slot != empty)
+				{
+					return false;
+				}
+				slot = static_cast<int16_t>(i);
+			}
+			this->seed = seed;
+			this->mask = count - 1;
+			return true;
+		}
+
+		/**
+		 * @brief Read a signed integer, as sscanf("%lld") does.
+		 */
+		static bool integer(const char *value, long long min, long long max, long long &out)
+		{
+			char *end = nullptr;
+			errno = 0;
+			out = strtoll(value, &end, 10);
+			return end != value && errno == 0 && out >= min && out <= max;
+		}
+
+		/**
+		 * @brief Read an unsigned integer, as sscanf("%llu") does.
+		 */
+		static bool natural(const char *value, unsigned long long max, unsigned long long &out)
+		{
+			char *end = nullptr;
+			errno = 0;
+			out = strtoull(value, &end, 10);
+			return end != value && errno == 0 && out <= max;
+		}
+
+		//! @brief Read \a value into \a out.
+		static bool parse(const char *value, int &out)
+		{
+			long long read = 0;
+			if (!integer(value, INT_MIN, INT_MAX, read))
+			{
+				return false;
+			}
+			out = static_cast<int>(read);
+			return true;
+		}
+
+		//! @brief Read \a value into \a out.
+		static bool parse(const char *value, int64_t &out)
+		{
+			long long read = 0;
+			if (!integer(value, LLONG_MIN, LLONG_MAX, read))
+			{
+				return false;
+			}
+			out = static_cast<int64_t>(read);
+			return true;
+		}
+
+		//! @brief Read \a value into \a out.
+		static bool parse(const char *value, unsigned int &out)
+		{
+			unsigned long long read = 0;
+			if (!natural(value, UINT_MAX, read))
+			{
+				return false;
+			}
+			out = static_cast<unsigned int>(read);
+			return true;
+		}
+
+		//! @brief Read \a value into \a out.
+		static bool parse(const char *value, uint64_t &out)
+		{
+			unsigned long long read = 0;
+			if (!natural(value, ULLONG_MAX, read))
+			{
+				return false;
+			}
+			out = static_cast<uint64_t>(read);
+			return true;
+		}
+
+		//! @brief Read \a value into \a out.
+		static bool parse(const char *value, float &out)
+		{
+			char *end = nullptr;
+			const float read = strtof(value, &end);
+			if (end == value)
+			{
+				return false;
+			}
+			out = read;
+			return true;
+		}
+
+		//! @brief Read \a value into \a out.
+		static bool parse(const char *value, double &out)
+		{
+			char *end = nullptr;
+			const double read = strtod(value, &end);
+			if (end == value)
+			{
+				return false;
+			}
+			out = read;
+			return true;
+		}
+
+		//! @brief Read \a value into \a out : an integer (true if not 0), true or false.
+		static bool parse(const char *value, bool &out)
+		{
+			int read = 0;
+			if (parse(value, read))
+			{
+				out = read != 0;
+				return true;
+			}
+			if (strcmp(value, "true") == 0 || strcmp(value, "false") == 0)
+			{
+				out = value[0] == 't';
+				return true;
+			}
+			return false;
+		}
+
+		//! @brief Read \a value into \a out.
+		static bool parse(const char *value, std::string &out)
+		{
+			out.assign(value);
+			return true;
+		}
+
+		/**
+		 * @brief Convert \a value into the member of the field \a field, the \b I th or a next one.
+		 * @return false if it cannot be converted.
+		 */
+		template<size_t I>
+		typename std::enable_if<(I < sizeof...(F)), bool>::type convert(size_t field, const char *value, S &out) const
+		{
+			if (field != I)
+			{
+				return this->convert<I + 1>(field, value, out);
+			}
+			return parse(value, out.*(std::get<I>(this->fields).member));
+		}
+
+		//! @brief The end of convert() : there is no such field.
+		template<size_t I>
+		typename std::enable_if<(I == sizeof...(F)), bool>::type convert(size_t, const char*, S&) const
+		{
+			return false;
+		}
+
+	public:
+		/**
+		 * @brief Build the map of \a fields, and find a perfect hash for their names.
+		 * @param[in] fields Each attribute, and the member it is read into.
+		 * @throw std::string if an attribute is mapped twice.
+		 */
+		explicit XmlAttributeMap(F... fields) : fields(fields...), names{fields.name...}, seed(0), mask(0)
+		{
+			static_assert(sizeof...(F) > 0, "an attribute map reads one attribute at least");
+			static_assert(sizeof...(F) <= 0x7FFF, "an attribute map reads 32767 attributes at most");
+			for(size_t i = 0; i < this->names.size(); ++i)
+			{
+				for(size_t j = 0; j < i; ++j)
+				{
+					if (this->names[i] == this->names[j])
+					{
+						std::cerr << "[ERROR]: the attribute " << this->names[i] << " is mapped twice" << std::endl;
+						throw std::string("Bad attribute map");
+					}
+				}
+			}
+			// Twice as many slots as names, and more if no seed spreads them.
+			uint32_t count = 2;
+			while(count < 2 * this->names.size())
+			{
+				count <<= 1;
+			}
+			for(;; count <<= 1)
+			{
+				for(uint32_t seed = 0; seed < 256; ++seed)
+				{
+					if (this->place(seed, count))
+					{
+						return;
+					}
+				}
+			}
+		}
+
+		/**
+		 * @brief Read every attribute of \a element in the map into its member of \a out.
+		 *
+		 * The members of the attributes \a element does not have, or whose value
+		 * cannot be converted, are left unchanged.
+		 * @param[in]  element The element, nullptr for none.
+		 * @param[out] out     Where to read them.
+		 * @return The number of members read.
+		 */
+		size_t read(const xml2::XMLElement *element, S &out) const
+		{
+			if (element == nullptr)
+			{
+				return 0;
+			}
+			size_t read = 0;
+			for(const xml2::XMLAttribute *attribute = element->FirstAttribute(); attribute != nullptr; attribute = attribute->Next())
+			{
+				const char *name = attribute->Name();
+				size_t length = 0;
+				const int16_t slot = this->slots[hash(name, length, this->seed) & this->mask];
+				if (slot == empty)
+				{
+					continue;
+				}
+				const std::string &field = this->names[static_cast<size_t>(slot)];
+				if (field.size() == length && memcmp(field.data(), name, length) == 0 && this->convert<0>(static_cast<size_t>(slot), attribute->Value(), out))
+				{
+					++read;
+				}
+			}
+			return read;
+		}
+
+		/**
+		 * @brief The number of attributes in the map.
+		 */
+		size_t size(void) const
+		{
+			return sizeof...(F);
+		}
+};
+
+/**
+ * @brief Make the field reading the attribute \a name into \a member (see XmlAttributeMap).
+ */
+template<typename S, typename T>
+XmlField<S, T> xmlField(const char *name, T S::*member)
+{
+	return XmlField<S, T>(name, member);
+}
+
+/**
+ * @brief Make the map of \a fields, made by xmlField() (see XmlAttributeMap).
+ * @throw std::string if an attribute is mapped twice.
+ */
+template<typename S, typename... T>
+XmlAttributeMap<S, XmlField<S, T>...> xmlAttributes(XmlField<S, T>... fields)
+{
+	return XmlAttributeMap<S, XmlField<S, T>...>(fields...);
+}
+
+#endif
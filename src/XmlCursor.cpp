@@ -0,0 +1,145 @@
+#include "XmlCursor.hpp"
+
+
+bool XmlCursor::valid(void) const
+{
+	return this->current != nullptr;
+}
+
+XmlCursor::operator bool(void) const
+{
+	return this->current != nullptr;
+}
+
+XmlCursor XmlCursor::element(const std::string &name) const
+{
+	if (this->current == nullptr)
+	{
+		return XmlCursor();
+	}
+	return XmlCursor(this->current->FirstChildElement(name.c_str()));
+}
+
+XmlChildren XmlCursor::children(const std::string &name) const
+{
+	return XmlChildren(this->current, name);
+}
+
+XmlCursor XmlCursor::next(const std::string &name) const
+{
+	if (this->current == nullptr)
+	{
+		return XmlCursor();
+	}
+	return XmlCursor(this->current->NextSiblingElement(name.empty() ? nullptr : name.c_str()));
+}
+
+std::string XmlCursor::name(void) const
+{
+	if (this->current == nullptr)
+	{
+		return this->sentinel<std::string>();
+	}
+	return std::string(this->current->Name());
+}
+
+size_t XmlCursor::sourceBegin(void) const
+{
+	return (this->current == nullptr) ? 0 : this->current->SourceBegin();
+}
+
+size_t XmlCursor::sourceEnd(void) const
+{
+	return (this->current == nullptr) ? 0 : this->current->SourceEnd();
+}
+
+int XmlCursor::sourceLine(void) const
+{
+	return (this->current == nullptr) ? 0 : this->current->SourceLine();
+}
+
+const xml2::XMLElement* XmlCursor::get(void) const
+{
+	return this->current;
+}
+
+XmlView XmlCursor::rawText(void) const
+{
+	XmlView view;
+	if (this->current != nullptr)
+	{
+		view.data = this->current->GetRawText(&view.size);
+	}
+	return view;
+}
+
+XmlView XmlCursor::rawAttribute(const std::string &att) const
+{
+	XmlView view;
+	const xml2::XMLAttribute *attribute = (this->current == nullptr) ? nullptr : this->current->FindAttribute(att.c_str());
+	if (attribute != nullptr)
+	{
+		view.data = attribute->RawValue(&view.size);
+	}
+	return view;
+}
+
+#define CURSOR_ATTRIBUTE_MATCH(type, function)                  \
+template<>                                                      \
+type XmlCursor::attribute(const std::string &att) const         \
+{                                                               \
+	type tmp;                                                   \
+	if (this->current == nullptr                                \
+	 || this->current->function(att.c_str(), &tmp) != xml2::XML_SUCCESS) \
+	{                                                           \
+		return this->sentinel<type>();                          \
+	}                                                           \
+	return tmp;                                                 \
+}
+
+#define CURSOR_TEXT_MATCH(type, function)                       \
+template<>                                                      \
+type XmlCursor::text(void) const                                \
+{                                                               \
+	type tmp;                                                   \
+	if (this->current == nullptr                                \
+	 || this->current->function(&tmp) != xml2::XML_SUCCESS)     \
+	{                                                           \
+		return this->sentinel<type>();                          \
+	}                                                           \
+	return tmp;                                                 \
+}
+
+template<>
+std::string XmlCursor::text(void) const
+{
+	const char *value = (this->current == nullptr) ? nullptr : this->current->GetText();
+	if (value == nullptr)
+	{
+		return this->sentinel<std::string>();
+	}
+	return std::string(value);
+}
+
+template<>
+std::string XmlCursor::attribute(const std::string &att) const
+{
+	const char *value = (this->current == nullptr) ? nullptr : this->current->Attribute(att.c_str());
+	if (value == nullptr)
+	{
+		return this->sentinel<std::string>();
+	}
+	return std::string(value);
+}
+
+CURSOR_ATTRIBUTE_MATCH(float,        QueryFloatAttribute)
+CURSOR_ATTRIBUTE_MATCH(int,          QueryIntAttribute)
+CURSOR_ATTRIBUTE_MATCH(unsigned int, QueryUnsignedAttribute)
+CURSOR_ATTRIBUTE_MATCH(bool,         QueryBoolAttribute)
+CURSOR_ATTRIBUTE_MATCH(double,       QueryDoubleAttribute)
+
+CURSOR_TEXT_MATCH(float,        QueryFloatText)
+CURSOR_TEXT_MATCH(int,          QueryIntText)
+CURSOR_TEXT_MATCH(unsigned int, QueryUnsignedText)
+CURSOR_TEXT_MATCH(double,       QueryDoubleText)
+CURSOR_TEXT_MATCH(bool,         QueryBoolText)
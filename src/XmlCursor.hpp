@@ -0,0 +1,267 @@
+/**
+ * @file XmlCursor.hpp
+ * @brief Defines a lightweight handle on an element, which never changes the tree.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef XMLCURSOR_HPP_INCLUDED
+#define XMLCURSOR_HPP_INCLUDED
+
+#include <string>
+#include <iterator>
+#include <cstddef>
+#include "tinyxml2.h"
+#include "XmlAttributeMap.hpp"
+#include "XmlView.hpp"
+
+namespace xml2 = tinyxml2;
+
+class XmlChildren;
+
+
+/**
+ * @brief A handle on an element, which can only go down the tree.
+ *
+ * It is nothing more than a pointer, so it is cheap to copy, and it never
+ * changes the tree nor the state of the XmlLoader it comes from. It is not
+ * read-only at the byte level though : text() and attribute() decode the
+ * characters in the parse buffer of the document the first time they are
+ * read (entities, newlines), and write them there. So two cursors can be
+ * used from two threads at the same time only if they do not share any
+ * node : on two disjoint subtrees, as the records parallelForEachNodeNamed()
+ * gives to each worker. Reading the same elements from two threads, through
+ * cursors or through the XmlLoader, is a data race.
+ *
+ * Unlike XmlLoader, it never prints warnings : a missing element gives an
+ * invalid cursor, and reading from an invalid cursor gives default values.
+ * @author MTLCRBN
+ */
+class XmlCursor final
+{
+	private:
+		const xml2::XMLElement* current; //!< The element, or nullptr.
+
+		/**
+		 * @brief Return the default value of the type \b T.
+		 * @return T()
+		 */
+		template<typename T>
+		inline T sentinel(void) const
+		{
+			return T();
+		}
+
+	public:
+		/**
+		 * @brief Create a cursor on \a element.
+		 * @param[in] element The element, nullptr gives an invalid cursor.
+		 */
+		explicit XmlCursor(const xml2::XMLElement *element = nullptr) : current(element)
+		{
+
+		}
+
+		/**
+		 * @brief Tell if the cursor is on an element.
+		 */
+		bool valid(void) const;
+
+		/**
+		 * @brief Same as valid().
+		 */
+		explicit operator bool(void) const;
+
+		/**
+		 * @brief Get the first child element named \a name.
+		 * @param[in] name The name of the child.
+		 * @return A cursor on it, invalid if there is none.
+		 */
+		XmlCursor element(const std::string &name) const;
+
+		/**
+		 * @brief Get the child elements named \a name, to iterate over them.
+		 * @param[in] name The name of the children, "" for any name.
+		 * @return A range on them, empty if the cursor is invalid.
+		 */
+		XmlChildren children(const std::string &name = "") const;
+
+		/**
+		 * @brief Get the next sibling element named \a name.
+		 * @param[in] name The name of the sibling, "" for any name.
+		 * @return A cursor on it, invalid if there is none.
+		 */
+		XmlCursor next(const std::string &name = "") const;
+
+		/**
+		 * @brief Get the name of the element.
+		 * @return Its name, or "" if the cursor is invalid.
+		 */
+		std::string name(void) const;
+
+		/**
+		 * @brief Same as XmlLoader::sourceBegin(), on the element.
+		 */
+		size_t sourceBegin(void) const;
+
+		/**
+		 * @brief Same as XmlLoader::sourceEnd(), on the element.
+		 */
+		size_t sourceEnd(void) const;
+
+		/**
+		 * @brief Same as XmlLoader::sourceLine(), on the element.
+		 */
+		int sourceLine(void) const;
+
+		/**
+		 * @brief Get the value of the attribute \a att, as XmlLoader::attribute() does.
+		 * @param[in] att The attribute name.
+		 * @return the readed value, or a default one if any error occurs.
+		 */
+		template<typename T>
+		T attribute(const std::string &att) const;
+
+		/**
+		 * @brief Read the attributes of \a map into \a out, as XmlLoader::attributes() does.
+		 * @return The number of members read.
+		 */
+		template<typename S, typename... F>
+		size_t attributes(const XmlAttributeMap<S, F...> &map, S &out) const
+		{
+			return map.read(this->current, out);
+		}
+
+		/**
+		 * @brief Get the text of the element, as XmlLoader::text() does.
+		 * @return the readed value, or a default one if any error occurs.
+		 */
+		template<typename T>
+		T text(void) const;
+
+		/**
+		 * @brief Get the text of the element as it is in the file, as XmlLoader::rawText() does.
+		 */
+		XmlView rawText(void) const;
+
+		/**
+		 * @brief Get the value of the attribute \a att as it is in the file, as XmlLoader::rawAttribute() does.
+		 */
+		XmlView rawAttribute(const std::string &att) const;
+
+		/**
+		 * @brief Get the element itself.
+		 */
+		const xml2::XMLElement* get(void) const;
+};
+
+
+/**
+ * @brief The child elements of an element having a name, to iterate over
+ * them with a range-based for, in document order :
+ * @code
+ * for(XmlCursor person : loader.children("person"))
+ * {
+ * 	total += person.attribute<int>("age");
+ * }
+ * @endcode
+ * It is lazy : each step is a walk to the next sibling with that name, and
+ * the loop compiles down to that walk (no std::function, no allocation).
+ * The range keeps the name : it must outlive the iteration, as a range-based for does.
+ * @author MTLCRBN
+ */
+class XmlChildren final
+{
+	public:
+		/**
+		 * @brief Walk the children, from one sibling to the next.
+		 */
+		class iterator final
+		{
+			private:
+				const xml2::XMLElement* current; //!< The child, nullptr at the end.
+				const char*             name;    //!< The name of the children, nullptr for any.
+
+			public:
+				typedef std::forward_iterator_tag iterator_category; //!< Only forward.
+				typedef XmlCursor                 value_type;        //!< What it gives.
+				typedef std::ptrdiff_t            difference_type;   //!< Unused.
+				typedef const XmlCursor*          pointer;           //!< Unused.
+				typedef XmlCursor                 reference;         //!< A cursor, by value.
+
+				//! @brief An iterator on \a current, walking the siblings named \a name.
+				iterator(const xml2::XMLElement *current, const char *name) : current(current), name(name)
+				{
+
+				}
+
+				//! @brief Get a cursor on the child.
+				XmlCursor operator*(void) const
+				{
+					return XmlCursor(this->current);
+				}
+
+				//! @brief Go to the next sibling having the name.
+				iterator& operator++(void)
+				{
+					this->current = this->current->NextSiblingElement(this->name);
+					return *this;
+				}
+
+				//! @brief Same as operator++(), giving the previous position.
+				iterator operator++(int)
+				{
+					iterator previous = *this;
+					++*this;
+					return previous;
+				}
+
+				//! @brief Tell if both are on the same child.
+				bool operator==(const iterator &other) const
+				{
+					return this->current == other.current;
+				}
+
+				//! @brief Tell if they are on different children.
+				bool operator!=(const iterator &other) const
+				{
+					return this->current != other.current;
+				}
+		};
+
+	private:
+		std::string             name;  //!< The name of the children, "" for any.
+		const xml2::XMLElement* first; //!< The first of them.
+
+	public:
+		/**
+		 * @brief The children of \a parent named \a name.
+		 * @param[in] parent The parent, nullptr for no children.
+		 * @param[in] name   The name of the children, "" for any name.
+		 */
+		XmlChildren(const xml2::XMLNode *parent, const std::string &name) :
+			name(name), first((parent == nullptr) ? nullptr : parent->FirstChildElement(name.empty() ? nullptr : name.c_str()))
+		{
+
+		}
+
+		//! @brief Where the iteration starts.
+		iterator begin(void) const
+		{
+			return iterator(this->first, this->name.empty() ? nullptr : this->name.c_str());
+		}
+
+		//! @brief Where it ends.
+		iterator end(void) const
+		{
+			return iterator(nullptr, nullptr);
+		}
+
+		//! @brief Tell if there is no such child.
+		bool empty(void) const
+		{
+			return this->first == nullptr;
+		}
+};
+
+#endif
@@ -0,0 +1,499 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+
+#include "XmlEditor.hpp"
+#include "XmlInput.hpp"
+
+
+namespace
+{
+	/**
+	 * @brief Write \a value with the characters xml reserves replaced by entities.
+	 * @param[in] quoted true for an attribute value, its quotes are replaced too.
+	 */
+	void escape(std::ostream &out, const char *value, bool quoted)
+	{
+		const char *from = value;
+		for(const char *p = value; *p != '\0'; ++p)
+		{
+			const char *entity = nullptr;
+			switch(*p)
+			{
+				case '&': entity = "&amp;"; break;
+				case '<': entity = "&lt;";  break;
+				case '>': entity = "&gt;";  break;
+				case '"': entity = quoted ? "&quot;" : nullptr; break;
+				default : break;
+			}
+			if (entity != nullptr)
+			{
+				out.write(from, p - from);
+				out << entity;
+				from = p + 1;
+			}
+		}
+		out << from;
+	}
+}
+
+XmlEditor::XmlEditor(const std::string &fname, const XmlOptions &options) : _XmlBase(), fname(fname), source(nullptr), length(0)
+{
+	std::unique_ptr<XmlInput> input = XmlInput::open(fname);
+	this->zipped = input->compressed();
+	this->doc.SetLazyDepth(static_cast<int>(options.lazyDepth));
+	this->doc.SetTrackLines(options.lineNumbers);
+	xml2::XMLError err;
+	if (input->verbatim())
+	{
+		// Parsed from the mapping : the characters are only copied into the document.
+		input.reset();
+		this->mapping.reset(new XmlMapping(fname));
+		this->source = this->mapping->data();
+		this->length = this->mapping->size();
+		err = this->doc.Parse(this->source, this->length);
+	}
+	else
+	{
+		// Decoded once, straight into the document, and kept as they were before the parse writes into them.
+		this->length  = input->fill(this->doc);
+		this->decoded.assign(this->doc.ReserveBuffer(this->length, this->length), this->length);
+		this->source  = this->decoded.data();
+		err = this->doc.ParseBuffer(this->length);
+	}
+	if (err != xml2::XML_SUCCESS)
+	{
+		std::cerr << "[ERROR]: while loading " << fname << std::endl;
+		throw std::string("File not found");
+	}
+	this->root = this->doc.RootElement();
+	if (this->root == nullptr)
+	{
+		std::cerr << "[ERROR]: First element does not exist" << std::endl;
+		throw std::string("Bad format");
+	}
+	this->_gotoRoot();
+	this->onNode = true;
+	this->onText = true;
+}
+
+XmlEditor::~XmlEditor(void)
+{
+	this->onNode = false;
+	this->onText = false;
+	this->attName.clear();
+	this->changes.clear();
+}
+
+void XmlEditor::mark(const xml2::XMLNode *element, int change)
+{
+	this->changes[element] |= change;
+	for(const xml2::XMLNode *parent = element->Parent(); parent != nullptr && parent != &this->doc; parent = parent->Parent())
+	{
+		int &changed = this->changes[parent];
+		if (changed & BELOW)
+		{
+			// And so are its own parents.
+			break;
+		}
+		changed |= BELOW;
+	}
+}
+
+void XmlEditor::unmark(const xml2::XMLNode *top)
+{
+	if (this->changes.empty())
+	{
+		return;
+	}
+	this->changes.erase(top);
+	const xml2::XMLElement *current = top->FirstChildElement();
+	while(current != nullptr)
+	{
+		this->changes.erase(current);
+		const xml2::XMLElement *next = current->FirstChildElement();
+		if (next == nullptr)
+		{
+			next = current->NextSiblingElement();
+			while(next == nullptr && current->Parent() != top)
+			{
+				current = current->Parent()->ToElement();
+				next    = current->NextSiblingElement();
+			}
+		}
+		current = next;
+	}
+}
+
+xml2::XMLElement* XmlEditor::selected(void) const
+{
+	xml2::XMLNode *selected = this->onNode ? this->currentNode : this->currentElement;
+	return (selected == nullptr) ? nullptr : selected->ToElement();
+}
+
+xml2::XMLElement* XmlEditor::expand(xml2::XMLElement *element) const
+{
+	if (element != nullptr && element->Unexpanded() && element->Expand() != xml2::XML_SUCCESS)
+	{
+		std::cerr << "[ERROR]: while parsing the content of <" << element->Name() << ">" << std::endl;
+		throw std::string("Bad format");
+	}
+	return element;
+}
+
+XmlEditor& XmlEditor::element(const std::string &name)
+{
+	this->currentElement = this->expand(this->currentNode->ToElement())->FirstChildElement(name.c_str());
+	if (this->currentElement == nullptr)
+	{
+		std::cerr << "[WARNING]: <" << name << "> does not exist" << std::endl;
+	}
+	this->onNode = false;
+	return *this;
+}
+
+XmlEditor& XmlEditor::node(const std::string &name)
+{
+	xml2::XMLNode *tmp = this->expand(this->currentNode->ToElement())->FirstChildElement(name.c_str());
+	if (tmp != nullptr)
+	{
+		this->visited.push(this->currentNode);
+		this->currentNode = tmp;
+	}
+	else
+	{
+		std::cerr << "[WARNING] : There is no child named " << name << std::endl;
+	}
+	this->onNode = true;
+	return *this;
+}
+
+bool XmlEditor::nextNode(void)
+{
+	this->onNode = true;
+	if (this->currentNode == this->root)
+	{
+		return false;
+	}
+	xml2::XMLElement *next = this->currentNode->NextSiblingElement();
+	if (next == nullptr)
+	{
+		return false;
+	}
+	this->currentNode    = next;
+	this->currentElement = nullptr;
+	return true;
+}
+
+XmlEditor& XmlEditor::prev(uint32_t of)
+{
+	this->_prev(of);
+	this->onNode = true;
+	return *this;
+}
+
+XmlEditor& XmlEditor::backToRoot(void)
+{
+	this->_gotoRoot();
+	this->onNode = true;
+	return *this;
+}
+
+XmlEditor& XmlEditor::addElement(const std::string &name)
+{
+	this->currentElement = this->doc.NewElement(name.c_str());
+	this->expand(this->currentNode->ToElement())->InsertEndChild(this->currentElement);
+	this->mark(this->currentNode, CONTENT);
+	this->onNode = false;
+	return *this;
+}
+
+XmlEditor& XmlEditor::addNode(const std::string &name)
+{
+	xml2::XMLNode *tmp = this->doc.NewElement(name.c_str());
+	this->expand(this->currentNode->ToElement())->InsertEndChild(tmp);
+	this->mark(this->currentNode, CONTENT);
+	this->visited.push(this->currentNode);
+	this->currentNode    = tmp;
+	this->currentElement = nullptr;
+	this->onNode         = true;
+	return *this;
+}
+
+XmlEditor& XmlEditor::remove(void)
+{
+	xml2::XMLElement *target = this->selected();
+	if (target == nullptr || target == this->root)
+	{
+		std::cerr << "[WARNING] : Cannot remove without any element selected, or the root !" << std::endl;
+		return *this;
+	}
+	xml2::XMLNode *parent = target->Parent();
+	if (this->onNode)
+	{
+		this->currentNode = parent;
+		if (!this->visited.empty())
+		{
+			this->visited.pop();
+		}
+	}
+	this->currentElement = nullptr;
+	this->unmark(target);
+	this->mark(parent, CONTENT);
+	parent->DeleteChild(target);
+	return *this;
+}
+
+XmlEditor& XmlEditor::removeAttribute(const std::string &name)
+{
+	xml2::XMLElement *here = this->selected();
+	if (here != nullptr && here->Attribute(name.c_str()) != nullptr)
+	{
+		here->DeleteAttribute(name.c_str());
+		this->mark(here, TAG);
+	}
+	return *this;
+}
+
+XmlEditor& XmlEditor::text(void)
+{
+	this->onText = true;
+	this->attName.clear();
+	return *this;
+}
+
+XmlEditor& XmlEditor::attribute(const std::string &name)
+{
+	this->onText  = false;
+	this->attName = name;
+	return *this;
+}
+
+template<typename T>
+XmlEditor& XmlEditor::assign(T value)
+{
+	if (this->onText)
+	{
+		if (this->currentElement == nullptr)
+		{
+			std::cerr << "[WARNING] : Cannot attach a text without any element selected !" << std::endl;
+			return *this;
+		}
+		this->expand(this->currentElement)->SetText(value);
+		this->mark(this->currentElement, CONTENT);
+		return *this;
+	}
+	xml2::XMLElement *here = this->selected();
+	if (here == nullptr)
+	{
+		std::cerr << "[WARNING] : Cannot attach an attribute without any element selected !" << std::endl;
+		return *this;
+	}
+	here->SetAttribute(this->attName.c_str(), value);
+	this->mark(here, TAG);
+	return *this;
+}
+
+XmlEditor& XmlEditor::operator=(bool value)
+{
+	return this->assign(value);
+}
+
+XmlEditor& XmlEditor::operator=(unsigned int value)
+{
+	return this->assign(value);
+}
+
+XmlEditor& XmlEditor::operator=(int value)
+{
+	return this->assign(value);
+}
+
+XmlEditor& XmlEditor::operator=(double value)
+{
+	return this->assign(value);
+}
+
+XmlEditor& XmlEditor::operator=(float value)
+{
+	return this->assign(value);
+}
+
+XmlEditor& XmlEditor::operator=(const std::string &value)
+{
+	return this->assign(value.c_str());
+}
+
+XmlEditor& XmlEditor::operator=(const char *const value)
+{
+	return this->assign(value);
+}
+
+bool XmlEditor::modified(void) const
+{
+	return !this->changes.empty();
+}
+
+void XmlEditor::copy(std::ostream &out, size_t begin, size_t end, bool blank) const
+{
+	if (blank && !std::all_of(this->source + begin, this->source + end,
+	                          [](char c) { return xml2::XMLUtil::IsWhiteSpace(c); }))
+	{
+		return;
+	}
+	out.write(this->source + begin, end - begin);
+}
+
+void XmlEditor::write(std::ostream &out, const xml2::XMLNode *node) const
+{
+	const xml2::XMLElement *element = node->ToElement();
+	const xml2::XMLText    *text    = node->ToText();
+	if (element != nullptr)
+	{
+		this->write(out, element);
+	}
+	else if (text != nullptr && text->CData())
+	{
+		out << "<![CDATA[" << text->Value() << "]]>";
+	}
+	else if (text != nullptr)
+	{
+		escape(out, text->Value(), false);
+	}
+	else if (node->ToComment() != nullptr)
+	{
+		out << "<!--" << node->Value() << "-->";
+	}
+	else if (node->ToDeclaration() != nullptr)
+	{
+		out << "<?" << node->Value() << "?>";
+	}
+	else
+	{
+		out << "<!" << node->Value() << ">";
+	}
+}
+
+void XmlEditor::write(std::ostream &out, const xml2::XMLElement *element) const
+{
+	const std::unordered_map<const xml2::XMLNode*, int>::const_iterator found = this->changes.find(element);
+	const bool inFile = element->SourceEnd() > 0;
+	const int change  = !inFile ? (TAG | CONTENT) : (found == this->changes.end()) ? 0 : found->second;
+	if (change == 0)
+	{
+		this->copy(out, element->SourceBegin(), element->SourceEnd());
+		return;
+	}
+
+	// The opening tag.
+	const size_t npos        = std::string::npos;
+	// SkipTag() only reads : the file is not changed.
+	char *const  text        = const_cast<char*>(this->source);
+	const size_t tagEnd      = inFile ? static_cast<size_t>(xml2::XMLUtil::SkipTag(text + element->SourceBegin() + 1) - text) : npos;
+	const bool   selfClosing = inFile && this->source[tagEnd - 2] == '/';
+	if ((change & TAG) || !inFile || (selfClosing && !element->NoChildren()))
+	{
+		out << '<' << element->Name();
+		for(const xml2::XMLAttribute *att = element->FirstAttribute(); att != nullptr; att = att->Next())
+		{
+			out << ' ' << att->Name() << "=\"";
+			escape(out, att->Value(), true);
+			out << '"';
+		}
+		if (element->NoChildren() && (!inFile || selfClosing))
+		{
+			out << "/>";
+			return;
+		}
+		out << '>';
+	}
+	else
+	{
+		this->copy(out, element->SourceBegin(), tagEnd);
+	}
+
+	// The content : what is between the children kept from the file is copied
+	// as is if the content did not change, only if it is whitespaces otherwise.
+	const bool verbatim = !(change & CONTENT);
+	size_t     from     = (inFile && !selfClosing) ? tagEnd : npos;
+	for(const xml2::XMLNode *node = element->FirstChild(); node != nullptr; node = node->NextSibling())
+	{
+		const xml2::XMLElement *child = node->ToElement();
+		if (child != nullptr && child->SourceEnd() > 0)
+		{
+			if (from != npos)
+			{
+				this->copy(out, from, child->SourceBegin(), !verbatim);
+			}
+			this->write(out, child);
+			from = child->SourceEnd();
+		}
+		else if (!verbatim)
+		{
+			this->write(out, node);
+			from = npos;
+		}
+	}
+
+	// The closing tag.
+	size_t closing = npos;
+	if (inFile && !selfClosing)
+	{
+		closing = element->SourceEnd() - 1;
+		while(this->source[closing] != '<')
+		{
+			--closing;
+		}
+	}
+	if (from != npos && closing != npos)
+	{
+		this->copy(out, from, closing, !verbatim);
+	}
+	if (verbatim)
+	{
+		this->copy(out, closing, element->SourceEnd());
+	}
+	else
+	{
+		out << "</" << element->Name() << '>';
+	}
+}
+
+void XmlEditor::saveAs(const std::string &fname)
+{
+	const std::string partial = fname + ".tmp";
+	{
+		std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+		// Only the elements are marked : what is around the root is copied.
+		size_t from = 0;
+		for(const xml2::XMLElement *element = this->doc.FirstChildElement(); element != nullptr; element = element->NextSiblingElement())
+		{
+			this->copy(out, from, element->SourceBegin());
+			this->write(out, element);
+			from = element->SourceEnd();
+		}
+		this->copy(out, from, this->length);
+		out.close();
+		if (!out)
+		{
+			std::remove(partial.c_str());
+			throw std::string("Error while writing ") + fname;
+		}
+	}
+	if (std::rename(partial.c_str(), fname.c_str()) != 0)
+	{
+		std::remove(partial.c_str());
+		throw std::string("Error while writing ") + fname;
+	}
+}
+
+void XmlEditor::save(void)
+{
+	if (this->zipped)
+	{
+		std::cerr << "[ERROR]: " << this->fname << " is compressed, and can only be saved uncompressed : use saveAs()" << std::endl;
+		throw std::string("Compressed file");
+	}
+	this->saveAs(this->fname);
+}
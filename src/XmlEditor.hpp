@@ -0,0 +1,287 @@
+/**
+ * @file XmlEditor.hpp
+ * @brief This file proposes an overlay for tinyxml2 to change an existing xml file.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef XMLEDITOR_HPP_INCLUDED
+#define XMLEDITOR_HPP_INCLUDED
+
+#include <string>
+#include <ostream>
+#include <memory>
+#include <unordered_map>
+#include "XmlBase.hpp"
+#include "XmlOptions.hpp"
+
+namespace xml2 = tinyxml2;
+
+class XmlMapping;
+
+/**
+ * @brief Load a xml file, change it in place, and save it.
+ *
+ * It is navigated as a XmlLoader, and written as a XmlWriter :
+ * @code
+ * XmlEditor editor("catalog.xml");
+ * editor.node("record").element("price").text() = 12.5;
+ * editor.addElement("discount").attribute("rate") = 10;
+ * editor.save();
+ * @endcode
+ *
+ * The elements changed are marked, and so are their parents. Saving copies
+ * every subtree which is not marked as it is in the file, byte for byte
+ * (formatting, comments and entities included), and only writes again what
+ * was changed : the time spent writing is mostly a copy of the file.
+ * The whitespace between two elements of the file is kept, in a changed element too.
+ *
+ * The document is parsed from a single buffer, the parse writing into it :
+ * what saving copies is read from the file mapped in memory. Only a compressed
+ * or UTF-16 file is kept decoded beside it.
+ * @author MTLCRBN
+ */
+class XmlEditor final : public _XmlBase
+{
+	private:
+		/**
+		 * @brief How an element was changed.
+		 */
+		enum Change
+		{
+			TAG     = 1, //!< Its attributes.
+			CONTENT = 2, //!< Its children (texts included) : some were set, added or removed.
+			BELOW   = 4  //!< Something below its children.
+		};
+
+		std::string                                   fname;   //!< The file loaded.
+		std::unique_ptr<XmlMapping>                   mapping; //!< The file, if its characters are its bytes.
+		std::string                                   decoded; //!< Its characters otherwise, decompressed or transcoded.
+		const char*                                   source;  //!< Its content, as it was loaded.
+		size_t                                        length;  //!< The size of source.
+		bool                                          zipped;  //!< If the file is compressed.
+		std::unordered_map<const xml2::XMLNode*, int> changes; //!< The changes of each element (see Change).
+		bool                                          onNode;  //!< If the last selection was a node.
+		bool                                          onText;  //!< If the next value is a text or an attribute.
+		std::string                                   attName; //!< The name of the attribute to write.
+
+		/**
+		 * @brief Mark \a element with \a change, and its parents with BELOW.
+		 */
+		void mark(const xml2::XMLNode *element, int change);
+
+		/**
+		 * @brief Forget the marks of \a top and of everything below it, before it is deleted.
+		 */
+		void unmark(const xml2::XMLNode *top);
+
+		/**
+		 * @brief Get the current selection (node or element, as XmlLoader::attribute() does).
+		 * @return It, or nullptr if there is none.
+		 */
+		xml2::XMLElement* selected(void) const;
+
+		/**
+		 * @brief Parse the content of \a element if the lazy load skipped it.
+		 * @throw std::string if the content is not well formed.
+		 * @return \a element.
+		 */
+		xml2::XMLElement* expand(xml2::XMLElement *element) const;
+
+		/**
+		 * @brief Write \a element : as it is in the file if it was not changed,
+		 * the parts changed only otherwise.
+		 */
+		void write(std::ostream &out, const xml2::XMLElement *element) const;
+
+		/**
+		 * @brief Write \a node, which is not in the file or whose parent content changed.
+		 */
+		void write(std::ostream &out, const xml2::XMLNode *node) const;
+
+		/**
+		 * @brief Copy the characters [\a begin, \a end) of the file.
+		 * @param[in] blank true to copy them only if they are whitespaces.
+		 */
+		void copy(std::ostream &out, size_t begin, size_t end, bool blank = false) const;
+
+		/**
+		 * @brief Write \a value as the text or the attribute prepared by text() or attribute().
+		 */
+		template<typename T>
+		XmlEditor& assign(T value);
+
+		XmlEditor(void)                              = delete;
+		XmlEditor(const XmlEditor &other)            = delete;
+		XmlEditor(XmlEditor &&other)                 = delete;
+		XmlEditor& operator=(const XmlEditor &other) = delete;
+		XmlEditor& operator=(XmlEditor &&other)      = delete;
+
+	public:
+		/**
+		 * @brief Create a XmlEditor, and load the file \a fname with TinyXML2.
+		 * A compressed \a fname is decompressed as XmlLoader does it, but can only be
+		 * saved uncompressed, with saveAs().
+		 * A UTF-16 \a fname is saved in UTF-8.
+		 * @param[in] fname   The file to change.
+		 * @param[in] options Only XmlOptions::lazyDepth and XmlOptions::lineNumbers
+		 *                    are used : every element has to be loaded to be saved.
+		 * @throw std::string if there is issues when opening \a fname.
+		 * @throw std::string if there is issues when reading root of xml tree.
+		 */
+		XmlEditor(const std::string &fname, const XmlOptions &options = XmlOptions());
+
+		/**
+		 * @brief The destructor of this XmlEditor, the changes not saved are lost.
+		 */
+		~XmlEditor(void);
+
+		/**
+		 * @brief Select the first element named \a name inside the current node.
+		 * It will print a warning if there is none.
+		 * @return A reference to your XmlEditor, in order to chain it with \b .text() or \b .attribute()
+		 */
+		XmlEditor& element(const std::string &name);
+
+		/**
+		 * @brief Move to the first node named \a name inside the current node.
+		 * It will print a warning if there is none.
+		 * @return A reference on your XmlEditor.
+		 */
+		XmlEditor& node(const std::string &name);
+
+		/**
+		 * @brief Move the current node to its next sibling element, whatever its name,
+		 * as XmlLoader::nextNode() does.
+		 * @return false if there is no such element, the current node is then left unchanged.
+		 */
+		bool nextNode(void);
+
+		/**
+		 * @brief Go back of \a of node you previously visited.
+		 * @param[in] of The number of node you wanna go back.
+		 * @return A reference on your XmlEditor.
+		 */
+		XmlEditor& prev(uint32_t of = 1);
+
+		/**
+		 * @brief Go back to the root, as XmlLoader::backToRoot() does.
+		 * @return A reference on your XmlEditor.
+		 */
+		XmlEditor& backToRoot(void);
+
+		/**
+		 * @brief Create an element named \a name at the end of the current node, and select it.
+		 * @return A reference to your XmlEditor, in order to chain it with \b .text() or \b .attribute()
+		 */
+		XmlEditor& addElement(const std::string &name);
+
+		/**
+		 * @brief Create a node named \a name at the end of the current node, and move to it.
+		 * @return A reference on your XmlEditor.
+		 */
+		XmlEditor& addNode(const std::string &name);
+
+		/**
+		 * @brief Delete the current selection and everything inside it.
+		 * If it is the current node, the editor goes back to its parent.
+		 * The root cannot be deleted.
+		 * @return A reference on your XmlEditor.
+		 */
+		XmlEditor& remove(void);
+
+		/**
+		 * @brief Delete the attribute \a name of the current selection, if it has one.
+		 * @return A reference on your XmlEditor.
+		 */
+		XmlEditor& removeAttribute(const std::string &name);
+
+		/**
+		 * @brief Prepare your editor to replace the text of the current element.
+		 * @return A reference to your XmlEditor, in order to allow you to write your value.
+		 */
+		XmlEditor& text(void);
+
+		/**
+		 * @brief Prepare your editor to set an attribute of the current selection (node or element).
+		 * @param[in] name The name of the attribute.
+		 * @return A reference to your XmlEditor, in order to allow you to write your value.
+		 */
+		XmlEditor& attribute(const std::string &name);
+
+		/**
+		 * @brief Allow the user to write \a value as a boolean.
+		 * @param[in] value The value you wanna write.
+		 * @return A reference to the XmlEditor, but you don't have to use it again !
+		 */
+		XmlEditor& operator=(bool value);
+
+		/**
+		 * @brief Allow the user to write \a value as an unsigned int.
+		 * @param[in] value The value you wanna write.
+		 * @return A reference to the XmlEditor, but you don't have to use it again !
+		 */
+		XmlEditor& operator=(unsigned int value);
+
+		/**
+		 * @brief Allow the user to write \a value as an int.
+		 * @param[in] value The value you wanna write.
+		 * @return A reference to the XmlEditor, but you don't have to use it again !
+		 */
+		XmlEditor& operator=(int value);
+
+		/**
+		 * @brief Allow the user to write \a value as a double.
+		 * @param[in] value The value you wanna write.
+		 * @return A reference to the XmlEditor, but you don't have to use it again !
+		 */
+		XmlEditor& operator=(double value);
+
+		/**
+		 * @brief Allow the user to write \a value as a float.
+		 * @param[in] value The value you wanna write.
+		 * @return A reference to the XmlEditor, but you don't have to use it again !
+		 */
+		XmlEditor& operator=(float value);
+
+		/**
+		 * @brief Allow the user to write \a value as a string.
+		 * @param[in] value The value you wanna write.
+		 * @return A reference to the XmlEditor, but you don't have to use it again !
+		 */
+		XmlEditor& operator=(const std::string &value);
+
+		/**
+		 * @brief Allow the user to write \a value as a string.
+		 * @param[in] value The value you wanna write.
+		 * @return A reference to the XmlEditor, but you don't have to use it again !
+		 */
+		XmlEditor& operator=(const char *const value);
+
+		/**
+		 * @brief Tell if anything was changed since the file was loaded.
+		 */
+		bool modified(void) const;
+
+		/**
+		 * @brief Write the document into \a fname, the parts not changed being
+		 * copied from the file loaded.
+		 * The document is written next to \a fname first, and renamed once complete,
+		 * so \a fname is never left half written.
+		 * It can be saved many times : the changes stay relative to the file loaded.
+		 * @param[in] fname The path+name of the file to write.
+		 * @throw std::string If there is any issue while saving.
+		 */
+		void saveAs(const std::string &fname);
+
+		/**
+		 * @brief Same as saveAs() on the file loaded.
+		 * @throw std::string If the file loaded is compressed : it would be replaced by
+		 *                    plain xml under its compressed name, use saveAs() instead.
+		 * @throw std::string If there is any issue while saving.
+		 */
+		void save(void);
+
+};
+
+#endif
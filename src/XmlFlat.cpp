@@ -0,0 +1,408 @@
+#include <atomic>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+
+#include "XmlFlat.hpp"
+
+
+const uint32_t XmlFlat::npos;
+
+namespace
+{
+	// What comes next in the hash of an element, so that <a x="b"/> and <a>xb</a> differ.
+	const uint64_t ATTRIBUTE = 1; //!< An attribute.
+	const uint64_t TEXT      = 2; //!< A text.
+	const uint64_t CHILD     = 3; //!< The hash of a child element.
+
+	/**
+	 * @brief Mix \a value into \a hash.
+	 */
+	inline uint64_t mix(uint64_t hash, uint64_t value)
+	{
+		hash ^= value;
+		hash *= 0x9E3779B97F4A7C15ULL;
+		return hash ^ (hash >> 29);
+	}
+
+	/**
+	 * @brief Mix the characters of \a text into \a hash, 8 at a time, and its length.
+	 */
+	uint64_t mixText(uint64_t hash, const char *text)
+	{
+		const size_t length = strlen(text);
+		size_t i = 0;
+		for(; i + 8 <= length; i += 8)
+		{
+			uint64_t word;
+			memcpy(&word, text + i, 8);
+			hash = mix(hash, word);
+		}
+		uint64_t last = 0;
+		for(; i < length; ++i)
+		{
+			last = (last << 8) | static_cast<unsigned char>(text[i]);
+		}
+		return mix(mix(hash, last), length);
+	}
+
+	std::atomic<uint32_t> tables(0); //!< The number of tables built, for their id().
+
+	/**
+	 * @brief The id of a new table : 0 is kept for the atoms of no table.
+	 */
+	uint32_t nextId(void)
+	{
+		uint32_t id = ++tables;
+		while(id == 0)
+		{
+			id = ++tables;
+		}
+		return id;
+	}
+
+	const char *const XML_NAMESPACE = "http://www.w3.org/XML/1998/namespace"; //!< The namespace of the prefix xml.
+
+	/**
+	 * @brief A prefix bound to a namespace by an element, and the bindings in scope before it.
+	 */
+	struct Binding
+	{
+		uint32_t prefix;   //!< The atom of the prefix, the one of "" for the default namespace.
+		uint32_t space;    //!< The atom of the namespace URI, the one of "" for none.
+		uint32_t previous; //!< The binding in scope before, XmlFlat::npos for none.
+	};
+
+	/**
+	 * @brief Spread the bits of \a hash once an element is complete (the finalizer of MurmurHash3).
+	 */
+	inline uint64_t finish(uint64_t hash)
+	{
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDULL;
+		hash ^= hash >> 33;
+		hash *= 0xC4CEB9FE1A85EC53ULL;
+		return hash ^ (hash >> 33);
+	}
+}
+
+XmlFlat::XmlFlat(xml2::XMLDocument &doc) :
+	stamp(nextId())
+{
+	this->add(nullptr, XmlFlat::npos);
+	uint32_t parent = 0;
+	xml2::XMLElement *current = doc.FirstChildElement();
+	while(current != nullptr)
+	{
+		const uint32_t index = this->add(current, parent);
+		xml2::XMLElement *next = current->FirstChildElement();
+		if (next != nullptr)
+		{
+			parent = index;
+			current = next;
+			continue;
+		}
+		this->ends[index] = this->size();
+		// No children : go to the next sibling, or close the parents.
+		next = current->NextSiblingElement();
+		while(next == nullptr && parent != 0)
+		{
+			this->ends[parent] = this->size();
+			current = this->elements[parent];
+			parent  = this->parents[parent];
+			next    = current->NextSiblingElement();
+		}
+		current = next;
+	}
+	this->ends[0] = this->size();
+
+	this->names.shrink_to_fit();
+	this->ends.shrink_to_fit();
+	this->parents.shrink_to_fit();
+	this->elements.shrink_to_fit();
+}
+
+uint32_t XmlFlat::add(xml2::XMLElement *element, uint32_t parent)
+{
+	if (this->elements.size() >= XmlFlat::npos)
+	{
+		throw std::string("Too many elements to freeze");
+	}
+	const uint32_t index = static_cast<uint32_t>(this->elements.size());
+	this->names.push_back(element ? this->atoms.intern(element->Name()) : XmlAtoms::none);
+	this->ends.push_back(index + 1);
+	this->parents.push_back(parent);
+	this->elements.push_back(element);
+	if (element != nullptr)
+	{
+		// Stored shifted by one : a null user data means "not frozen".
+		element->SetUserData(reinterpret_cast<void*>(static_cast<uintptr_t>(index) + 1));
+	}
+	return index;
+}
+
+uint32_t XmlFlat::indexOf(const xml2::XMLNode *node) const
+{
+	if (node == nullptr)
+	{
+		return XmlFlat::npos;
+	}
+	if (node->ToDocument() != nullptr)
+	{
+		return 0;
+	}
+	const uintptr_t stored = reinterpret_cast<uintptr_t>(node->GetUserData());
+	if (node->ToElement() == nullptr || stored == 0 || stored > this->elements.size())
+	{
+		return XmlFlat::npos;
+	}
+	return static_cast<uint32_t>(stored - 1);
+}
+
+uint32_t XmlFlat::atom(const std::string &name) const
+{
+	return this->atoms.find(name);
+}
+
+uint32_t XmlFlat::firstChild(uint32_t index, uint32_t atom) const
+{
+	if (index == XmlFlat::npos || atom == XmlAtoms::none)
+	{
+		return XmlFlat::npos;
+	}
+	const uint32_t end = this->ends[index];
+	for(uint32_t child = index + 1; child < end; child = this->ends[child])
+	{
+		if (this->names[child] == atom)
+		{
+			return child;
+		}
+	}
+	return XmlFlat::npos;
+}
+
+uint32_t XmlFlat::nextSibling(uint32_t index, uint32_t atom) const
+{
+	if (index == XmlFlat::npos || index == 0 || atom == XmlAtoms::none)
+	{
+		return XmlFlat::npos;
+	}
+	const uint32_t end = this->ends[this->parents[index]];
+	for(uint32_t sibling = this->ends[index]; sibling < end; sibling = this->ends[sibling])
+	{
+		if (this->names[sibling] == atom)
+		{
+			return sibling;
+		}
+	}
+	return XmlFlat::npos;
+}
+
+xml2::XMLElement* XmlFlat::element(uint32_t index) const
+{
+	return (index == XmlFlat::npos) ? nullptr : this->elements[index];
+}
+
+void XmlFlat::hash(XmlPool *pool)
+{
+	this->hashes.assign(this->size(), 0);
+	std::vector<char> done(this->size(), 0);
+	if (pool != nullptr && pool->size() > 1)
+	{
+		// Go down, level by level, until there are enough subtrees for every thread.
+		std::vector<uint32_t> level(1, 0);
+		while(level.size() < pool->size()*16)
+		{
+			std::vector<uint32_t> below;
+			for(uint32_t parent : level)
+			{
+				for(uint32_t child = parent + 1; child < this->ends[parent]; child = this->ends[child])
+				{
+					below.push_back(child);
+				}
+			}
+			if (below.empty())
+			{
+				break;
+			}
+			level.swap(below);
+		}
+		// Each subtree is hashed by one thread : they write to different entries only.
+		pool->run(level.size(), 0, [&](size_t begin, size_t end) {
+			for(size_t i = begin; i < end; ++i)
+			{
+				this->hashRange(level[i], this->ends[level[i]], done);
+			}
+		});
+	}
+	// What is above them.
+	this->hashRange(1, this->size(), done);
+}
+
+void XmlFlat::hashRange(uint32_t begin, uint32_t end, std::vector<char> &done)
+{
+	for(uint32_t index = end; index-- > begin;)
+	{
+		if (done[index])
+		{
+			continue;
+		}
+		const xml2::XMLElement *element = this->elements[index];
+		uint64_t hash = mixText(0xCBF29CE484222325ULL, element->Name());
+		for(const xml2::XMLAttribute *att = element->FirstAttribute(); att != nullptr; att = att->Next())
+		{
+			hash = mixText(mixText(mix(hash, ATTRIBUTE), att->Name()), att->Value());
+		}
+		for(const xml2::XMLNode *node = element->FirstChild(); node != nullptr; node = node->NextSibling())
+		{
+			if (node->ToElement() != nullptr)
+			{
+				hash = mix(mix(hash, CHILD), this->hashes[this->indexOf(node)]);
+			}
+			else if (node->ToText() != nullptr)
+			{
+				hash = mixText(mix(hash, TEXT), node->Value());
+			}
+		}
+		this->hashes[index] = finish(hash);
+		done[index] = 1;
+	}
+}
+
+bool XmlFlat::hashed(void) const
+{
+	return !this->hashes.empty();
+}
+
+uint64_t XmlFlat::hashOf(uint32_t index) const
+{
+	return (index == XmlFlat::npos || index >= this->hashes.size()) ? 0 : this->hashes[index];
+}
+
+void XmlFlat::resolve(void)
+{
+	if (this->resolved())
+	{
+		return;
+	}
+	const uint32_t none = this->atoms.intern("");
+	// The prefix and local name of each qualified name, split once for all.
+	std::vector<std::pair<uint32_t, uint32_t>> split(this->atoms.size(), std::make_pair(XmlAtoms::none, XmlAtoms::none));
+	std::vector<Binding>  bindings(1, Binding{this->atoms.intern("xml"), this->atoms.intern(XML_NAMESPACE), XmlFlat::npos});
+	std::vector<uint32_t> scopes(this->size(), 0);
+	this->spaces.assign(this->size(), XmlAtoms::none);
+	this->locals.assign(this->size(), XmlAtoms::none);
+	for(uint32_t index = 1; index < this->size(); ++index)
+	{
+		// The parents come first : their scope is known.
+		uint32_t scope = scopes[this->parents[index]];
+		for(const xml2::XMLAttribute *att = this->elements[index]->FirstAttribute(); att != nullptr; att = att->Next())
+		{
+			const char *name = att->Name();
+			if (std::strncmp(name, "xmlns", 5) == 0 && (name[5] == '\0' || name[5] == ':'))
+			{
+				const uint32_t prefix = (name[5] == '\0') ? none : this->atoms.intern(name + 6);
+				bindings.push_back(Binding{prefix, this->atoms.intern(att->Value()), scope});
+				scope = static_cast<uint32_t>(bindings.size() - 1);
+			}
+		}
+		scopes[index] = scope;
+
+		std::pair<uint32_t, uint32_t> &qualified = split[this->names[index]];
+		if (qualified.second == XmlAtoms::none)
+		{
+			const std::string &name = this->atoms.name(this->names[index]);
+			const size_t colon = name.find(':');
+			qualified.first  = (colon == std::string::npos) ? none : this->atoms.intern(name.substr(0, colon));
+			qualified.second = (colon == std::string::npos) ? this->names[index] : this->atoms.intern(name.substr(colon + 1));
+		}
+		this->locals[index] = qualified.second;
+		// Unprefixed and not in a default namespace : in none.
+		this->spaces[index] = (qualified.first == none) ? none : XmlAtoms::none;
+		for(uint32_t binding = scope; binding != XmlFlat::npos; binding = bindings[binding].previous)
+		{
+			if (bindings[binding].prefix == qualified.first)
+			{
+				this->spaces[index] = bindings[binding].space;
+				break;
+			}
+		}
+	}
+}
+
+bool XmlFlat::resolved(void) const
+{
+	return !this->spaces.empty();
+}
+
+uint32_t XmlFlat::id(void) const
+{
+	return this->stamp;
+}
+
+uint32_t XmlFlat::firstChild(uint32_t index, uint32_t space, uint32_t local) const
+{
+	if (index == XmlFlat::npos || !this->resolved() || space == XmlAtoms::none || local == XmlAtoms::none)
+	{
+		return XmlFlat::npos;
+	}
+	const uint32_t end = this->ends[index];
+	for(uint32_t child = index + 1; child < end; child = this->ends[child])
+	{
+		if (this->locals[child] == local && this->spaces[child] == space)
+		{
+			return child;
+		}
+	}
+	return XmlFlat::npos;
+}
+
+uint32_t XmlFlat::nextSibling(uint32_t index, uint32_t space, uint32_t local) const
+{
+	if (index == XmlFlat::npos || index == 0 || !this->resolved() || space == XmlAtoms::none || local == XmlAtoms::none)
+	{
+		return XmlFlat::npos;
+	}
+	const uint32_t end = this->ends[this->parents[index]];
+	for(uint32_t sibling = this->ends[index]; sibling < end; sibling = this->ends[sibling])
+	{
+		if (this->locals[sibling] == local && this->spaces[sibling] == space)
+		{
+			return sibling;
+		}
+	}
+	return XmlFlat::npos;
+}
+
+uint32_t XmlFlat::spaceOf(uint32_t index) const
+{
+	return (index == XmlFlat::npos || index >= this->spaces.size()) ? XmlAtoms::none : this->spaces[index];
+}
+
+const std::string& XmlFlat::name(uint32_t atom) const
+{
+	return this->atoms.name(atom);
+}
+
+uint32_t XmlFlat::size(void) const
+{
+	return static_cast<uint32_t>(this->elements.size());
+}
+
+size_t XmlFlat::memory(void) const
+{
+	size_t bytes = sizeof(*this);
+	bytes += this->names.capacity()    * sizeof(uint32_t);
+	bytes += this->ends.capacity()     * sizeof(uint32_t);
+	bytes += this->parents.capacity()  * sizeof(uint32_t);
+	bytes += this->elements.capacity() * sizeof(xml2::XMLElement*);
+	bytes += this->hashes.capacity()   * sizeof(uint64_t);
+	bytes += this->spaces.capacity()   * sizeof(uint32_t);
+	bytes += this->locals.capacity()   * sizeof(uint32_t);
+	for(uint32_t atom = 0; atom < this->atoms.size(); ++atom)
+	{
+		bytes += this->atoms.name(atom).capacity() + sizeof(std::string);
+	}
+	return bytes;
+}
@@ -0,0 +1,200 @@
+/**
+ * @file XmlFlat.hpp
+ * @brief Defines a frozen, read-only and flat copy of the elements of a document.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef XMLFLAT_HPP_INCLUDED
+#define XMLFLAT_HPP_INCLUDED
+
+#include <vector>
+#include <cstdint>
+#include "tinyxml2.h"
+#include "XmlAtoms.hpp"
+#include "XmlPool.hpp"
+
+namespace xml2 = tinyxml2;
+
+
+/**
+ * @brief A namespace and a local name, as atoms of a resolved XmlFlat (see XmlLoader::qname()).
+ * @author MTLCRBN
+ */
+struct XmlQName
+{
+	uint32_t space = XmlAtoms::none; //!< The atom of the namespace URI.
+	uint32_t local = XmlAtoms::none; //!< The atom of the local name.
+	uint32_t table = 0;              //!< The XmlFlat::id() of the table the atoms are from.
+};
+
+
+/**
+ * @brief The elements of a document, as a table of arrays in document order.
+ *
+ * Index 0 is the document itself, every element comes after its parent, and the
+ * descendants of the element \b i are exactly the indexes in [i+1, end(i)).
+ * Walking the children of an element is then a walk over a few contiguous
+ * arrays of 32 bits integers, instead of chasing pointers across the pools.
+ * It costs 20 bytes per element (8 more once hashed, 8 more once resolved),
+ * plus the atoms of the distinct names.
+ *
+ * The document must not be modified while it is frozen : the table keeps its
+ * index in the user data of each element, and points back to them.
+ * @author MTLCRBN
+ */
+class XmlFlat final
+{
+	private:
+		XmlAtoms                        atoms;    //!< The names of the elements.
+		std::vector<uint32_t>           names;    //!< The atom of the name of each element.
+		std::vector<uint32_t>           ends;     //!< One past the last descendant of each element.
+		std::vector<uint32_t>           parents;  //!< The parent of each element.
+		std::vector<xml2::XMLElement*>  elements; //!< The element itself, for its attributes and text.
+		std::vector<uint64_t>           hashes;   //!< The structural hash of each element, once hash() was called.
+		std::vector<uint32_t>           spaces;   //!< The atom of the namespace of each element, once resolve() was called.
+		std::vector<uint32_t>           locals;   //!< The atom of the local name of each element, once resolve() was called.
+		const uint32_t                  stamp;    //!< Tells this table apart from the ones before it.
+
+		/**
+		 * @brief Append \a element, child of \a parent.
+		 * @return Its index.
+		 */
+		uint32_t add(xml2::XMLElement *element, uint32_t parent);
+
+		/**
+		 * @brief Hash the elements in [\a begin, \a end) not \a done yet, the last one first,
+		 * so that the children of an element are hashed before it.
+		 */
+		void hashRange(uint32_t begin, uint32_t end, std::vector<char> &done);
+
+		XmlFlat(void)                            = delete;
+		XmlFlat(const XmlFlat &other)            = delete;
+		XmlFlat& operator=(const XmlFlat &other) = delete;
+
+	public:
+		static const uint32_t npos = 0xFFFFFFFF; //!< The index of nothing.
+
+		/**
+		 * @brief Freeze every element of \a doc.
+		 * @param[in,out] doc The document, its elements user data are overwritten.
+		 * @throw std::string if \a doc has more elements than 32 bits indexes allow.
+		 */
+		explicit XmlFlat(xml2::XMLDocument &doc);
+
+		/**
+		 * @brief Get the index of \a node.
+		 * @return Its index, or \b npos if \a node isn't a frozen element.
+		 */
+		uint32_t indexOf(const xml2::XMLNode *node) const;
+
+		/**
+		 * @brief Get the atom of \a name, an element name or (once resolved) a local name or a namespace URI.
+		 * @return Its atom, or XmlAtoms::none if nothing is named so.
+		 */
+		uint32_t atom(const std::string &name) const;
+
+		/**
+		 * @brief Get the first child of \a index named \a atom.
+		 * @return Its index, or \b npos if there is none.
+		 */
+		uint32_t firstChild(uint32_t index, uint32_t atom) const;
+
+		/**
+		 * @brief Get the next sibling of \a index named \a atom.
+		 * @return Its index, or \b npos if there is none.
+		 */
+		uint32_t nextSibling(uint32_t index, uint32_t atom) const;
+
+		/**
+		 * @brief Get the element at \a index.
+		 * @return The element, or nullptr for \b npos and the document.
+		 */
+		xml2::XMLElement* element(uint32_t index) const;
+
+		/**
+		 * @brief Compute the structural hash of every element, bottom-up.
+		 *
+		 * The hash of an element covers its name, its attributes (in order, as
+		 * XMLElement::ShallowEqual() compares them), its texts and the hashes of
+		 * its children, in order. Comments and declarations are not covered.
+		 * Two subtrees with the same hash are then equal, but for a collision of
+		 * 64 bits hashes : they are meant for comparisons and cache keys, not for security.
+		 * @param[in] pool The threads to hash with, nullptr to hash from this thread only.
+		 * The subtrees of the first level having enough elements to share are spread over it.
+		 */
+		void hash(XmlPool *pool = nullptr);
+
+		/**
+		 * @brief Tell if hash() was called.
+		 */
+		bool hashed(void) const;
+
+		/**
+		 * @brief Get the structural hash of the element at \a index.
+		 * @return Its hash, or 0 for \b npos, the document, or if hash() was not called.
+		 */
+		uint64_t hashOf(uint32_t index) const;
+
+		/**
+		 * @brief Resolve the namespace of every element, from the \b xmlns attributes in scope.
+		 *
+		 * Each element gets the atom of its namespace URI (the one of \b "" if it has
+		 * none) and the atom of its local name, so that qualified names compare as
+		 * two integers, whatever prefix the document binds the namespace to.
+		 * The prefix \b xml is bound to its URI. An element whose prefix is not bound
+		 * gets XmlAtoms::none as namespace, and matches no namespace.
+		 */
+		void resolve(void);
+
+		/**
+		 * @brief Tell if resolve() was called.
+		 */
+		bool resolved(void) const;
+
+		/**
+		 * @brief Get what tells this table apart from the other ones built by the
+		 * process, so that atoms got from another one are not taken for its own.
+		 * @return Its id, never 0.
+		 */
+		uint32_t id(void) const;
+
+		/**
+		 * @brief Get the first child of \a index in the namespace \a space, named \a local.
+		 * @param[in] index The parent.
+		 * @param[in] space The atom of the namespace URI.
+		 * @param[in] local The atom of the local name.
+		 * @return Its index, or \b npos if there is none, or if resolve() was not called.
+		 */
+		uint32_t firstChild(uint32_t index, uint32_t space, uint32_t local) const;
+
+		/**
+		 * @brief Get the next sibling of \a index in the namespace \a space, named \a local.
+		 * @return Its index, or \b npos if there is none, or if resolve() was not called.
+		 */
+		uint32_t nextSibling(uint32_t index, uint32_t space, uint32_t local) const;
+
+		/**
+		 * @brief Get the atom of the namespace URI of the element at \a index.
+		 * @return Its atom, or XmlAtoms::none for \b npos, the document, an unbound prefix,
+		 * or if resolve() was not called.
+		 */
+		uint32_t spaceOf(uint32_t index) const;
+
+		/**
+		 * @brief Get the name of \a atom, a namespace URI or a name.
+		 */
+		const std::string& name(uint32_t atom) const;
+
+		/**
+		 * @brief The number of entries, the document included.
+		 */
+		uint32_t size(void) const;
+
+		/**
+		 * @brief The memory used by the table, in bytes.
+		 */
+		size_t memory(void) const;
+};
+
+#endif
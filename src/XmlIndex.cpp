@@ -0,0 +1,291 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <sys/stat.h>
+
+#include "XmlIndex.hpp"
+#include "XmlProjection.hpp"
+#include "XmlInput.hpp"
+
+
+
+const size_t XmlIndex::npos;
+
+namespace
+{
+	const char     MAGIC[8]    = {'R', 'W', 'X', 'I', 'D', 'X', '1', '\n'}; //!< The first bytes of an index.
+	const size_t   SAMPLE_SIZE = 64*1024; //!< The size of the blocks checksummed.
+	const unsigned SAMPLES     = 16;      //!< The number of blocks checksummed inside the file.
+
+	//! @brief What the file was when the index was built.
+	struct Stamp
+	{
+		uint64_t size;     //!< Its size in bytes.
+		int64_t  mtime;    //!< Its modification time, in seconds.
+		uint64_t checksum; //!< The checksum of some of its blocks.
+	};
+
+	/**
+	 * @brief Print the error and throw it, as XmlLoader does.
+	 */
+	[[noreturn]] void fail(const std::string &fname, const std::string &what, const std::string &error)
+	{
+		std::cerr << "[ERROR]: " << what << " " << fname << std::endl;
+		throw error;
+	}
+
+	/**
+	 * @brief Hash \a size bytes of \a data into \a hash (FNV-1a).
+	 */
+	uint64_t fnv(uint64_t hash, const char *data, size_t size)
+	{
+		for(size_t i = 0; i < size; ++i)
+		{
+			hash ^= static_cast<unsigned char>(data[i]);
+			hash *= 0x100000001B3ULL;
+		}
+		return hash;
+	}
+
+	/**
+	 * @brief Get the stamp of \a fname, whose content is \a data.
+	 * Only the first and last blocks, and SAMPLES blocks in between, are
+	 * checksummed, so that checking a huge file stays cheap.
+	 */
+	Stamp stampOf(const std::string &fname, const char *data, size_t length)
+	{
+		struct stat status;
+		if (stat(fname.c_str(), &status) != 0)
+		{
+			fail(fname, "cannot stat", "File not found");
+		}
+		Stamp stamp;
+		stamp.size     = static_cast<uint64_t>(status.st_size);
+		stamp.mtime    = static_cast<int64_t>(status.st_mtime);
+		stamp.checksum = 0xCBF29CE484222325ULL;
+		if (length <= SAMPLE_SIZE*(SAMPLES + 2))
+		{
+			stamp.checksum = fnv(stamp.checksum, data, length);
+			return stamp;
+		}
+		stamp.checksum = fnv(stamp.checksum, data, SAMPLE_SIZE);
+		for(unsigned i = 1; i <= SAMPLES; ++i)
+		{
+			stamp.checksum = fnv(stamp.checksum, data + (length/(SAMPLES + 1))*i, SAMPLE_SIZE);
+		}
+		stamp.checksum = fnv(stamp.checksum, data + length - SAMPLE_SIZE, SAMPLE_SIZE);
+		return stamp;
+	}
+
+	//! @brief Write \a value as is.
+	template<typename T>
+	void put(std::ostream &out, const T &value)
+	{
+		out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	//! @brief Read \a value as put() wrote it.
+	template<typename T>
+	void get(std::istream &in, T &value)
+	{
+		in.read(reinterpret_cast<char*>(&value), sizeof(T));
+	}
+}
+
+size_t XmlIndex::build(const std::string &fname, const std::string &recordPath, const std::string &keyAttribute)
+{
+	// The records are read here and there.
+	std::unique_ptr<XmlMapping> mapping(new XmlMapping(fname, true));
+	const char  *data   = mapping->data();
+	const size_t length = mapping->size();
+	const Stamp  stamp  = stampOf(fname, data, length);
+
+	// Only the records themselves are created : their content is skipped.
+	XmlProjection projection(std::vector<std::string>(1, recordPath));
+	const int depth = static_cast<int>(projection.depth());
+	xml2::XMLDocument doc;
+	doc.SetParseFilter(&projection);
+	doc.SetLazyDepth(depth);
+	const xml2::XMLError err = doc.Parse(data, length);
+	mapping.reset();
+	if (err != xml2::XML_SUCCESS || depth == 0)
+	{
+		fail(fname, "while indexing", "Bad format");
+	}
+
+	std::vector<std::pair<uint64_t, uint64_t> > ranges;
+	std::vector<std::pair<uint64_t, uint32_t> > keys;
+	std::string blob;
+	int level = 1;
+	const xml2::XMLElement *current = doc.FirstChildElement();
+	while(current != nullptr)
+	{
+		if (level == depth)
+		{
+			ranges.emplace_back(current->SourceBegin(), current->SourceEnd());
+			const char *key = keyAttribute.empty() ? nullptr : current->Attribute(keyAttribute.c_str());
+			const size_t size = (key == nullptr) ? 0 : strlen(key);
+			keys.emplace_back(blob.size(), static_cast<uint32_t>(size));
+			blob.append(key ? key : "", size);
+		}
+		const xml2::XMLElement *next = (level < depth) ? current->FirstChildElement() : nullptr;
+		if (next != nullptr)
+		{
+			++level;
+			current = next;
+			continue;
+		}
+		next = current->NextSiblingElement();
+		while(next == nullptr && level > 1)
+		{
+			--level;
+			current = current->Parent()->ToElement();
+			next    = current->NextSiblingElement();
+		}
+		current = next;
+	}
+
+	// The records with a key, sorted by key, the first one in document order first.
+	std::vector<uint64_t> byKey;
+	for(uint64_t i = 0; i < keys.size(); ++i)
+	{
+		if (keys[i].second > 0)
+		{
+			byKey.push_back(i);
+		}
+	}
+	std::stable_sort(byKey.begin(), byKey.end(), [&](uint64_t a, uint64_t b) {
+		return blob.compare(keys[a].first, keys[a].second, blob, keys[b].first, keys[b].second) < 0;
+	});
+
+	std::ofstream out(XmlIndex::sidecar(fname), std::ios::binary | std::ios::trunc);
+	out.write(MAGIC, sizeof(MAGIC));
+	put(out, stamp.size);
+	put(out, stamp.mtime);
+	put(out, stamp.checksum);
+	put(out, static_cast<uint64_t>(ranges.size()));
+	for(const std::pair<uint64_t, uint64_t> &range : ranges)
+	{
+		put(out, range.first);
+		put(out, range.second);
+	}
+	for(const std::pair<uint64_t, uint32_t> &key : keys)
+	{
+		put(out, key.first);
+		put(out, key.second);
+	}
+	put(out, static_cast<uint64_t>(byKey.size()));
+	for(uint64_t record : byKey)
+	{
+		put(out, record);
+	}
+	put(out, static_cast<uint64_t>(blob.size()));
+	out.write(blob.data(), blob.size());
+	if (!out)
+	{
+		fail(XmlIndex::sidecar(fname), "while writing", "Error while writing " + XmlIndex::sidecar(fname));
+	}
+	return ranges.size();
+}
+
+std::string XmlIndex::sidecar(const std::string &fname)
+{
+	return fname + ".idx";
+}
+
+XmlIndex::XmlIndex(const std::string &fname) : fname(fname)
+{
+	std::ifstream in(XmlIndex::sidecar(fname), std::ios::binary);
+	char magic[sizeof(MAGIC)] = {0};
+	in.read(magic, sizeof(magic));
+	if (!in || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		fail(XmlIndex::sidecar(fname), "no valid index in", "File not found");
+	}
+	Stamp built;
+	get(in, built.size);
+	get(in, built.mtime);
+	get(in, built.checksum);
+	uint64_t count = 0;
+	get(in, count);
+	this->ranges.resize(count);
+	for(std::pair<uint64_t, uint64_t> &range : this->ranges)
+	{
+		get(in, range.first);
+		get(in, range.second);
+	}
+	this->keys.resize(count);
+	for(std::pair<uint64_t, uint32_t> &key : this->keys)
+	{
+		get(in, key.first);
+		get(in, key.second);
+	}
+	get(in, count);
+	this->byKey.resize(count);
+	for(uint64_t &record : this->byKey)
+	{
+		get(in, record);
+	}
+	get(in, count);
+	this->blob.resize(count);
+	in.read(&this->blob[0], count);
+	if (!in)
+	{
+		fail(XmlIndex::sidecar(fname), "truncated index", "Bad format");
+	}
+
+	this->mapping.reset(new XmlMapping(fname, true));
+	const Stamp now = stampOf(fname, this->mapping->data(), this->mapping->size());
+	if (now.size != built.size || now.mtime != built.mtime || now.checksum != built.checksum)
+	{
+		fail(fname, "the index is out of date for", "Stale index");
+	}
+}
+
+XmlIndex::~XmlIndex(void)
+{
+
+}
+
+int XmlIndex::compare(uint64_t a, const char *b, size_t bLength) const
+{
+	return this->blob.compare(this->keys[a].first, this->keys[a].second, b, bLength);
+}
+
+size_t XmlIndex::size(void) const
+{
+	return this->ranges.size();
+}
+
+size_t XmlIndex::find(const std::string &key) const
+{
+	// The first record whose key is not lower than key.
+	std::vector<uint64_t>::const_iterator found = std::lower_bound(this->byKey.begin(), this->byKey.end(), key,
+		[this](uint64_t record, const std::string &k) { return this->compare(record, k.data(), k.size()) < 0; });
+	if (found == this->byKey.end() || this->compare(*found, key.data(), key.size()) != 0)
+	{
+		return XmlIndex::npos;
+	}
+	return static_cast<size_t>(*found);
+}
+
+std::pair<size_t, size_t> XmlIndex::range(size_t record) const
+{
+	if (record >= this->ranges.size())
+	{
+		std::cerr << "[ERROR]: there is no record " << record << " in the index of " << this->fname << std::endl;
+		throw std::string("Bad record");
+	}
+	return std::make_pair(static_cast<size_t>(this->ranges[record].first), static_cast<size_t>(this->ranges[record].second));
+}
+
+const char* XmlIndex::data(void) const
+{
+	return this->mapping->data();
+}
+
+const std::string& XmlIndex::file(void) const
+{
+	return this->fname;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file XmlIndex.hpp
+ * @brief Defines the sidecar index of the records of a xml file.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ *
+ * The index of \b file.xml is written next to it, as \b file.xml.idx, by
+ * XmlIndex::build() or the \b xmlindex tool (see tools/xmlindex.cpp).
+ * It is in the byte order of the machine which built it.
+ */
+#ifndef XMLINDEX_HPP_INCLUDED
+#define XMLINDEX_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <cstdint>
+
+class XmlMapping;
+
+/**
+ * @brief The byte range of each record of a xml file, and of the record
+ * having each key, to parse one record without reading the whole file.
+ *
+ * Opening an index checks that the file did not change since it was built
+ * (its size, its modification time and a checksum of some of its blocks),
+ * then maps the file in memory : XmlLoader(index, record) only parses the
+ * range of \b record.
+ * @author MTLCRBN
+ */
+class XmlIndex final
+{
+	private:
+		std::string                                  fname;   //!< The indexed file.
+		std::vector<std::pair<uint64_t, uint64_t> > ranges;  //!< The [begin, end) of each record.
+		std::vector<std::pair<uint64_t, uint32_t> > keys;    //!< Where the key of each record is in blob.
+		std::vector<uint64_t>                        byKey;   //!< The records with a key, sorted by key.
+		std::string                                  blob;    //!< The keys, one after the other.
+		std::unique_ptr<XmlMapping>                  mapping; //!< The file, mapped in memory.
+
+		/**
+		 * @brief Compare the key of the record \a a with the \a bLength characters of \a b.
+		 */
+		int compare(uint64_t a, const char *b, size_t bLength) const;
+
+		XmlIndex(void)                             = delete;
+		XmlIndex(const XmlIndex &other)            = delete;
+		XmlIndex& operator=(const XmlIndex &other) = delete;
+
+	public:
+		static const size_t npos = static_cast<size_t>(-1); //!< The record of nothing.
+
+		/**
+		 * @brief Scan \a fname once, and write its index next to it.
+		 *
+		 * The records are the elements at \a recordPath, a path from the root as
+		 * XmlOptions::keepPaths, such as \b "catalog/record".
+		 * Their content is skipped, so the scan only allocates the records themselves.
+		 * @param[in] fname        The xml file, which must not be compressed.
+		 * @param[in] recordPath   The path of the records.
+		 * @param[in] keyAttribute The attribute to find the records by, "" for none.
+		 * @throw std::string if \a fname cannot be read or is not well formed.
+		 * @throw std::string if the index cannot be written.
+		 * @return The number of records.
+		 */
+		static size_t build(const std::string &fname, const std::string &recordPath, const std::string &keyAttribute = "");
+
+		/**
+		 * @brief Get the name of the index of \a fname.
+		 */
+		static std::string sidecar(const std::string &fname);
+
+		/**
+		 * @brief Open the index of \a fname, and map \a fname in memory.
+		 * @param[in] fname The indexed xml file.
+		 * @throw std::string if there is no index, or if it is not the one of \a fname as it is now.
+		 */
+		explicit XmlIndex(const std::string &fname);
+
+		//! @brief Unmap the file.
+		~XmlIndex(void);
+
+		/**
+		 * @brief The number of records.
+		 */
+		size_t size(void) const;
+
+		/**
+		 * @brief Find the record whose key attribute is \a key.
+		 * @return Its number, or \b npos if there is none (or if the index has no key).
+		 */
+		size_t find(const std::string &key) const;
+
+		/**
+		 * @brief Get the byte range of \a record in the file.
+		 * @param[in] record Its number, from 0, in document order.
+		 * @throw std::string if there is no such record.
+		 * @return Its [begin, end) offsets.
+		 */
+		std::pair<size_t, size_t> range(size_t record) const;
+
+		/**
+		 * @brief Get the content of the file, mapped in memory.
+		 */
+		const char* data(void) const;
+
+		/**
+		 * @brief Get the name of the indexed file.
+		 */
+		const std::string& file(void) const;
+};
+
+#endif
@@ -0,0 +1,833 @@
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <cstring>
+
+#include "XmlInput.hpp"
+#include "XmlUnicode.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#	define RWXML_WITH_MMAP
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+#ifdef RWXML_WITH_ZLIB
+#	include <zlib.h>
+#endif
+#ifdef RWXML_WITH_ZSTD
+#	include <zstd.h>
+#endif
+
+
+namespace
+{
+	const size_t CHUNK_SIZE = 256*1024;     //!< How many compressed bytes are read at once.
+	const size_t READ_SIZE  = 1024*1024;    //!< How many bytes the reading thread of parse() reads at once.
+	const size_t AHEAD_SIZE = 8*1024*1024;  //!< How far ahead of the reads the system is told to read.
+	const size_t PIPE_SIZE  = 4*1024*1024;  //!< The smallest file parse() reads from another thread.
+
+	/**
+	 * @brief Print the error and throw it, as XmlLoader does.
+	 */
+	[[noreturn]] void fail(const std::string &fname, const std::string &what)
+	{
+		std::cerr << "[ERROR]: while reading " << fname << " : " << what << std::endl;
+		throw std::string("Read error");
+	}
+
+	/**
+	 * @brief Print where \a fname stops being UTF-8, and throw it.
+	 */
+	[[noreturn]] void invalid(const std::string &fname, size_t offset)
+	{
+		std::cerr << "[ERROR]: while reading " << fname << " : invalid UTF-8 at byte " << offset << std::endl;
+		throw std::string("Bad encoding");
+	}
+
+	/**
+	 * @brief The size of \a file, which is left at its beginning.
+	 */
+	size_t fileSize(FILE *file)
+	{
+		fseek(file, 0, SEEK_END);
+		const long size = ftell(file);
+		fseek(file, 0, SEEK_SET);
+		return (size < 0) ? 0 : static_cast<size_t>(size);
+	}
+
+	/**
+	 * @brief An uncompressed file, read as is.
+	 */
+	class PlainInput final : public XmlInput
+	{
+		private:
+			size_t size; //!< The size of the file.
+			size_t done; //!< How many bytes have been read.
+
+		public:
+			PlainInput(FILE *file, const std::string &fname) : XmlInput(file, fname)
+			{
+				this->size = fileSize(file);
+				this->done = 0;
+#ifdef POSIX_FADV_SEQUENTIAL
+				posix_fadvise(fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+			}
+
+			size_t read(char *dst, size_t size) override
+			{
+#ifdef POSIX_FADV_WILLNEED
+				// The next reads are fetched while this one is consumed.
+				posix_fadvise(fileno(this->file), static_cast<off_t>(this->done + size), static_cast<off_t>(AHEAD_SIZE), POSIX_FADV_WILLNEED);
+#endif
+				const size_t got = fread(dst, 1, size, this->file);
+				if (got < size && ferror(this->file))
+				{
+					fail(this->fname, "fread failed");
+				}
+				this->done += got;
+				return got;
+			}
+
+			bool atEnd(void) const override
+			{
+				return this->done >= this->size || feof(this->file);
+			}
+
+			size_t sizeHint(void) const override
+			{
+				return this->size;
+			}
+
+			bool sizeKnown(void) const override
+			{
+				return true;
+			}
+
+			bool verbatim(void) const override
+			{
+				return true;
+			}
+	};
+
+	/**
+	 * @brief A UTF-16 stream, whatever decodes it, transcoded to UTF-8 on the fly.
+	 *
+	 * The UTF-8 characters are written straight where read() is asked to : only
+	 * a chunk of the UTF-16 bytes is kept, never the whole file.
+	 */
+	class Utf16Input final : public XmlInput
+	{
+		private:
+			std::unique_ptr<XmlInput> inner;             //!< What reads the UTF-16 bytes.
+			bool                      bigEndian;         //!< Their byte order.
+			size_t                    bom;               //!< The bytes of the byte order mark still to drop.
+			bool                      first;             //!< If nothing has been written yet.
+			char                      chunk[CHUNK_SIZE]; //!< The UTF-16 bytes read.
+			const char*               begin;             //!< The first byte of chunk not transcoded yet.
+			const char*               end;               //!< The end of the bytes of chunk.
+			char                      spill[4];          //!< A character which did not fit in the last read().
+			size_t                    spillAt;           //!< Its first byte not written yet.
+			size_t                    spillEnd;          //!< Its size.
+
+			//! @brief Read more UTF-16 bytes after the ones not transcoded yet.
+			bool refill(void)
+			{
+				const size_t left = static_cast<size_t>(this->end - this->begin);
+				std::memmove(this->chunk, this->begin, left);
+				const size_t got = this->inner->read(this->chunk + left, CHUNK_SIZE - left);
+				this->begin = this->chunk;
+				this->end   = this->chunk + left + got;
+				const size_t drop = std::min(this->bom, left + got);
+				this->begin += drop;
+				this->bom   -= drop;
+				return got > 0;
+			}
+
+			/**
+			 * @brief The declaration still says UTF-16 : make it say UTF-8,
+			 * in as many characters, for the tools reading the document after TinyXML2.
+			 */
+			static void declare(char *text, size_t size)
+			{
+				const char *close = std::search(text, text + size, "?>", "?>" + 2);
+				if (size < 5 || std::strncmp(text, "<?xml", 5) != 0 || close == text + size)
+				{
+					return;
+				}
+				const char *field = "encoding";
+				char *at = std::search(text, text + (close - text), field, field + 8);
+				if (at == close)
+				{
+					return;
+				}
+				at += 8;
+				while(at < close && (*at == ' ' || *at == '=' || *at == '\t' || *at == '\r' || *at == '\n'))
+				{
+					++at;
+				}
+				if (at == close || (*at != '"' && *at != '\''))
+				{
+					return;
+				}
+				const char quote = *at++;
+				char *value = at;
+				while(at < close && *at != quote)
+				{
+					++at;
+				}
+				const size_t length = static_cast<size_t>(at - value);
+				const char *utf16 = "utf-16";
+				for(size_t i = 0; i < 6; ++i)
+				{
+					if (length < 6 || (value[i] | 0x20) != utf16[i])
+					{
+						return;
+					}
+				}
+				std::memcpy(value, "UTF-8", 5);
+				value[5] = quote;
+				std::memset(value + 6, ' ', length - 5);
+			}
+
+		public:
+			Utf16Input(std::unique_ptr<XmlInput> inner, const std::string &fname, bool bigEndian, size_t bom) :
+				XmlInput(nullptr, fname), inner(std::move(inner)), bigEndian(bigEndian), bom(bom), first(true)
+			{
+				this->begin    = this->chunk;
+				this->end      = this->chunk;
+				this->spillAt  = 0;
+				this->spillEnd = 0;
+			}
+
+			size_t read(char *dst, size_t size) override
+			{
+				size_t written = 0;
+				while(this->spillAt < this->spillEnd && written < size)
+				{
+					dst[written++] = this->spill[this->spillAt++];
+				}
+				while(written < size)
+				{
+					if (this->end - this->begin < 4 && !this->refill() && this->begin == this->end)
+					{
+						break;
+					}
+					const char *from = this->begin;
+					char *out = dst + written;
+					if (!XmlUnicode::utf16ToUtf8(this->begin, this->end, out, dst + size, this->bigEndian))
+					{
+						fail(this->fname, "unpaired UTF-16 surrogate");
+					}
+					written = static_cast<size_t>(out - dst);
+					if (this->begin != from)
+					{
+						continue;
+					}
+					// Either the next character does not fit, or it is not complete.
+					char *cut = this->spill;
+					XmlUnicode::utf16ToUtf8(this->begin, this->end, cut, this->spill + 4, this->bigEndian);
+					this->spillEnd = static_cast<size_t>(cut - this->spill);
+					this->spillAt  = 0;
+					if (this->spillEnd > 0)
+					{
+						while(this->spillAt < this->spillEnd && written < size)
+						{
+							dst[written++] = this->spill[this->spillAt++];
+						}
+					}
+					else if (this->inner->atEnd() && !this->refill())
+					{
+						fail(this->fname, "truncated UTF-16 stream");
+					}
+				}
+				if (this->first && written > 0)
+				{
+					this->first = false;
+					declare(dst, written);
+				}
+				return written;
+			}
+
+			bool atEnd(void) const override
+			{
+				return this->spillAt == this->spillEnd && this->begin == this->end && this->inner->atEnd();
+			}
+
+			size_t sizeHint(void) const override
+			{
+				// Exact for ASCII and 2 bytes UTF-8 characters, the buffer grows for the others.
+				return this->inner->sizeHint();
+			}
+
+			bool compressed(void) const override
+			{
+				return this->inner->compressed();
+			}
+	};
+
+	/**
+	 * @brief A stream whose first bytes were already read, to tell its encoding :
+	 * they are given back before the rest, so that it is decoded only once.
+	 */
+	class ReplayInput final : public XmlInput
+	{
+		private:
+			std::unique_ptr<XmlInput> inner;   //!< The stream.
+			unsigned char             head[4]; //!< Its first bytes, already read.
+			size_t                    at;      //!< The first one not given back yet.
+			size_t                    count;   //!< Their number.
+
+		public:
+			ReplayInput(std::unique_ptr<XmlInput> inner, const std::string &fname, const unsigned char head[4], size_t count) :
+				XmlInput(nullptr, fname), inner(std::move(inner)), at(0), count(count)
+			{
+				std::memcpy(this->head, head, 4);
+			}
+
+			size_t read(char *dst, size_t size) override
+			{
+				size_t written = 0;
+				while(this->at < this->count && written < size)
+				{
+					dst[written++] = static_cast<char>(this->head[this->at++]);
+				}
+				if (written < size)
+				{
+					written += this->inner->read(dst + written, size - written);
+				}
+				return written;
+			}
+
+			bool atEnd(void) const override
+			{
+				return this->at == this->count && this->inner->atEnd();
+			}
+
+			size_t sizeHint(void) const override
+			{
+				return this->inner->sizeHint();
+			}
+
+			bool sizeKnown(void) const override
+			{
+				return this->inner->sizeKnown();
+			}
+
+			bool compressed(void) const override
+			{
+				return this->inner->compressed();
+			}
+
+			bool verbatim(void) const override
+			{
+				return this->inner->verbatim();
+			}
+	};
+
+	/**
+	 * @brief How much of the buffer the reading thread of XmlInput::parse() wrote.
+	 */
+	class Feed final : public xml2::XMLParseFeed
+	{
+		private:
+			std::mutex              lock;      //!< Protects every field below.
+			std::condition_variable written;   //!< Signals a new ready offset.
+			size_t                  ready;     //!< The offset the buffer is complete up to.
+			size_t                  size;      //!< The size of the buffer.
+			bool                    cancelled; //!< If the parse ended without needing the rest.
+
+		public:
+			explicit Feed(size_t size) : ready(0), size(size), cancelled(false)
+			{
+
+			}
+
+			size_t Ready(size_t after) override
+			{
+				std::unique_lock<std::mutex> guard(this->lock);
+				this->written.wait(guard, [&]() { return this->ready > after || this->ready >= this->size; });
+				return this->ready;
+			}
+
+			//! @brief Tell the parser the buffer is complete up to \a ready.
+			void publish(size_t ready)
+			{
+				std::lock_guard<std::mutex> guard(this->lock);
+				this->ready = ready;
+				this->written.notify_all();
+			}
+
+			//! @brief Tell the reading thread to stop.
+			void cancel(void)
+			{
+				std::lock_guard<std::mutex> guard(this->lock);
+				this->cancelled = true;
+			}
+
+			//! @brief Tell if the reading thread has to stop.
+			bool stopped(void)
+			{
+				std::lock_guard<std::mutex> guard(this->lock);
+				return this->cancelled;
+			}
+	};
+
+#ifdef RWXML_WITH_ZLIB
+	/**
+	 * @brief A gzip file (possibly made of several members), inflated on the fly.
+	 */
+	class GzipInput final : public XmlInput
+	{
+		private:
+			z_stream      stream;              //!< The zlib state.
+			unsigned char chunk[CHUNK_SIZE];   //!< The compressed bytes not consumed yet.
+			bool          finished;            //!< If the last member has been inflated.
+			size_t        hint;                //!< The size stored in the gzip trailer.
+
+			//! @brief Refill the compressed chunk if it is empty.
+			void refill(void)
+			{
+				if (this->stream.avail_in == 0 && !feof(this->file))
+				{
+					this->stream.next_in  = this->chunk;
+					this->stream.avail_in = static_cast<uInt>(fread(this->chunk, 1, CHUNK_SIZE, this->file));
+					if (ferror(this->file))
+					{
+						fail(this->fname, "fread failed");
+					}
+				}
+			}
+
+		public:
+			GzipInput(FILE *file, const std::string &fname) : XmlInput(file, fname)
+			{
+				// The trailer holds the decompressed size of the last member, modulo 2^32.
+				const size_t compressed = fileSize(file);
+				unsigned char trailer[4] = {0, 0, 0, 0};
+				this->hint = compressed*4;
+				if (compressed > 4 && fseek(file, -4, SEEK_END) == 0 && fread(trailer, 1, 4, file) == 4)
+				{
+					const size_t isize = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | (size_t(trailer[3]) << 24);
+					if (isize >= compressed)
+					{
+						this->hint = isize;
+					}
+				}
+				fseek(file, 0, SEEK_SET);
+
+				std::memset(&this->stream, 0, sizeof(this->stream));
+				if (inflateInit2(&this->stream, 15 + 16) != Z_OK)
+				{
+					fail(fname, "inflateInit2 failed");
+				}
+				this->finished = false;
+			}
+
+			~GzipInput(void)
+			{
+				inflateEnd(&this->stream);
+			}
+
+			size_t read(char *dst, size_t size) override
+			{
+				this->stream.next_out  = reinterpret_cast<Bytef*>(dst);
+				this->stream.avail_out = static_cast<uInt>(size);
+				while(this->stream.avail_out > 0 && !this->finished)
+				{
+					this->refill();
+					if (this->stream.avail_in == 0)
+					{
+						fail(this->fname, "truncated gzip stream");
+					}
+					const int err = inflate(&this->stream, Z_NO_FLUSH);
+					if (err == Z_STREAM_END)
+					{
+						// Another member may follow.
+						this->refill();
+						if (this->stream.avail_in == 0)
+						{
+							this->finished = true;
+						}
+						else
+						{
+							inflateReset(&this->stream);
+						}
+					}
+					else if (err != Z_OK && err != Z_BUF_ERROR)
+					{
+						fail(this->fname, this->stream.msg ? this->stream.msg : "corrupted gzip stream");
+					}
+				}
+				return size - this->stream.avail_out;
+			}
+
+			bool atEnd(void) const override
+			{
+				return this->finished;
+			}
+
+			size_t sizeHint(void) const override
+			{
+				return this->hint;
+			}
+
+			bool compressed(void) const override
+			{
+				return true;
+			}
+	};
+#endif
+
+#ifdef RWXML_WITH_ZSTD
+	/**
+	 * @brief A zstd file (possibly made of several frames), decompressed on the fly.
+	 */
+	class ZstdInput final : public XmlInput
+	{
+		private:
+			ZSTD_DStream* stream;            //!< The zstd state.
+			char          chunk[CHUNK_SIZE]; //!< The compressed bytes.
+			ZSTD_inBuffer in;                //!< The part of chunk not consumed yet.
+			size_t        pending;           //!< Last ZSTD_decompressStream result, 0 between frames.
+			size_t        hint;              //!< The size declared by the first frame.
+
+			//! @brief Refill the compressed chunk if it is empty.
+			void refill(void)
+			{
+				if (this->in.pos == this->in.size && !feof(this->file))
+				{
+					this->in.src  = this->chunk;
+					this->in.pos  = 0;
+					this->in.size = fread(this->chunk, 1, CHUNK_SIZE, this->file);
+					if (ferror(this->file))
+					{
+						fail(this->fname, "fread failed");
+					}
+				}
+			}
+
+		public:
+			ZstdInput(FILE *file, const std::string &fname) : XmlInput(file, fname)
+			{
+				const size_t compressed = fileSize(file);
+				this->stream = ZSTD_createDStream();
+				if (this->stream == nullptr)
+				{
+					fail(fname, "ZSTD_createDStream failed");
+				}
+				ZSTD_initDStream(this->stream);
+				this->in.src  = this->chunk;
+				this->in.pos  = 0;
+				this->in.size = 0;
+				this->pending = 0;
+				this->refill();
+				const unsigned long long declared = ZSTD_getFrameContentSize(this->chunk, this->in.size);
+				const bool known = declared != ZSTD_CONTENTSIZE_UNKNOWN && declared != ZSTD_CONTENTSIZE_ERROR;
+				this->hint = known ? static_cast<size_t>(declared) : compressed*4;
+			}
+
+			~ZstdInput(void)
+			{
+				ZSTD_freeDStream(this->stream);
+			}
+
+			size_t read(char *dst, size_t size) override
+			{
+				ZSTD_outBuffer out = {dst, size, 0};
+				while(out.pos < out.size)
+				{
+					this->refill();
+					if (this->in.pos == this->in.size && this->pending == 0)
+					{
+						break;
+					}
+					if (this->in.pos == this->in.size)
+					{
+						fail(this->fname, "truncated zstd stream");
+					}
+					this->pending = ZSTD_decompressStream(this->stream, &out, &this->in);
+					if (ZSTD_isError(this->pending))
+					{
+						fail(this->fname, ZSTD_getErrorName(this->pending));
+					}
+				}
+				return out.pos;
+			}
+
+			bool atEnd(void) const override
+			{
+				return this->pending == 0 && this->in.pos == this->in.size && feof(this->file);
+			}
+
+			size_t sizeHint(void) const override
+			{
+				return this->hint;
+			}
+
+			bool compressed(void) const override
+			{
+				return true;
+			}
+	};
+#endif
+}
+
+
+XmlInput::XmlInput(FILE *file, const std::string &fname) : file(file), fname(fname)
+{
+
+}
+
+XmlInput::~XmlInput(void)
+{
+	if (this->file != nullptr)
+	{
+		fclose(this->file);
+	}
+}
+
+std::unique_ptr<XmlInput> XmlInput::decoder(const std::string &fname, unsigned char magic[4], size_t &got)
+{
+	FILE *file = fopen(fname.c_str(), "rb");
+	if (file == nullptr)
+	{
+		std::cerr << "[ERROR]: while loading " << fname << std::endl;
+		throw std::string("File not found");
+	}
+	got = fread(magic, 1, 4, file);
+	fseek(file, 0, SEEK_SET);
+
+	if (got >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+	{
+#ifdef RWXML_WITH_ZLIB
+		return std::unique_ptr<XmlInput>(new GzipInput(file, fname));
+#else
+		fclose(file);
+		fail(fname, "gzip input, rebuild with RWXML_WITH_ZLIB");
+#endif
+	}
+	if (got == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd)
+	{
+#ifdef RWXML_WITH_ZSTD
+		return std::unique_ptr<XmlInput>(new ZstdInput(file, fname));
+#else
+		fclose(file);
+		fail(fname, "zstd input, rebuild with RWXML_WITH_ZSTD");
+#endif
+	}
+	return std::unique_ptr<XmlInput>(new PlainInput(file, fname));
+}
+
+std::unique_ptr<XmlInput> XmlInput::open(const std::string &fname)
+{
+	unsigned char magic[4] = {0, 0, 0, 0};
+	size_t got = 0;
+	std::unique_ptr<XmlInput> input = XmlInput::decoder(fname, magic, got);
+	if (input->sizeKnown() == false)
+	{
+		// Compressed (only plain files know their size) : the encoding is told
+		// by the first decoded bytes, given back to the reads that follow.
+		got = 0;
+		size_t last = 1;
+		while(got < 4 && last > 0)
+		{
+			last = input->read(reinterpret_cast<char*>(magic) + got, 4 - got);
+			got += last;
+		}
+		input.reset(new ReplayInput(std::move(input), fname, magic, got));
+	}
+	size_t bom = 0;
+	const XmlUnicode::Encoding encoding = XmlUnicode::detect(magic, got, bom);
+	if (encoding == XmlUnicode::UTF8)
+	{
+		return input;
+	}
+	return std::unique_ptr<XmlInput>(new Utf16Input(std::move(input), fname, encoding == XmlUnicode::UTF16BE, bom));
+}
+
+size_t XmlInput::fill(xml2::XMLDocument &doc)
+{
+	doc.Clear();
+	size_t capacity = this->sizeHint();
+	size_t length   = 0;
+	char  *buffer   = doc.ReserveBuffer(capacity);
+	while(true)
+	{
+		if (length == capacity)
+		{
+			if (this->atEnd())
+			{
+				break;
+			}
+			capacity = (capacity < CHUNK_SIZE) ? CHUNK_SIZE : capacity*2;
+			buffer   = doc.ReserveBuffer(capacity, length);
+		}
+		const size_t got = this->read(buffer + length, capacity - length);
+		if (got == 0)
+		{
+			break;
+		}
+		length += got;
+	}
+	return length;
+}
+
+bool XmlInput::sizeKnown(void) const
+{
+	return false;
+}
+
+bool XmlInput::compressed(void) const
+{
+	return false;
+}
+
+bool XmlInput::verbatim(void) const
+{
+	return false;
+}
+
+xml2::XMLError XmlInput::parse(xml2::XMLDocument &doc, bool validate)
+{
+	const size_t size = this->sizeHint();
+	if (!this->sizeKnown() || size < PIPE_SIZE)
+	{
+		const size_t length = this->fill(doc);
+		const size_t valid  = validate ? XmlUnicode::validUtf8(doc.ReserveBuffer(length, length), length) : length;
+		if (valid < length)
+		{
+			invalid(this->fname, valid);
+		}
+		return doc.ParseBuffer(length);
+	}
+	doc.Clear();
+	char *buffer = doc.ReserveBuffer(size);
+	Feed feed(size);
+	std::exception_ptr error;
+	std::thread reader([&]() {
+		size_t length  = 0;
+		size_t checked = 0;
+		try
+		{
+			while(length < size && !feed.stopped())
+			{
+				const size_t got = this->read(buffer + length, std::min(READ_SIZE, size - length));
+				if (got == 0)
+				{
+					break;
+				}
+				// Everything before the last '<' read is complete.
+				size_t last = length + got;
+				while(last > length && buffer[last - 1] != '<')
+				{
+					--last;
+				}
+				length += got;
+				if (validate)
+				{
+					// Only a character cut by the end of the chunk is left to check.
+					checked += XmlUnicode::validUtf8(buffer + checked, length - checked);
+					if (length - checked >= 4)
+					{
+						invalid(this->fname, checked);
+					}
+				}
+				if (last > length - got)
+				{
+					feed.publish(last - 1);
+				}
+			}
+			if (validate && checked < length)
+			{
+				invalid(this->fname, checked);
+			}
+		}
+		catch(...)
+		{
+			error = std::current_exception();
+		}
+		// A file cut short ends where it was cut.
+		std::memset(buffer + length, 0, size - length);
+		feed.publish(size);
+	});
+	doc.SetParseFeed(&feed);
+	const xml2::XMLError err = doc.ParseBuffer(size);
+	doc.SetParseFeed(nullptr);
+	feed.cancel();
+	reader.join();
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+	return err;
+}
+
+XmlMapping::XmlMapping(const std::string &fname, bool random) : mapped(nullptr), length(0)
+{
+#ifdef RWXML_WITH_MMAP
+	const int fd = ::open(fname.c_str(), O_RDONLY);
+	struct stat status;
+	if (fd < 0 || fstat(fd, &status) != 0)
+	{
+		if (fd >= 0)
+		{
+			::close(fd);
+		}
+		std::cerr << "[ERROR]: while loading " << fname << std::endl;
+		throw std::string("File not found");
+	}
+	this->length = static_cast<size_t>(status.st_size);
+	if (this->length > 0)
+	{
+		void *data = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED)
+		{
+			madvise(data, this->length, random ? MADV_RANDOM : MADV_SEQUENTIAL);
+			::close(fd);
+			this->mapped = static_cast<const char*>(data);
+			return;
+		}
+	}
+	::close(fd);
+#else
+	(void)random;
+#endif
+	std::ifstream in(fname, std::ios::binary);
+	if (!in)
+	{
+		std::cerr << "[ERROR]: while loading " << fname << std::endl;
+		throw std::string("File not found");
+	}
+	this->content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	this->length = this->content.size();
+	this->mapped = this->content.data();
+}
+
+XmlMapping::~XmlMapping(void)
+{
+#ifdef RWXML_WITH_MMAP
+	if (this->mapped != nullptr && this->mapped != this->content.data())
+	{
+		munmap(const_cast<char*>(this->mapped), this->length);
+	}
+#endif
+}
+
+const char* XmlMapping::data(void) const
+{
+	return this->mapped;
+}
+
+size_t XmlMapping::size(void) const
+{
+	return this->length;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file XmlInput.hpp
+ * @brief Defines the input filters XmlLoader reads its files through.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ *
+ * Compressed inputs are recognized by their magic bytes, whatever the file name.
+ * Their support has to be enabled at compile time, as it needs an external library :
+ *    - gzip : define \b RWXML_WITH_ZLIB and link with \b -lz
+ *    - zstd : define \b RWXML_WITH_ZSTD and link with \b -lzstd
+ *
+ * UTF-16 inputs, recognized by their byte order mark or their declaration,
+ * are transcoded to UTF-8 while they are read (see XmlUnicode).
+ */
+#ifndef XMLINPUT_HPP_INCLUDED
+#define XMLINPUT_HPP_INCLUDED
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstdio>
+#include "tinyxml2.h"
+
+namespace xml2 = tinyxml2;
+
+
+/**
+ * @brief A stream of xml characters, read from a file and decoded on the fly.
+ * @author MTLCRBN
+ */
+class XmlInput
+{
+	protected:
+		FILE*       file;  //!< The file to read from.
+		std::string fname; //!< The name of this file, for the error messages.
+
+		/**
+		 * @brief Take the ownership of \a file, already opened on \a fname.
+		 * @param[in] file  The opened file, in binary mode, or nullptr for a filter reading another XmlInput.
+		 * @param[in] fname Its name.
+		 */
+		XmlInput(FILE *file, const std::string &fname);
+
+		/**
+		 * @brief Open \a fname, and choose the filter to decompress it with, from its first bytes.
+		 * @param[in]  fname The file to open.
+		 * @param[out] magic Its first bytes, as they are in the file.
+		 * @param[out] got   How many there are.
+		 * @throw std::string if \a fname cannot be opened, or is compressed with a format this build doesn't support.
+		 */
+		static std::unique_ptr<XmlInput> decoder(const std::string &fname, unsigned char magic[4], size_t &got);
+
+		XmlInput(void)                             = delete;
+		XmlInput(const XmlInput &other)            = delete;
+		XmlInput& operator=(const XmlInput &other) = delete;
+
+	public:
+		/**
+		 * @brief Open \a fname, and choose the filters to decode it with, from its first bytes :
+		 * the decompression, then the transcoding to UTF-8 if it is UTF-16.
+		 * @param[in] fname The file to open.
+		 * @throw std::string if \a fname cannot be opened.
+		 * @throw std::string if \a fname is compressed with a format this build doesn't support.
+		 * @return The input, ready to read.
+		 */
+		static std::unique_ptr<XmlInput> open(const std::string &fname);
+
+		//! @brief Close the file.
+		virtual ~XmlInput(void);
+
+		/**
+		 * @brief Read at most \a size decoded characters into \a dst.
+		 * @param[out] dst  Where to write.
+		 * @param[in]  size The room available in \a dst.
+		 * @throw std::string if the file is corrupted or cannot be read.
+		 * @return The number of characters written, 0 once everything has been read.
+		 */
+		virtual size_t read(char *dst, size_t size) = 0;
+
+		/**
+		 * @brief Tell if everything has been read, without reading anything.
+		 * @return true if the next read() will return 0.
+		 */
+		virtual bool atEnd(void) const = 0;
+
+		/**
+		 * @brief An estimation of the decoded size, to size the buffer at once.
+		 * @return The decoded size if it is known, a guess otherwise.
+		 */
+		virtual size_t sizeHint(void) const = 0;
+
+		/**
+		 * @brief Tell if sizeHint() is the exact decoded size.
+		 */
+		virtual bool sizeKnown(void) const;
+
+		/**
+		 * @brief Tell if the file is compressed (whatever its encoding).
+		 */
+		virtual bool compressed(void) const;
+
+		/**
+		 * @brief Tell if the characters read are the bytes of the file, as they are :
+		 * neither decompressed nor transcoded.
+		 */
+		virtual bool verbatim(void) const;
+
+		/**
+		 * @brief Read everything straight into the character buffer of \a doc,
+		 * growing it as needed, without parsing it.
+		 * @param[in,out] doc The document to fill, it is cleared first.
+		 * @throw std::string if the file is corrupted or cannot be read.
+		 * @return The number of characters written in the buffer of \a doc.
+		 */
+		size_t fill(xml2::XMLDocument &doc);
+
+		/**
+		 * @brief Read everything into the character buffer of \a doc, and parse it.
+		 *
+		 * When the size is known and big enough, the buffer is filled by another
+		 * thread, by large chunks, while the parser reads what is already there
+		 * (see xml2::XMLParseFeed) : on a cold cache, the load takes about the
+		 * longest of the read and the parse, instead of their sum.
+		 * @param[in,out] doc      The document to parse into, it is cleared first.
+		 * @param[in]      validate true to check that the characters are UTF-8 (see XmlUnicode::validUtf8()),
+		 *                          as they are read : by the reading thread, or before the parse.
+		 * @throw std::string if the file is corrupted or cannot be read.
+		 * @throw std::string if \a validate and the file is not UTF-8, the offset of the
+		 *                    first invalid byte being printed.
+		 * @return The result of the parse.
+		 */
+		xml2::XMLError parse(xml2::XMLDocument &doc, bool validate = false);
+};
+
+/**
+ * @brief A file mapped in memory, read only, as it is on the disk : its pages
+ * are the ones the system caches, nothing is copied. Where it cannot be
+ * mapped, it is read into memory instead.
+ * @author MTLCRBN
+ */
+class XmlMapping final
+{
+	private:
+		const char*       mapped;  //!< The file, mapped in memory.
+		size_t            length;  //!< The size of mapped.
+		std::vector<char> content; //!< The file, where it cannot be mapped.
+
+		XmlMapping(void)                               = delete;
+		XmlMapping(const XmlMapping &other)            = delete;
+		XmlMapping& operator=(const XmlMapping &other) = delete;
+
+	public:
+		/**
+		 * @brief Map \a fname in memory.
+		 * @param[in] fname  The file to map.
+		 * @param[in] random true if it is read here and there, false if it is read from start to end.
+		 * @throw std::string if \a fname cannot be opened.
+		 */
+		explicit XmlMapping(const std::string &fname, bool random = false);
+
+		//! @brief Unmap the file.
+		~XmlMapping(void);
+
+		/**
+		 * @brief Get the content of the file.
+		 */
+		const char* data(void) const;
+
+		/**
+		 * @brief Get the size of the file.
+		 */
+		size_t size(void) const;
+};
+
+#endif
@@ -1,23 +1,330 @@
+#include <cstring>
+
 #include "XmlLoader.hpp"
+#include "XmlInput.hpp"
+#include "XmlUnicode.hpp"
+#include "XmlSchema.hpp"
+
+#if defined(__GLIBC__)
+#	include <malloc.h>
+#endif
+
+
+XmlLoader::XmlLoader(const std::string &fname) : XmlLoader(fname, XmlOptions())
+{
+
+}
+
+XmlLoader::XmlLoader(const std::string &fname, const XmlOptions &options) : _XmlBase(), options(options)
+{
+	this->configure();
+	this->reload(fname);
+}
 
+XmlLoader::XmlLoader(const XmlIndex &index, size_t record, const XmlOptions &options) : _XmlBase(), options(options)
+{
+	this->configure();
+	this->reload(index, record);
+}
 
-XmlLoader::XmlLoader(const std::string &fname) : _XmlBase()
+void XmlLoader::configure(void)
 {
-	xml2::XMLError err = this->doc.LoadFile(fname.c_str());
+	this->sequential = false;
+	this->lastMatch  = nullptr;
+	if (!this->options.keepPaths.empty() && this->options.schema != nullptr)
+	{
+		std::cerr << "[ERROR]: a schema cannot check a document loaded with keepPaths" << std::endl;
+		throw std::string("Bad options");
+	}
+	if (!this->options.keepPaths.empty())
+	{
+		this->projection.reset(new XmlProjection(this->options.keepPaths));
+	}
+	this->doc.SetRetainMemory(true);
+	this->doc.SetHugePages(this->options.hugePages);
+	this->doc.SetParseFilter(this->projection.get());
+	this->doc.SetLazyDepth(static_cast<int>(this->options.lazyDepth));
+	this->doc.SetTrackLines(this->options.lineNumbers || this->options.schema != nullptr);
+	this->doc.SetProcessEntities(this->options.processEntities);
+	this->doc.SetWhitespaceMode(this->options.collapseWhitespace ? xml2::COLLAPSE_WHITESPACE : xml2::PRESERVE_WHITESPACE);
+}
+
+XmlLoader& XmlLoader::reload(const std::string &fname)
+{
+	if (this->options.streaming)
+	{
+		this->stream.reset(new XmlStream(fname));
+		this->loadRecord(nullptr, 0);
+		return *this;
+	}
+	std::unique_ptr<XmlInput> input = XmlInput::open(fname);
+	this->prepare();
+	xml2::XMLError err = input->parse(this->doc, this->options.validateUtf8);
 	if (err != xml2::XML_SUCCESS)
 	{
 		std::cerr << "[ERROR]: while loading " << fname << std::endl;
 		throw std::string("File not found");
 	}
+	this->bindRoot();
+	this->conform(fname);
+	return *this;
+}
+
+XmlLoader& XmlLoader::reload(const char *buffer, size_t size)
+{
+	this->stream.reset();
+	this->validate(buffer, size, "a buffer");
+	this->prepare();
+	xml2::XMLError err = this->doc.Parse(buffer, size);
+	if (err != xml2::XML_SUCCESS)
+	{
+		std::cerr << "[ERROR]: while parsing a buffer of " << size << " bytes" << std::endl;
+		throw std::string("Bad format");
+	}
+	this->bindRoot();
+	this->conform("a buffer");
+	return *this;
+}
+
+XmlLoader& XmlLoader::reload(const XmlIndex &index, size_t record)
+{
+	const std::pair<size_t, size_t> range = index.range(record);
+	return this->reload(index.data() + range.first, range.second - range.first);
+}
+
+void XmlLoader::validate(const char *text, size_t size, const std::string &what) const
+{
+	if (!this->options.validateUtf8)
+	{
+		return;
+	}
+	const size_t valid = XmlUnicode::validUtf8(text, size);
+	if (valid < size)
+	{
+		std::cerr << "[ERROR]: while parsing " << what << " : invalid UTF-8 at byte " << valid << std::endl;
+		throw std::string("Bad encoding");
+	}
+}
+
+void XmlLoader::loadRecord(const char *record, size_t size)
+{
+	const std::string &head = this->stream->root();
+	const std::string &tail = this->stream->rootEnd();
+	const size_t total = head.size() + size + tail.size();
+	this->doc.Clear();
+	char *buffer = this->doc.ReserveBuffer(total);
+	memcpy(buffer, head.data(), head.size());
+	if (size > 0)
+	{
+		memcpy(buffer + head.size(), record, size);
+	}
+	memcpy(buffer + head.size() + size, tail.data(), tail.size());
+	this->validate(buffer, total, "a record under its root");
+	this->prepare();
+	if (this->doc.ParseBuffer(total) != xml2::XML_SUCCESS)
+	{
+		std::cerr << "[ERROR]: while parsing a record of " << size << " bytes" << std::endl;
+		throw std::string("Bad format");
+	}
+	this->bindRoot();
+	this->conform("a record");
+}
+
+void XmlLoader::conform(const std::string &what)
+{
+	if (this->options.schema == nullptr)
+	{
+		return;
+	}
+	std::string error;
+	bool valid = false;
+	if (this->stream != nullptr)
+	{
+		valid = this->options.schema->validateRecord(this->doc.RootElement(), error);
+	}
+	else
+	{
+		this->expandAll(&this->doc);
+		valid = this->options.schema->validate(this->doc.RootElement(), error);
+	}
+	if (!valid)
+	{
+		std::cerr << "[ERROR]: while validating " << what << " : " << error << std::endl;
+		throw std::string("Invalid document");
+	}
+}
+
+void XmlLoader::streamNodeNamed(const std::string &name, std::function<void(void)> lambda)
+{
+	this->stream->rewind();
+	const char *record = nullptr;
+	size_t size = 0;
+	while(this->stream->next(name, record, size))
+	{
+		this->loadRecord(record, size);
+		this->node(name);
+		lambda();
+	}
+	this->loadRecord(nullptr, 0);
+}
+
+void XmlLoader::prepare(void)
+{
+	if (this->projection != nullptr)
+	{
+		this->projection->reset();
+	}
+}
+
+void XmlLoader::bindRoot(void)
+{
 	this->root = doc.FirstChild();
 	if (root == nullptr)
 	{
 		std::cerr << "[ERROR]: First element does not exist" << std::endl;
 		throw std::string("Bad format");
 	}
-	this->currentNode    = this->root;
-	this->currentElement = nullptr;
-	this->onNode         = true;
+	this->flat.reset();
+	this->_gotoRoot();
+	this->onNode    = true;
+	this->lastMatch = nullptr;
+}
+
+XmlLoader& XmlLoader::freeze(void)
+{
+	this->expandAll(&this->doc);
+	this->flat.reset(new XmlFlat(this->doc));
+	return *this;
+}
+
+bool XmlLoader::frozen(void) const
+{
+	return this->flat != nullptr;
+}
+
+XmlLoader& XmlLoader::compact(void)
+{
+	this->expandAll(&this->doc);
+	if (!this->doc.Compact())
+	{
+		std::cerr << "[WARNING] : The document has nodes out of its tree, it is not compacted" << std::endl;
+		return *this;
+	}
+	this->bindRoot();
+#if defined(__GLIBC__)
+	// The blocks freed lie below the new ones : the allocator keeps them otherwise.
+	malloc_trim(0);
+#endif
+	return *this;
+}
+
+XmlLoader& XmlLoader::hashAll(unsigned threads)
+{
+	if (this->flat == nullptr)
+	{
+		this->freeze();
+	}
+	if (this->flat->hashed())
+	{
+		return *this;
+	}
+	this->flat->hash((threads == 1) ? nullptr : &this->threads(threads));
+	return *this;
+}
+
+uint64_t XmlLoader::hash(void) const
+{
+	return this->hash(XmlCursor(this->selected()));
+}
+
+uint64_t XmlLoader::hash(const XmlCursor &cursor) const
+{
+	if (this->flat == nullptr || !cursor.valid())
+	{
+		return 0;
+	}
+	return this->flat->hashOf(this->flat->indexOf(cursor.get()));
+}
+
+xml2::XMLElement* XmlLoader::firstChild(xml2::XMLNode *from, const std::string &name) const
+{
+	if (this->flat == nullptr)
+	{
+		this->expand(from->ToElement());
+		return from->FirstChildElement(name.c_str());
+	}
+	return this->flat->element(this->flat->firstChild(this->flat->indexOf(from), this->flat->atom(name)));
+}
+
+xml2::XMLElement* XmlLoader::nextSibling(xml2::XMLNode *from, const std::string &name) const
+{
+	if (this->flat == nullptr)
+	{
+		return from->NextSiblingElement(name.c_str());
+	}
+	return this->flat->element(this->flat->nextSibling(this->flat->indexOf(from), this->flat->atom(name)));
+}
+
+xml2::XMLElement* XmlLoader::firstChild(xml2::XMLNode *from, const XmlQName &name) const
+{
+	if (this->flat == nullptr || name.table != this->flat->id())
+	{
+		return nullptr;
+	}
+	return this->flat->element(this->flat->firstChild(this->flat->indexOf(from), name.space, name.local));
+}
+
+xml2::XMLElement* XmlLoader::nextSibling(xml2::XMLNode *from, const XmlQName &name) const
+{
+	if (this->flat == nullptr || name.table != this->flat->id())
+	{
+		return nullptr;
+	}
+	return this->flat->element(this->flat->nextSibling(this->flat->indexOf(from), name.space, name.local));
+}
+
+std::string XmlLoader::print(const XmlQName &name) const
+{
+	if (this->flat == nullptr || name.table != this->flat->id() || name.space == XmlAtoms::none || name.local == XmlAtoms::none)
+	{
+		return "{?}?";
+	}
+	return "{" + this->flat->name(name.space) + "}" + this->flat->name(name.local);
+}
+
+xml2::XMLElement* XmlLoader::expand(xml2::XMLElement *element, bool all) const
+{
+	if (element != nullptr && element->Unexpanded() && element->Expand(all) != xml2::XML_SUCCESS)
+	{
+		std::cerr << "[ERROR]: while parsing the content of <" << element->Name() << ">" << std::endl;
+		throw std::string("Bad format");
+	}
+	return element;
+}
+
+void XmlLoader::expandAll(xml2::XMLNode *top) const
+{
+	if (this->doc.LazyDepth() == 0)
+	{
+		return;
+	}
+	this->expand(top->ToElement(), true);
+	xml2::XMLElement *current = top->FirstChildElement();
+	while(current != nullptr)
+	{
+		this->expand(current, true);
+		xml2::XMLElement *next = current->FirstChildElement();
+		if (next == nullptr)
+		{
+			next = current->NextSiblingElement();
+			while(next == nullptr && current->Parent() != top)
+			{
+				current = current->Parent()->ToElement();
+				next    = current->NextSiblingElement();
+			}
+		}
+		current = next;
+	}
 }
 
 XmlLoader::~XmlLoader(void)
@@ -28,57 +335,239 @@ XmlLoader::~XmlLoader(void)
 XmlLoader& XmlLoader::backToRoot(void)
 {
 	this->_gotoRoot();
-	this->onNode = true;
+	this->onNode    = true;
+	this->lastMatch = nullptr;
+	return *this;
+}
+
+XmlLoader& XmlLoader::cursorMode(bool enable)
+{
+	this->sequential = enable;
+	this->lastMatch  = nullptr;
 	return *this;
 }
 
+bool XmlLoader::nextElement(void)
+{
+	xml2::XMLElement *next = nullptr;
+	if (this->lastMatch == nullptr)
+	{
+		this->expand(this->currentNode->ToElement());
+		next = this->currentNode->FirstChildElement();
+	}
+	else
+	{
+		next = this->lastMatch->NextSiblingElement();
+	}
+	if (next == nullptr)
+	{
+		return false;
+	}
+	this->onNode         = false;
+	this->currentElement = next;
+	this->lastMatch      = next;
+	return true;
+}
+
+bool XmlLoader::nextNode(void)
+{
+	xml2::XMLElement *next = this->currentNode->NextSiblingElement();
+	this->onNode = true;
+	if (next == nullptr)
+	{
+		return false;
+	}
+	this->currentNode    = next;
+	this->currentElement = nullptr;
+	this->lastMatch      = nullptr;
+	return true;
+}
+
+const xml2::XMLElement* XmlLoader::selected(void) const
+{
+	const xml2::XMLNode *selected = this->onNode ? this->currentNode : this->currentElement;
+	return (selected == nullptr) ? nullptr : selected->ToElement();
+}
+
+std::string XmlLoader::name(void) const
+{
+	const xml2::XMLElement *selected = this->selected();
+	if (selected == nullptr)
+	{
+		return this->sentinel<std::string>();
+	}
+	return std::string(selected->Name());
+}
+
+size_t XmlLoader::inRecord(size_t offset) const
+{
+	if (this->stream == nullptr)
+	{
+		return offset;
+	}
+	const size_t head = this->stream->root().size();
+	return (offset < head) ? 0 : offset - head;
+}
+
+size_t XmlLoader::sourceBegin(void) const
+{
+	const xml2::XMLElement *selected = this->selected();
+	return (selected == nullptr) ? 0 : this->inRecord(selected->SourceBegin());
+}
+
+size_t XmlLoader::sourceEnd(void) const
+{
+	const xml2::XMLElement *selected = this->selected();
+	return (selected == nullptr) ? 0 : this->inRecord(selected->SourceEnd());
+}
+
+int XmlLoader::sourceLine(void) const
+{
+	const xml2::XMLElement *selected = this->selected();
+	return (selected == nullptr) ? 0 : selected->SourceLine();
+}
+
 void XmlLoader::forEachElementNamed(const std::string &name, std::function<void(void)> lambda)
 {
-	this->element(name);
-	while(this->currentElement != nullptr)
+	this->eachElementNamed(name, [&lambda](xml2::XMLElement*) { lambda(); });
+}
+
+std::vector<XmlCursor> XmlLoader::records(const std::string &name) const
+{
+	std::vector<XmlCursor> all;
+	for(xml2::XMLElement *record = this->firstChild(this->currentNode, name); record != nullptr; record = this->nextSibling(record, name))
 	{
-		lambda();
-		this->currentElement = this->currentElement->NextSiblingElement(name.c_str());
+		// The cursors cannot expand anything : they are read-only, and shared by threads.
+		this->expandAll(record);
+		all.emplace_back(record);
 	}
+	return all;
 }
 
-void XmlLoader::forEachNodeNamed(const std::string &name, std::function<void(void)> lambda)
+XmlPool& XmlLoader::threads(unsigned threads)
 {
-	this->node(name);
-	while(this->currentNode != nullptr)
+	if (this->pool == nullptr || (threads != 0 && threads != this->pool->size()))
 	{
-		lambda();
-		this->onNode = true;
-		this->currentNode = this->currentNode->NextSiblingElement(name.c_str());
+		this->pool.reset(new XmlPool(threads));
 	}
-	this->prev();
+	return *this->pool;
+}
+
+void XmlLoader::parallelForEachNodeNamed(const std::string &name, std::function<void(XmlCursor)> lambda, unsigned threads)
+{
+	const std::vector<XmlCursor> all = this->records(name);
+	this->threads(threads).run(all.size(), 0, [&](size_t begin, size_t end) {
+		for(size_t i = begin; i < end; ++i)
+		{
+			lambda(all[i]);
+		}
+	});
+}
+
+std::vector<XmlCursor> XmlLoader::select(const XmlQuery &query) const
+{
+	this->expandAll(query.absolute() ? this->root->GetDocument() : this->currentNode);
+	return query.run(this->currentNode);
+}
+
+std::vector<XmlCursor> XmlLoader::select(const std::string &query) const
+{
+	return this->select(XmlQuery(query));
+}
+
+void XmlLoader::forEachNodeNamed(const std::string &name, std::function<void(void)> lambda)
+{
+	this->eachNodeNamed(name, [&lambda](xml2::XMLElement*) { lambda(); });
+}
+
+XmlChildren XmlLoader::children(const std::string &name) const
+{
+	// The cursors cannot expand anything.
+	this->expandAll(this->currentNode);
+	return XmlChildren(this->currentNode, name);
 }
 
 XmlLoader& XmlLoader::element(const std::string &elementName)
 {
-	this->currentElement = this->currentNode->FirstChildElement(elementName.c_str());
+	this->currentElement = nullptr;
+	if (this->sequential && this->lastMatch != nullptr)
+	{
+		this->currentElement = this->nextSibling(this->lastMatch, elementName);
+	}
+	if (this->currentElement == nullptr)
+	{
+		this->currentElement = this->firstChild(this->currentNode, elementName);
+	}
 	if (this->currentElement == nullptr)
 	{
 		std::cerr << "[WARNING]: <" << elementName << "> does not exist" << std::endl;
 	}
+	else
+	{
+		this->lastMatch = this->currentElement;
+	}
 	this->onNode = false;
 	return *this;
 }
 
+XmlQName XmlLoader::qname(const std::string &ns, const std::string &local)
+{
+	if (this->flat == nullptr)
+	{
+		this->freeze();
+	}
+	this->flat->resolve();
+	XmlQName name;
+	name.space = this->flat->atom(ns);
+	name.local = this->flat->atom(local);
+	name.table = this->flat->id();
+	return name;
+}
+
+XmlLoader& XmlLoader::element(const XmlQName &name)
+{
+	this->currentElement = nullptr;
+	if (this->sequential && this->lastMatch != nullptr)
+	{
+		this->currentElement = this->nextSibling(this->lastMatch, name);
+	}
+	if (this->currentElement == nullptr)
+	{
+		this->currentElement = this->firstChild(this->currentNode, name);
+	}
+	if (this->currentElement == nullptr)
+	{
+		std::cerr << "[WARNING]: <" << this->print(name) << "> does not exist" << std::endl;
+	}
+	else
+	{
+		this->lastMatch = this->currentElement;
+	}
+	this->onNode = false;
+	return *this;
+}
+
+XmlLoader& XmlLoader::element(const std::string &ns, const std::string &local)
+{
+	return this->element(this->qname(ns, local));
+}
+
 XmlLoader& XmlLoader::prev(uint32_t of)
 {
 	this->_prev(of);
-	this->onNode = true;
+	this->onNode    = true;
+	this->lastMatch = nullptr;
 	return *this;
 }
 
 XmlLoader& XmlLoader::node(const std::string &name)
 {
-	xml2::XMLNode *tmp = this->currentNode->FirstChildElement(name.c_str());
+	xml2::XMLNode *tmp = this->firstChild(this->currentNode, name);
 	if (tmp != nullptr)
 	{
 		this->visited.push(this->currentNode);
 		this->currentNode = tmp;
+		this->lastMatch   = nullptr;
 	}
 	else
 	{
@@ -88,6 +577,51 @@ XmlLoader& XmlLoader::node(const std::string &name)
 	return *this;
 }
 
+XmlLoader& XmlLoader::node(const XmlQName &name)
+{
+	xml2::XMLNode *tmp = this->firstChild(this->currentNode, name);
+	if (tmp != nullptr)
+	{
+		this->visited.push(this->currentNode);
+		this->currentNode = tmp;
+		this->lastMatch   = nullptr;
+	}
+	else
+	{
+		std::cerr << "[WARNING] : There is no child named " << this->print(name) << std::endl;
+	}
+	this->onNode = true;
+	return *this;
+}
+
+XmlLoader& XmlLoader::node(const std::string &ns, const std::string &local)
+{
+	return this->node(this->qname(ns, local));
+}
+
+XmlView XmlLoader::rawText(void)
+{
+	XmlView view;
+	if (this->currentElement == nullptr)
+	{
+		std::cerr << "[WARNING] : No node selected." << std::endl;
+		return view;
+	}
+	view.data = this->expand(this->currentElement)->GetRawText(&view.size);
+	return view;
+}
+
+XmlView XmlLoader::rawAttribute(const std::string &att) const
+{
+	const xml2::XMLElement *selected = this->selected();
+	if (selected == nullptr)
+	{
+		std::cerr << "[WARNING] : No node selected." << std::endl;
+		return XmlView();
+	}
+	return XmlCursor(selected).rawAttribute(att);
+}
+
 #define ATTRIBUTE_MATCH(type, function) \
 template<> \
 type XmlLoader::attribute(const std::string &att) \
@@ -124,6 +658,7 @@ type XmlLoader::text(void)                                         \
 		return this->sentinel<type>();                             \
 	}                                                              \
 	type tmp;                                                      \
+	this->expand(this->currentElement);                            \
 	if (this->currentElement->function(&tmp) != xml2::XML_SUCCESS) \
 	{                                                              \
 		return this->sentinel<type>();                             \
@@ -139,7 +674,7 @@ std::string XmlLoader::text(void)
 		std::cerr << "[WARNING] : No node selected." << std::endl;
 		return this->sentinel<std::string>();
 	}
-	const char *value = this->currentElement->GetText();
+	const char *value = this->expand(this->currentElement)->GetText();
 	if (value == nullptr)
 	{
 		return this->sentinel<std::string>();
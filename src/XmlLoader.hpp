@@ -12,7 +12,21 @@
 #include <string>
 #include <iostream>
 #include <functional>
+#include <memory>
+#include <vector>
+#include <utility>
 #include "XmlBase.hpp"
+#include "XmlFlat.hpp"
+#include "XmlCursor.hpp"
+#include "XmlPool.hpp"
+#include "XmlQuery.hpp"
+#include "XmlOptions.hpp"
+#include "XmlProjection.hpp"
+#include "XmlIndex.hpp"
+#include "XmlStream.hpp"
+#include "XmlAsync.hpp"
+#include "XmlAttributeMap.hpp"
+#include "XmlView.hpp"
 
 namespace xml2 = tinyxml2;
 
@@ -23,7 +37,14 @@ namespace xml2 = tinyxml2;
 class XmlLoader final : public _XmlBase
 {
 	private:
-		bool onNode; //!< If the last access was on a Node.
+		bool                           onNode;     //!< If the last access was on a Node.
+		std::unique_ptr<XmlFlat>       flat;       //!< The frozen document, if freeze() was called.
+		bool                           sequential; //!< If element() searches forward from lastMatch.
+		xml2::XMLElement*              lastMatch;  //!< The last child of currentNode selected.
+		std::unique_ptr<XmlPool>       pool;       //!< The threads of the parallel methods.
+		XmlOptions                     options;    //!< The options every document is loaded with.
+		std::unique_ptr<XmlProjection> projection; //!< The filter of options.keepPaths, if any.
+		std::unique_ptr<XmlStream>     stream;     //!< The file read record by record, if options.streaming.
 		
 		/**
 		 * @brief Return the default value of the type \b T.
@@ -36,6 +57,161 @@ class XmlLoader final : public _XmlBase
 			return T();
 		}
 		
+		/**
+		 * @brief Set the document up with the options, once for all.
+		 */
+		void configure(void);
+		
+		/**
+		 * @brief Get the document ready to parse a new content, with the options.
+		 */
+		void prepare(void);
+		
+		/**
+		 * @brief Check that \a text is UTF-8, if the options ask for it.
+		 * @param[in] text The characters about to be parsed.
+		 * @param[in] size Their number.
+		 * @param[in] what What they are, for the error message.
+		 * @throw std::string if they are not, the offset of the first invalid byte being printed.
+		 */
+		void validate(const char *text, size_t size, const std::string &what) const;
+
+		/**
+		 * @brief Check the document just loaded against the schema, if the options have one.
+		 * @param[in] what What was loaded, for the error message.
+		 * @throw std::string if it is not valid, the error being printed.
+		 */
+		void conform(const std::string &what);
+
+		/**
+		 * @brief Load \a record alone under the root of the streamed file, and bind it.
+		 * @param[in] record The record, nullptr for none.
+		 * @param[in] size   Its number of characters.
+		 * @throw std::string if \a record is not well formed.
+		 */
+		void loadRecord(const char *record, size_t size);
+		
+		/**
+		 * @brief Apply \a lambda on each record named \a name of the streamed file.
+		 */
+		void streamNodeNamed(const std::string &name, std::function<void(void)> lambda);
+		
+		/**
+		 * @brief Bind the first node of the freshly parsed document as root,
+		 * and reset every navigation state.
+		 * @throw std::string if there is no first node.
+		 */
+		void bindRoot(void);
+
+		/**
+		 * @brief Turn an \a offset of the parsed buffer into one of the file, or of
+		 * the record when streaming : the opening tag of the root put before it is not counted.
+		 */
+		size_t inRecord(size_t offset) const;
+		
+		/**
+		 * @brief Find the first child element of \a from named \a name,
+		 * through the frozen document if there is one.
+		 * @return The element, or nullptr if there is none.
+		 */
+		xml2::XMLElement* firstChild(xml2::XMLNode *from, const std::string &name) const;
+		
+		/**
+		 * @brief Find the next sibling element of \a from named \a name,
+		 * through the frozen document if there is one.
+		 * @return The element, or nullptr if there is none.
+		 */
+		xml2::XMLElement* nextSibling(xml2::XMLNode *from, const std::string &name) const;
+		
+		/**
+		 * @brief Select each element named \a name, as forEachElementNamed() does,
+		 * and call \a visit on it.
+		 */
+		template<typename G>
+		void eachElementNamed(const std::string &name, G visit)
+		{
+			this->element(name);
+			while(this->currentElement != nullptr)
+			{
+				visit(this->currentElement);
+				this->lastMatch      = this->currentElement;
+				this->currentElement = this->nextSibling(this->currentElement, name);
+			}
+		}
+		
+		/**
+		 * @brief Enter each node named \a name, as forEachNodeNamed() does,
+		 * and call \a visit on it.
+		 */
+		template<typename G>
+		void eachNodeNamed(const std::string &name, G visit)
+		{
+			if (this->stream != nullptr && this->currentNode == this->root)
+			{
+				this->streamNodeNamed(name, [&]() { visit(this->currentNode->ToElement()); });
+				return;
+			}
+			this->node(name);
+			while(this->currentNode != nullptr)
+			{
+				visit(this->currentNode->ToElement());
+				this->onNode = true;
+				this->lastMatch = nullptr;
+				this->currentNode = this->nextSibling(this->currentNode, name);
+			}
+			this->prev();
+		}
+		
+		/**
+		 * @brief Find the first child element of \a from in the namespace and named as \a name,
+		 * through the frozen and resolved document.
+		 * @return The element, or nullptr if there is none, or if the document is not resolved.
+		 */
+		xml2::XMLElement* firstChild(xml2::XMLNode *from, const XmlQName &name) const;
+		
+		/**
+		 * @brief Find the next sibling element of \a from in the namespace and named as \a name,
+		 * through the frozen and resolved document.
+		 * @return The element, or nullptr if there is none, or if the document is not resolved.
+		 */
+		xml2::XMLElement* nextSibling(xml2::XMLNode *from, const XmlQName &name) const;
+		
+		/**
+		 * @brief Write \a name as {namespace}local, for the warnings.
+		 */
+		std::string print(const XmlQName &name) const;
+		
+		/**
+		 * @brief Get the current selection (node or element, as attribute() does).
+		 * @return It, or nullptr if it is not an element.
+		 */
+		const xml2::XMLElement* selected(void) const;
+		
+		/**
+		 * @brief Parse the content of \a element if the lazy load skipped it.
+		 * @param[in] all true to parse all of it, false to parse the lazy depth only.
+		 * @return \a element.
+		 * @throw std::string if the content is not well formed.
+		 */
+		xml2::XMLElement* expand(xml2::XMLElement *element, bool all = false) const;
+		
+		/**
+		 * @brief Parse everything the lazy load skipped below \a top.
+		 * @throw std::string if a content is not well formed.
+		 */
+		void expandAll(xml2::XMLNode *top) const;
+		
+		/**
+		 * @brief Collect the children of the current node named \a name, in document order.
+		 */
+		std::vector<XmlCursor> records(const std::string &name) const;
+		
+		/**
+		 * @brief Get the pool, (re)created with \a threads threads if needed.
+		 * @param[in] threads The number of threads, 0 for one per core.
+		 */
+		XmlPool& threads(unsigned threads);
+		
 		XmlLoader(void)                              = delete;
 		XmlLoader(const XmlLoader &other)            = delete;
 		XmlLoader(XmlLoader &&other)                 = delete;
@@ -45,6 +221,8 @@ class XmlLoader final : public _XmlBase
 	public:
 		/**
 		 * @brief Create a XmlLoader, and load the file \a fname with TinyXML2.
+		 * A gzip or zstd compressed \a fname is decompressed on the fly, straight
+		 * into the parse buffer (see XmlInput.hpp to enable them).
 		 * @pre  A valid \a fname (file exists, is readable, is xml).
 		 * @post A valid XmlLoader ready to use.
 		 * @throw std::string if there is issues when opening \a fname.
@@ -52,11 +230,148 @@ class XmlLoader final : public _XmlBase
 		 */
 		XmlLoader(const std::string &fname);
 		
+		/**
+		 * @brief Same as XmlLoader(fname), but load \a fname, and every document
+		 * reloaded later, with \a options.
+		 * @code
+		 * XmlOptions options;
+		 * options.keepPaths = {"catalog/record/name", "catalog/record/price"};
+		 * XmlLoader loader("catalog.xml", options);
+		 * @endcode
+		 * @param[in] fname   The file to load.
+		 * @param[in] options The options to load with.
+		 * @throw std::string if there is issues when opening \a fname.
+		 * @throw std::string if there is issues when reading root of xml tree.
+		 */
+		XmlLoader(const std::string &fname, const XmlOptions &options);
+		
+		/**
+		 * @brief Create a XmlLoader on the record \a record of an indexed file,
+		 * parsing only its byte range : the record is the root.
+		 * @code
+		 * XmlIndex index("catalog.xml");
+		 * XmlLoader loader(index, index.find("sku-42"));
+		 * @endcode
+		 * The offsets of sourceBegin() and sourceEnd() are then from the start of the record.
+		 * @param[in] index   The index of the file.
+		 * @param[in] record  The number of the record, from 0.
+		 * @param[in] options The options to load with.
+		 * @throw std::string if there is no such record.
+		 * @throw std::string if the record is not well formed.
+		 */
+		XmlLoader(const XmlIndex &index, size_t record, const XmlOptions &options = XmlOptions());
+		
+#ifdef RWXML_WITH_COROUTINES
+		/**
+		 * @brief Load \a fname without blocking the calling coroutine (C++20 only, see XmlAsync.hpp).
+		 * @code
+		 * std::unique_ptr<XmlLoader> loader = co_await XmlLoader::openAsync("catalog.xml", [&](std::function<void(void)> resume) {
+		 * 	loop.post(resume);
+		 * });
+		 * @endcode
+		 * @param[in] fname    The file to load.
+		 * @param[in] executor Run the function it gets on the executor the coroutine has to be resumed on.
+		 * @param[in] options  The options to load with.
+		 * @return What to \b co_await : it gives the loader, or throws what XmlLoader(fname, options) threw.
+		 */
+		static XmlLoading openAsync(const std::string &fname, XmlLoading::Executor executor, const XmlOptions &options = XmlOptions());
+#endif
+		
 		/**
 		 * @brief Close and erase every things possible from the XMlLoader.
 		 */
 		~XmlLoader(void);
 		
+		/**
+		 * @brief Drop the current document and load \a fname instead, as the
+		 * constructor would.
+		 * The memory pools and the character buffer of the previous document
+		 * are kept, so reloading many files of similar shape stops allocating
+		 * once the biggest one has been seen.
+		 * @param[in] fname The file to load.
+		 * @pre  A valid \a fname (file exists, is readable, is xml).
+		 * @post The XmlLoader is back to root, on the new document.
+		 * @throw std::string if there is issues when opening \a fname.
+		 * @throw std::string if there is issues when reading root of xml tree.
+		 * @return A reference on your XmlLoader.
+		 */
+		XmlLoader& reload(const std::string &fname);
+		
+		/**
+		 * @brief Same as reload(fname), but parse the \a size first bytes of \a buffer.
+		 * @param[in] buffer The xml content (it is copied, you keep the ownership).
+		 * @param[in] size   The number of bytes of \a buffer to parse.
+		 * @throw std::string if \a buffer is not well formed.
+		 * @throw std::string if there is issues when reading root of xml tree.
+		 * @return A reference on your XmlLoader.
+		 */
+		XmlLoader& reload(const char *buffer, size_t size);
+		
+		/**
+		 * @brief Same as reload(fname), but parse only the record \a record of an indexed file.
+		 * @param[in] index  The index of the file.
+		 * @param[in] record The number of the record, from 0.
+		 * @throw std::string if there is no such record.
+		 * @throw std::string if the record is not well formed.
+		 * @return A reference on your XmlLoader.
+		 */
+		XmlLoader& reload(const XmlIndex &index, size_t record);
+		
+		/**
+		 * @brief Freeze the document into a flat, read-only table (see XmlFlat),
+		 * that every navigation method then runs on.
+		 * It stays frozen until the next reload().
+		 * @throw std::string if the document is too big to be frozen.
+		 * @return A reference on your XmlLoader.
+		 */
+		XmlLoader& freeze(void);
+		
+		/**
+		 * @brief Tell if freeze() has been called on the current document.
+		 */
+		bool frozen(void) const;
+		
+		/**
+		 * @brief Compact a document kept loaded for long : its nodes are moved
+		 * in depth-first order into new pool blocks, and the characters they use
+		 * into a buffer just big enough for them, the parsed one being freed
+		 * (see XMLDocument::Compact()). The whole document is expanded first.
+		 * With glibc, the memory freed is then given back to the system.
+		 *
+		 * As after reload(), the root is selected again, the document is no
+		 * longer frozen, and the cursors, atoms and views got before are invalid.
+		 * @return A reference on your XmlLoader.
+		 */
+		XmlLoader& compact(void);
+		
+		/**
+		 * @brief Compute the structural hash of every element of the document,
+		 * once, bottom-up (see XmlFlat::hash() for what it covers).
+		 * The document is frozen first if it is not. Comparing two subtrees, of
+		 * this document or of another one, is then comparing two integers :
+		 * @code
+		 * old.hashAll();
+		 * now.hashAll(0);
+		 * if (old.node("network").hash() != now.node("network").hash())
+		 * @endcode
+		 * @param[in] threads The number of threads, 1 to hash from this thread only, 0 for one per core.
+		 * @throw std::string if the document is too big to be frozen.
+		 * @return A reference on your XmlLoader.
+		 */
+		XmlLoader& hashAll(unsigned threads = 1);
+		
+		/**
+		 * @brief Get the structural hash of the current selection (node or element, as attribute() does).
+		 * @return Its hash, or 0 if nothing is selected or if hashAll() was not called.
+		 */
+		uint64_t hash(void) const;
+		
+		/**
+		 * @brief Get the structural hash of the element of \a cursor, got from this XmlLoader.
+		 * @return Its hash, or 0 if \a cursor is invalid or if hashAll() was not called.
+		 */
+		uint64_t hash(const XmlCursor &cursor) const;
+		
 		/**
 		 * @brief Select \a elementName as the current element to work with.
 		 * It will print a warning if \a nodeName doesn't exist.
@@ -67,6 +382,42 @@ class XmlLoader final : public _XmlBase
 		 */
 		XmlLoader& element(const std::string &elementName);
 		
+		/**
+		 * @brief Get the atoms of the namespace \a ns and of the local name \a local,
+		 * to look elements up by their namespace, whatever prefix binds it.
+		 *
+		 * The document is frozen (see freeze()) if it is not, and its \b xmlns
+		 * scopes are resolved once (see XmlFlat::resolve()). Looking an element up
+		 * with the atoms is then comparing two integers per child :
+		 * @code
+		 * const XmlQName price = loader.qname("urn:catalog", "price");
+		 * loader.forEachNodeNamed("soap:Body", [&]() {
+		 * 	total += loader.element(price).text<double>();
+		 * });
+		 * @endcode
+		 * The atoms are valid until the next reload() : after it, they match no element.
+		 * @param[in] ns    The namespace URI, "" for the elements in no namespace.
+		 * @param[in] local The local name, without prefix.
+		 * @throw std::string if the document is too big to be frozen.
+		 * @return The atoms, which match no element if the document has no such name.
+		 */
+		XmlQName qname(const std::string &ns, const std::string &local);
+		
+		/**
+		 * @brief Select the first element in the namespace and named as \a name,
+		 * as element(const std::string&) does by its qualified name.
+		 * @param[in] name The atoms given by qname().
+		 * @return A reference to the XmlLoader, in order to chain it with \b .text() or \b .attribute()
+		 */
+		XmlLoader& element(const XmlQName &name);
+		
+		/**
+		 * @brief Same as element(qname(\a ns, \a local)).
+		 * @throw std::string if the document is too big to be frozen.
+		 * @return A reference to the XmlLoader, in order to chain it with \b .text() or \b .attribute()
+		 */
+		XmlLoader& element(const std::string &ns, const std::string &local);
+		
 		/**
 		 * @brief This function allows you to get the value into an attribute named \a att
 		 *  from a previously selected element (with element("field") method).
@@ -91,6 +442,25 @@ class XmlLoader final : public _XmlBase
 		template<typename T>
 		T attribute(const std::string &att);
 		
+		/**
+		 * @brief Read every attribute of \a map that the current selection (node or
+		 * element, as attribute() does) has into its member of \a out, in a single
+		 * walk over its attributes (see XmlAttributeMap).
+		 * @code
+		 * Record record;
+		 * loader.attributes(fields, record);
+		 * @endcode
+		 * The members of the attributes missing, or which cannot be converted, are left unchanged.
+		 * @param[in]  map The attributes to read, and their members.
+		 * @param[out] out Where to read them.
+		 * @return The number of members read.
+		 */
+		template<typename S, typename... F>
+		size_t attributes(const XmlAttributeMap<S, F...> &map, S &out) const
+		{
+			return map.read(this->selected(), out);
+		}
+		
 		/**
 		 * @brief This function allows you to get the text converting into \b T
 		 * from the current element (Which was selected by using the element("field") method).
@@ -111,6 +481,92 @@ class XmlLoader final : public _XmlBase
 		template<typename T>
 		T text(void);
 		
+		/**
+		 * @brief Get the text of the current element exactly as it is in the file :
+		 * no entity decoded, no newline normalized, no blank collapsed, and no copy.
+		 * 
+		 * Forwarding texts this way skips all the decoding work text() does on the
+		 * first read of each text (rewriting it in place, then copying it) :
+		 * @code
+		 * loader.forEachNodeNamed("record", [&]() {
+		 * 	const XmlView name = loader.element("name").rawText();
+		 * 	out.write(name.data, name.size);
+		 * });
+		 * @endcode
+		 * Once text() has read the same text, it is decoded in place : the view is then on the decoded text.
+		 * @return A view on the text, empty if there is none, valid until the next reload().
+		 */
+		XmlView rawText(void);
+		
+		/**
+		 * @brief Same as rawText(), for the attribute \a att of the current selection
+		 * (node or element, as attribute() does).
+		 * @param[in] att The attribute name.
+		 * @return A view on its value, empty if there is none, valid until the next reload().
+		 */
+		XmlView rawAttribute(const std::string &att) const;
+		
+		/**
+		 * @brief Enable (or disable) the cursor mode.
+		 * 
+		 * In cursor mode, element() remembers the last child it selected, and
+		 * looks for the next one from there, wrapping to the first child if needed.
+		 * Reading the fields of a record in document order is then a single pass
+		 * over its children, instead of a search from the first child for each field :
+		 * @code
+		 * loader.cursorMode(true);
+		 * loader.forEachNodeNamed("person", [&]() {
+		 * 	name = loader.element("name").text<std::string>();
+		 * 	age  = loader.element("age").text<int>();
+		 * });
+		 * @endcode
+		 * The cursor is forgotten each time the current node changes.
+		 * @param[in] enable true to enable it.
+		 * @return A reference on your XmlLoader.
+		 */
+		XmlLoader& cursorMode(bool enable = true);
+		
+		/**
+		 * @brief Select the child of the current node following the last one selected,
+		 * whatever its name, or its first child element if none was selected yet.
+		 * @return false if there is no such element, the selection is then left unchanged.
+		 */
+		bool nextElement(void);
+		
+		/**
+		 * @brief Move the current node to its next sibling element, whatever its name.
+		 * @return false if there is no such element, the current node is then left unchanged.
+		 */
+		bool nextNode(void);
+		
+		/**
+		 * @brief Get the name of the current selection (node or element, as attribute() does).
+		 * @return Its name, or "" if nothing is selected.
+		 */
+		std::string name(void) const;
+		
+		/**
+		 * @brief Get where the current selection starts in the file : the byte
+		 * offset of its '<'. The offsets of a compressed file are the ones of
+		 * its decompressed content.
+		 * Each element costs 16 bytes more to record its offsets and line.
+		 * @return The offset, or 0 if nothing is selected.
+		 */
+		size_t sourceBegin(void) const;
+		
+		/**
+		 * @brief Get where the current selection ends in the file : the byte
+		 * offset just past the '>' of its closing tag.
+		 * @return The offset, or 0 if nothing is selected.
+		 */
+		size_t sourceEnd(void) const;
+		
+		/**
+		 * @brief Get the line (from 1) the current selection starts on.
+		 * @return The line, or 0 if nothing is selected or if XmlOptions::lineNumbers was not set.
+		 */
+		int sourceLine(void) const;
+		
 		/**
 		 * @brief Allow the user to iterate over some elements which have the same \a name,
 		 * and apply \a lambda at each iteration.
@@ -129,6 +585,25 @@ class XmlLoader final : public _XmlBase
 		 */
 		void forEachElementNamed(const std::string &name, std::function<void(void)> lambda);
 		
+		/**
+		 * @brief Same as forEachElementNamed(name, std::function), but \a lambda is any
+		 * callable taking a XmlCursor on the element, and is called without any type erasure.
+		 * @code
+		 * loader.forEachElementNamed("name", [&](XmlCursor name) { names.push_back(name.text<std::string>()); });
+		 * @endcode
+		 * @param[in] name   The name of the list of element
+		 * @param[in] lambda The function you wanna apply for each element.
+		 */
+		template<typename F, typename = decltype(std::declval<F&>()(std::declval<XmlCursor>()))>
+		void forEachElementNamed(const std::string &name, F lambda)
+		{
+			// The cursor cannot expand anything : with a lazy depth, its subtree is expanded first.
+			this->eachElementNamed(name, [&](xml2::XMLElement *element) {
+				this->expandAll(element);
+				lambda(XmlCursor(element));
+			});
+		}
+		
 		/**
 		 * @brief Offer a way to iterate over some nodes with the same \a name.
 		 * 
@@ -152,6 +627,106 @@ class XmlLoader final : public _XmlBase
 		 */
 		void forEachNodeNamed(const std::string &name, std::function<void(void)> lambda);
 		
+		/**
+		 * @brief Same as forEachNodeNamed(name, std::function), but \a lambda is any
+		 * callable taking a XmlCursor on the node, and is called without any type erasure.
+		 * The XmlLoader is on the node too, as with forEachNodeNamed(name, std::function).
+		 * @param[in] name   The name of the node to iterate with.
+		 * @param[in] lambda THe function to apply for each node.
+		 */
+		template<typename F, typename = decltype(std::declval<F&>()(std::declval<XmlCursor>()))>
+		void forEachNodeNamed(const std::string &name, F lambda)
+		{
+			// The cursor cannot expand anything : with a lazy depth, its subtree is expanded first.
+			this->eachNodeNamed(name, [&](xml2::XMLElement *node) {
+				this->expandAll(node);
+				lambda(XmlCursor(node));
+			});
+		}
+		
+		/**
+		 * @brief Get the children of the current node named \a name, to iterate over
+		 * them with a range-based for (see XmlChildren).
+		 * Unlike forEachNodeNamed(), the XmlLoader stays where it is : each child
+		 * is only given as a XmlCursor. With a lazy load, everything below the
+		 * current node is parsed first, as select() does.
+		 * @code
+		 * for(XmlCursor person : loader.children("person"))
+		 * {
+		 * 	ages += person.element("age").text<int>();
+		 * }
+		 * @endcode
+		 * @param[in] name The name of the children, "" for any name.
+		 * @return A range on them.
+		 */
+		XmlChildren children(const std::string &name = "") const;
+		
+		/**
+		 * @brief Apply \a lambda on each child of the current node named \a name, in parallel.
+		 * 
+		 * Unlike forEachNodeNamed(), \a lambda doesn't use the XmlLoader : it gets its own
+		 * XmlCursor, scoped to its record, and must not touch anything outside of it.
+		 * The records are spread by chunks over a work-stealing pool of \a threads threads
+		 * (the caller included), in no particular order.
+		 *
+		 * Reading through a cursor decodes the characters of its record in the parse
+		 * buffer, in place (see XmlCursor). It is safe only because the workers are given
+		 * disjoint records : cursors of different workers never share a node. Until it
+		 * returns, nothing else may read the records, not even the XmlLoader from another
+		 * thread : that would be a data race.
+		 * @code
+		 * loader.parallelForEachNodeNamed("person", [](XmlCursor person) {
+		 * 	process(person.element("name").text<std::string>());
+		 * });
+		 * @endcode
+		 * @param[in] name    The name of the records.
+		 * @param[in] lambda  The function to apply on each record.
+		 * @param[in] threads The number of threads, 0 for one per core.
+		 * @throw The first exception thrown by \a lambda, once every record is done.
+		 */
+		void parallelForEachNodeNamed(const std::string &name, std::function<void(XmlCursor)> lambda, unsigned threads = 0);
+		
+		/**
+		 * @brief Same as parallelForEachNodeNamed(), but keep what \a lambda returns for each record.
+		 * The same rules apply to \a lambda.
+		 * @warning \b R must defines a basic constructor.
+		 * @param[in] name    The name of the records.
+		 * @param[in] lambda  The function to apply on each record.
+		 * @param[in] threads The number of threads, 0 for one per core.
+		 * @throw The first exception thrown by \a lambda, once every record is done.
+		 * @return The results, in the document order of their records, ready to be reduced.
+		 */
+		template<typename R>
+		std::vector<R> parallelMapNodeNamed(const std::string &name, std::function<R(XmlCursor)> lambda, unsigned threads = 0)
+		{
+			const std::vector<XmlCursor> all = this->records(name);
+			std::vector<R> results(all.size());
+			this->threads(threads).run(all.size(), 0, [&](size_t begin, size_t end) {
+				for(size_t i = begin; i < end; ++i)
+				{
+					results[i] = lambda(all[i]);
+				}
+			});
+			return results;
+		}
+		
+		/**
+		 * @brief Run \a query from the current node (see XmlQuery for the supported subset).
+		 * The current node is left unchanged.
+		 * @code
+		 * for(const XmlCursor &name : loader.select("//person[@id='12']/name"))
+		 * @endcode
+		 * @param[in] query The compiled query, to run it many times without compiling it again.
+		 * @return The selected elements.
+		 */
+		std::vector<XmlCursor> select(const XmlQuery &query) const;
+		
+		/**
+		 * @brief Same as select(XmlQuery(query)).
+		 * @throw std::string if \a query is not in the supported subset.
+		 */
+		std::vector<XmlCursor> select(const std::string &query) const;
+		
 		/**
 		 * @brief Reset the "iterators" (such a big word for that kind of stuff)
 		 * 
@@ -179,6 +754,21 @@ class XmlLoader final : public _XmlBase
 		 */
 		XmlLoader& node(const std::string &name);
 		
+		/**
+		 * @brief Move to the first node in the namespace and named as \a name,
+		 * as node(const std::string&) does by its qualified name.
+		 * @param[in] name The atoms given by qname().
+		 * @return A reference on your XmlLoader.
+		 */
+		XmlLoader& node(const XmlQName &name);
+		
+		/**
+		 * @brief Same as node(qname(\a ns, \a local)).
+		 * @throw std::string if the document is too big to be frozen.
+		 * @return A reference on your XmlLoader.
+		 */
+		XmlLoader& node(const std::string &ns, const std::string &local);
+		
 		/**
 		 * @brief Go back of \a of node you previously visited.
 		 * @param[in] of The number of node you wanna go back.
@@ -0,0 +1,112 @@
+/**
+ * @file XmlOptions.hpp
+ * @brief Defines the options a XmlLoader loads its documents with.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef XMLOPTIONS_HPP_INCLUDED
+#define XMLOPTIONS_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "tinyxml2.h"
+
+class XmlSchema;
+
+/**
+ * @brief The options of a XmlLoader, kept for each reload().
+ * The default ones load the whole document, as usual.
+ * @author MTLCRBN
+ */
+struct XmlOptions
+{
+	/**
+	 * @brief The only paths to load, empty to load everything.
+	 *
+	 * A path is a list of names from the root, such as \b "catalog/record/name",
+	 * \b * standing for any name. The elements on the way (\b catalog and each
+	 * \b record) are loaded with their attributes and texts, the matching ones
+	 * with their whole content, and every other subtree is skipped while parsing,
+	 * without creating any node.
+	 */
+	std::vector<std::string> keepPaths;
+
+	/**
+	 * @brief The number of levels of elements parsed at a time, 0 to parse everything at once.
+	 *
+	 * With a lazy depth of \b 2, only the root and its children are parsed at load
+	 * time, the content of each child being skipped. It is parsed, two levels deeper,
+	 * the first time node(), element() or forEachNodeNamed() enters it, so the
+	 * time spent depends on what is read, not on the size of the document.
+	 * The subtrees skipped are only checked when they are entered.
+	 */
+	unsigned lazyDepth = 0;
+
+	/**
+	 * @brief If the line each element starts on is counted (see XmlLoader::sourceLine()).
+	 * The byte offsets are always recorded, the lines cost a scan for the newlines.
+	 */
+	bool lineNumbers = false;
+
+	/**
+	 * @brief If the file is read record by record, through a sliding window (see XmlStream).
+	 *
+	 * Only the opening tag of the root is loaded. forEachNodeNamed(), called on the
+	 * root, then reads the file again and loads its children one at a time : each
+	 * one is the only child of the root while \b lambda runs, and is dropped once
+	 * it returns, its memory being reused by the next one. The memory needed is
+	 * bounded by the largest record, not by the file.
+	 * The source offsets are then the ones in the record.
+	 */
+	bool streaming = false;
+
+	/**
+	 * @brief If the characters are checked to be UTF-8 before they are parsed
+	 * (see XmlUnicode::validUtf8()) : the load fails on the first invalid byte,
+	 * and prints its offset. Every text and attribute read is then valid UTF-8.
+	 * A big file is checked by the thread reading it, while it is parsed.
+	 */
+	bool validateUtf8 = false;
+
+	/**
+	 * @brief If the entities (\b &amp;amp;, \b &amp;#233;...) of the texts and attributes
+	 * are decoded when they are read. Without it, they are read as they are written.
+	 */
+	bool processEntities = true;
+
+	/**
+	 * @brief If the blanks of the texts are collapsed when they are read : the ones
+	 * around are dropped, and each run of them inside becomes a single space.
+	 */
+	bool collapseWhitespace = false;
+
+	/**
+	 * @brief How the characters and the nodes of the documents are allocated
+	 * (see XMLDocument::SetHugePages()).
+	 *
+	 * With \b tinyxml2::TRANSPARENT_HUGE_PAGES, they are kept in regions of 2 MB
+	 * the kernel can back with huge pages, so walking a big document misses the
+	 * TLB far less often ; \b tinyxml2::RESERVED_HUGE_PAGES takes the huge pages
+	 * reserved by the system first. Each pool of nodes then takes 2 MB at least :
+	 * it is meant for big documents. Where there are no huge pages, the memory
+	 * comes from the heap, as with \b tinyxml2::NO_HUGE_PAGES.
+	 */
+	tinyxml2::HugePages hugePages = tinyxml2::NO_HUGE_PAGES;
+
+	/**
+	 * @brief The schema each document is checked against once loaded (see XmlSchema),
+	 * nullptr for none : the load fails on the first error, and prints where it is
+	 * (the path of the element and its line : the lines are counted, as with lineNumbers).
+	 *
+	 * The check walks the tree just built, the document is not parsed again.
+	 * With a lazy depth, the whole document is then parsed at load time. When
+	 * streaming, each record is checked as it is loaded, against the declaration
+	 * its name has in the content of the root. It cannot be used with keepPaths,
+	 * which drops what the schema requires.
+	 */
+	std::shared_ptr<const XmlSchema> schema;
+};
+
+#endif
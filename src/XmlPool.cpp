@@ -0,0 +1,152 @@
+#include <algorithm>
+
+#include "XmlPool.hpp"
+
+
+XmlPool::XmlPool(unsigned threads)
+{
+	if (threads == 0)
+	{
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	this->task       = nullptr;
+	this->generation = 0;
+	this->busy       = 0;
+	this->stopping   = false;
+	for(unsigned i = 0; i < threads; ++i)
+	{
+		this->queues.emplace_back(new Queue());
+	}
+	for(unsigned i = 0; i + 1 < threads; ++i)
+	{
+		this->threads.emplace_back(&XmlPool::work, this, i);
+	}
+}
+
+XmlPool::~XmlPool(void)
+{
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		this->stopping = true;
+	}
+	this->wake.notify_all();
+	for(std::thread &thread : this->threads)
+	{
+		thread.join();
+	}
+}
+
+unsigned XmlPool::size(void) const
+{
+	return static_cast<unsigned>(this->queues.size());
+}
+
+void XmlPool::run(size_t count, size_t chunk, const Task &task)
+{
+	if (count == 0)
+	{
+		return;
+	}
+	const size_t nQueues = this->queues.size();
+	if (chunk == 0)
+	{
+		// A few chunks per thread, so that stealing can even the load.
+		chunk = std::max<size_t>(1, count / (nQueues*8));
+	}
+	size_t queue = 0;
+	for(size_t begin = 0; begin < count; begin += chunk)
+	{
+		this->queues[queue]->chunks.emplace_back(begin, std::min(count, begin + chunk));
+		queue = (queue + 1) % nQueues;
+	}
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		this->task  = &task;
+		this->busy  = this->threads.size();
+		this->error = nullptr;
+		++this->generation;
+	}
+	this->wake.notify_all();
+
+	this->drain(nQueues - 1);
+
+	std::unique_lock<std::mutex> guard(this->lock);
+	this->finished.wait(guard, [this]() { return this->busy == 0; });
+	this->task = nullptr;
+	if (this->error)
+	{
+		std::exception_ptr error = this->error;
+		this->error = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+void XmlPool::work(size_t self)
+{
+	uint64_t seen = 0;
+	while(true)
+	{
+		{
+			std::unique_lock<std::mutex> guard(this->lock);
+			this->wake.wait(guard, [&]() { return this->stopping || this->generation != seen; });
+			if (this->stopping)
+			{
+				return;
+			}
+			seen = this->generation;
+		}
+		this->drain(self);
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			--this->busy;
+		}
+		this->finished.notify_one();
+	}
+}
+
+void XmlPool::drain(size_t self)
+{
+	std::pair<size_t, size_t> chunk;
+	while(this->take(self, chunk))
+	{
+		try
+		{
+			(*this->task)(chunk.first, chunk.second);
+		}
+		catch(...)
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			if (!this->error)
+			{
+				this->error = std::current_exception();
+			}
+		}
+	}
+}
+
+bool XmlPool::take(size_t self, std::pair<size_t, size_t> &chunk)
+{
+	const size_t nQueues = this->queues.size();
+	for(size_t i = 0; i < nQueues; ++i)
+	{
+		Queue &queue = *this->queues[(self + i) % nQueues];
+		std::lock_guard<std::mutex> guard(queue.lock);
+		if (queue.chunks.empty())
+		{
+			continue;
+		}
+		// Our own work from the back, stolen work from the front.
+		if (i == 0)
+		{
+			chunk = queue.chunks.back();
+			queue.chunks.pop_back();
+		}
+		else
+		{
+			chunk = queue.chunks.front();
+			queue.chunks.pop_front();
+		}
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file XmlPool.hpp
+ * @brief Defines the pool of threads the parallel methods run on.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef XMLPOOL_HPP_INCLUDED
+#define XMLPOOL_HPP_INCLUDED
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <memory>
+#include <cstdint>
+
+
+/**
+ * @brief A work-stealing pool of threads, running ranges of indexes.
+ *
+ * Each thread owns a queue of chunks of the range to run. It takes its work from
+ * the back of its own queue, and once it is empty steals from the front of the
+ * others, so that uneven chunks still keep every thread busy.
+ * The thread calling run() works too, and the pool threads sleep between two runs.
+ * The pool only spreads the indexes : a task sharing data with the others
+ * must synchronize it, the pool does not.
+ * @author MTLCRBN
+ */
+class XmlPool final
+{
+	public:
+		//! @brief The work of a chunk : every index in [begin, end).
+		typedef std::function<void(size_t begin, size_t end)> Task;
+
+	private:
+		//! @brief The chunks a thread still has to run.
+		struct Queue
+		{
+			std::mutex                              lock;   //!< To share it with the thieves.
+			std::deque<std::pair<size_t, size_t> > chunks; //!< The [begin, end) ranges.
+		};
+
+		std::vector<std::thread>             threads;    //!< The pool threads.
+		std::vector<std::unique_ptr<Queue> > queues;     //!< One per thread, the caller's one last.
+		std::mutex                           lock;       //!< Protects every field below.
+		std::condition_variable              wake;       //!< Signals a new run, or the end.
+		std::condition_variable              finished;   //!< Signals the end of a run.
+		const Task*                          task;       //!< The task of the current run.
+		uint64_t                             generation; //!< The number of runs started.
+		size_t                               busy;       //!< The pool threads still working on the run.
+		bool                                 stopping;   //!< If the pool is being destroyed.
+		std::exception_ptr                   error;      //!< The first exception thrown by the task.
+
+		/**
+		 * @brief The loop of the pool thread \a self.
+		 */
+		void work(size_t self);
+
+		/**
+		 * @brief Run chunks from the queue \a self, then from the others, until none is left.
+		 */
+		void drain(size_t self);
+
+		/**
+		 * @brief Take a chunk, from the queue \a self first.
+		 * @return false if every queue is empty.
+		 */
+		bool take(size_t self, std::pair<size_t, size_t> &chunk);
+
+		XmlPool(const XmlPool &other)            = delete;
+		XmlPool& operator=(const XmlPool &other) = delete;
+
+	public:
+		/**
+		 * @brief Create a pool of \a threads threads, the caller of run() included.
+		 * @param[in] threads The number of threads, 0 for one per core.
+		 */
+		explicit XmlPool(unsigned threads = 0);
+
+		//! @brief Wait for the pool threads to stop.
+		~XmlPool(void);
+
+		/**
+		 * @brief The number of threads, the caller of run() included.
+		 */
+		unsigned size(void) const;
+
+		/**
+		 * @brief Run \a task over [0, count), by chunks of \a chunk indexes, and wait for it.
+		 * Only one run at a time : run() must not be called from a task.
+		 * @param[in] count The number of indexes.
+		 * @param[in] chunk The number of indexes per chunk, 0 to choose it.
+		 * @param[in] task  What to do with each chunk.
+		 * @throw The first exception thrown by \a task, once every chunk is done.
+		 */
+		void run(size_t count, size_t chunk, const Task &task);
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include <algorithm>
+
+#include "XmlProjection.hpp"
+
+
+XmlProjection::XmlProjection(const std::vector<std::string> &keepPaths)
+{
+	for(const std::string &path : keepPaths)
+	{
+		std::vector<std::string> names;
+		size_t begin = 0;
+		while(begin <= path.size())
+		{
+			size_t end = path.find('/', begin);
+			if (end == std::string::npos)
+			{
+				end = path.size();
+			}
+			if (end > begin)
+			{
+				names.push_back(path.substr(begin, end - begin));
+			}
+			begin = end + 1;
+		}
+		if (!names.empty())
+		{
+			this->paths.push_back(names);
+		}
+	}
+}
+
+size_t XmlProjection::depth(void) const
+{
+	size_t depth = 0;
+	for(const std::vector<std::string> &names : this->paths)
+	{
+		depth = std::max(depth, names.size());
+	}
+	return depth;
+}
+
+void XmlProjection::reset(void)
+{
+	this->alive.clear();
+	this->levels.clear();
+}
+
+bool XmlProjection::Enter(const xml2::XMLElement &element)
+{
+	if (!this->levels.empty() && this->levels.back().inside)
+	{
+		this->levels.push_back({true, this->alive.size()});
+		return true;
+	}
+
+	const size_t depth = this->levels.size();
+	const size_t begin = this->alive.size();
+	const size_t from  = this->levels.empty() ? 0 : this->levels.back().begin;
+	const size_t to    = this->levels.empty() ? this->paths.size() : begin;
+	bool inside = false;
+	for(size_t i = from; i < to && !inside; ++i)
+	{
+		const uint32_t path = this->levels.empty() ? static_cast<uint32_t>(i) : this->alive[i];
+		const std::string &name = this->paths[path][depth];
+		if (name != "*" && name != element.Name())
+		{
+			continue;
+		}
+		if (depth + 1 == this->paths[path].size())
+		{
+			inside = true;
+		}
+		else
+		{
+			this->alive.push_back(path);
+		}
+	}
+	if (!inside && this->alive.size() == begin)
+	{
+		return false;
+	}
+	this->levels.push_back({inside, begin});
+	return true;
+}
+
+void XmlProjection::Exit(const xml2::XMLElement &)
+{
+	this->alive.resize(this->levels.back().begin);
+	this->levels.pop_back();
+}
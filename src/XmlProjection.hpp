@@ -0,0 +1,72 @@
+/**
+ * @file XmlProjection.hpp
+ * @brief Defines the parse filter keeping only some paths of a document.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef XMLPROJECTION_HPP_INCLUDED
+#define XMLPROJECTION_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "tinyxml2.h"
+
+namespace xml2 = tinyxml2;
+
+
+/**
+ * @brief Tell the parser which elements lead to, or are in, the paths to keep
+ * (see XmlOptions::keepPaths).
+ *
+ * For each open element, it keeps the paths still matching up to it, so that
+ * a child is checked against these ones only.
+ * @author MTLCRBN
+ */
+class XmlProjection final : public xml2::XMLParseFilter
+{
+	private:
+		//! @brief What is known of an open element.
+		struct Level
+		{
+			bool   inside; //!< If it is in a kept subtree.
+			size_t begin;  //!< Where its matching paths start in alive.
+		};
+
+		std::vector<std::vector<std::string> > paths;  //!< The names of each path.
+		std::vector<uint32_t>                  alive;  //!< The matching paths of each open element.
+		std::vector<Level>                     levels; //!< The open elements.
+
+		XmlProjection(const XmlProjection &other)            = delete;
+		XmlProjection& operator=(const XmlProjection &other) = delete;
+
+	public:
+		/**
+		 * @brief Create the filter of \a keepPaths.
+		 * @param[in] keepPaths The paths to keep, as XmlOptions::keepPaths.
+		 */
+		explicit XmlProjection(const std::vector<std::string> &keepPaths);
+
+		/**
+		 * @brief The number of names of the longest path.
+		 */
+		size_t depth(void) const;
+
+		/**
+		 * @brief Forget the elements of the previous parse.
+		 */
+		void reset(void);
+
+		/**
+		 * @brief Tell if \a element leads to or is in a kept path.
+		 */
+		bool Enter(const xml2::XMLElement &element) override;
+
+		/**
+		 * @brief Close the last element kept.
+		 */
+		void Exit(const xml2::XMLElement &element) override;
+};
+
+#endif
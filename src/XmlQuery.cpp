@@ -0,0 +1,347 @@
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+#include "XmlQuery.hpp"
+
+
+const uint32_t XmlQuery::any;
+
+namespace
+{
+	//! @brief Tell if \a c can be part of a name.
+	inline bool isNameChar(char c)
+	{
+		return xml2::XMLUtil::IsNameChar(static_cast<unsigned char>(c));
+	}
+
+	//! @brief Tell if \a a and \a b are the same text, a null \a a being "".
+	inline bool sameText(const char *a, const std::string &b)
+	{
+		return std::strcmp(a ? a : "", b.c_str()) == 0;
+	}
+}
+
+XmlQuery::XmlQuery(const std::string &query) : source(query)
+{
+	const std::string &q = this->source;
+	size_t pos = 0;
+	const auto skipSpaces = [&]() {
+		while(pos < q.size() && q[pos] == ' ')
+		{
+			++pos;
+		}
+	};
+	const auto readName = [&]() {
+		const size_t begin = pos;
+		while(pos < q.size() && isNameChar(q[pos]))
+		{
+			++pos;
+		}
+		if (pos == begin)
+		{
+			this->fail(begin, "a name is expected");
+		}
+		return q.substr(begin, pos - begin);
+	};
+	const auto readLiteral = [&]() {
+		skipSpaces();
+		if (pos >= q.size() || (q[pos] != '\'' && q[pos] != '"'))
+		{
+			this->fail(pos, "a quoted value is expected");
+		}
+		const size_t close = q.find(q[pos], pos + 1);
+		if (close == std::string::npos)
+		{
+			this->fail(pos, "the value is not closed");
+		}
+		const std::string value = q.substr(pos + 1, close - pos - 1);
+		pos = close + 1;
+		return value;
+	};
+	const auto readEqual = [&]() {
+		skipSpaces();
+		if (pos >= q.size() || q[pos] != '=')
+		{
+			this->fail(pos, "'=' is expected");
+		}
+		++pos;
+		return readLiteral();
+	};
+
+	Op axis = OP_CHILD;
+	if (q.compare(0, 2, "//") == 0)
+	{
+		this->program.push_back({OP_ROOT, 0, 0});
+		axis = OP_DESCENDANT;
+		pos = 2;
+	}
+	else if (q.compare(0, 1, "/") == 0)
+	{
+		this->program.push_back({OP_ROOT, 0, 0});
+		pos = 1;
+	}
+	while(true)
+	{
+		// The name test.
+		if (pos < q.size() && q[pos] == '*')
+		{
+			this->program.push_back({axis, XmlQuery::any, 0});
+			++pos;
+		}
+		else
+		{
+			this->program.push_back({axis, this->store(readName()), 0});
+		}
+		// The predicates.
+		while(pos < q.size() && q[pos] == '[')
+		{
+			++pos;
+			skipSpaces();
+			if (pos < q.size() && q[pos] >= '0' && q[pos] <= '9')
+			{
+				uint32_t position = 0;
+				while(pos < q.size() && q[pos] >= '0' && q[pos] <= '9')
+				{
+					position = position*10 + static_cast<uint32_t>(q[pos] - '0');
+					++pos;
+				}
+				if (position == 0)
+				{
+					this->fail(pos, "positions start from 1");
+				}
+				this->program.push_back({OP_POSITION, position, 0});
+			}
+			else if (pos < q.size() && q[pos] == '@')
+			{
+				++pos;
+				const uint32_t att = this->store(readName());
+				skipSpaces();
+				if (pos < q.size() && q[pos] == '=')
+				{
+					this->program.push_back({OP_ATT_EQUAL, att, this->store(readEqual())});
+				}
+				else
+				{
+					this->program.push_back({OP_HAS_ATT, att, 0});
+				}
+			}
+			else if (q.compare(pos, 6, "text()") == 0 || q.compare(pos, 1, ".") == 0)
+			{
+				pos += (q[pos] == '.') ? 1 : 6;
+				this->program.push_back({OP_TEXT_EQUAL, 0, this->store(readEqual())});
+			}
+			else
+			{
+				const uint32_t child = this->store(readName());
+				this->program.push_back({OP_CHILD_EQUAL, child, this->store(readEqual())});
+			}
+			skipSpaces();
+			if (pos >= q.size() || q[pos] != ']')
+			{
+				this->fail(pos, "']' is expected");
+			}
+			++pos;
+		}
+		// The next step, if any.
+		if (pos == q.size())
+		{
+			break;
+		}
+		if (q.compare(pos, 2, "//") == 0)
+		{
+			axis = OP_DESCENDANT;
+			pos += 2;
+		}
+		else if (q[pos] == '/')
+		{
+			axis = OP_CHILD;
+			pos += 1;
+		}
+		else
+		{
+			this->fail(pos, "'/' or '[' is expected");
+		}
+	}
+	for(size_t pc = 0; pc < this->program.size(); ++pc)
+	{
+		if (this->program[pc].op == OP_CHILD || this->program[pc].op == OP_DESCENDANT)
+		{
+			this->steps.push_back(pc);
+		}
+	}
+	this->steps.push_back(this->program.size());
+	this->program.shrink_to_fit();
+	this->strings.shrink_to_fit();
+	this->steps.shrink_to_fit();
+}
+
+void XmlQuery::fail(size_t pos, const std::string &what) const
+{
+	std::cerr << "[ERROR]: in the query \"" << this->source << "\" at " << pos << " : " << what << std::endl;
+	throw std::string("Bad query");
+}
+
+uint32_t XmlQuery::store(const std::string &value)
+{
+	this->strings.push_back(value);
+	return static_cast<uint32_t>(this->strings.size() - 1);
+}
+
+bool XmlQuery::accept(const xml2::XMLElement *candidate, size_t pc, size_t end, uint32_t *counters, bool &last) const
+{
+	const Instruction &test = this->program[pc];
+	if (test.a != XmlQuery::any && !xml2::XMLUtil::StringEqual(candidate->Name(), this->strings[test.a].c_str()))
+	{
+		return false;
+	}
+	for(size_t i = pc + 1; i < end; ++i)
+	{
+		const Instruction &predicate = this->program[i];
+		switch(predicate.op)
+		{
+			case OP_POSITION:
+				// Counted only once the previous predicates agree, as XPath does.
+				if (++counters[i - pc - 1] != predicate.a)
+				{
+					return false;
+				}
+				// No later sibling can pass this predicate.
+				last = true;
+				break;
+			case OP_HAS_ATT:
+				if (candidate->FindAttribute(this->strings[predicate.a].c_str()) == nullptr)
+				{
+					return false;
+				}
+				break;
+			case OP_ATT_EQUAL:
+			{
+				const char *value = candidate->Attribute(this->strings[predicate.a].c_str());
+				if (value == nullptr || !sameText(value, this->strings[predicate.b]))
+				{
+					return false;
+				}
+				break;
+			}
+			case OP_TEXT_EQUAL:
+				if (!sameText(candidate->GetText(), this->strings[predicate.b]))
+				{
+					return false;
+				}
+				break;
+			case OP_CHILD_EQUAL:
+			{
+				const xml2::XMLElement *child = candidate->FirstChildElement(this->strings[predicate.a].c_str());
+				while(child != nullptr && !sameText(child->GetText(), this->strings[predicate.b]))
+				{
+					child = child->NextSiblingElement(this->strings[predicate.a].c_str());
+				}
+				if (child == nullptr)
+				{
+					return false;
+				}
+				break;
+			}
+			default:
+				return false;
+		}
+	}
+	return true;
+}
+
+void XmlQuery::step(size_t s, const xml2::XMLNode *from, Run &run) const
+{
+	if (s + 1 == this->steps.size())
+	{
+		run.result.emplace_back(from->ToElement());
+		return;
+	}
+	const size_t pc        = this->steps[s];
+	const size_t end       = this->steps[s + 1];
+	const size_t nCounters = end - pc - 1;
+	std::vector<uint32_t> &counters = run.counters[s];
+	bool last = false;
+
+	if (this->program[pc].op == OP_CHILD)
+	{
+		counters.assign(nCounters + 1, 0);
+		for(const xml2::XMLElement *child = from->FirstChildElement(); child != nullptr && !last; child = child->NextSiblingElement())
+		{
+			if (this->accept(child, pc, end, counters.data(), last))
+			{
+				// Depth first : the next steps run while the child is still in cache.
+				this->step(s + 1, child, run);
+			}
+		}
+		return;
+	}
+
+	// Descendants : one set of counters per open level. The nodes come in document
+	// order, so skipping the ones below the last walked node avoids any duplicate.
+	const xml2::XMLNode *up = from;
+	while(run.walked[s] != nullptr && up != nullptr && up != run.walked[s])
+	{
+		up = up->Parent();
+	}
+	if (run.walked[s] != nullptr && up == run.walked[s])
+	{
+		return;
+	}
+	run.walked[s] = from;
+
+	size_t level = 0;
+	counters.assign(nCounters + 1, 0);
+	const xml2::XMLElement *current = from->FirstChildElement();
+	while(current != nullptr)
+	{
+		if (this->accept(current, pc, end, counters.data() + level*nCounters, last))
+		{
+			this->step(s + 1, current, run);
+		}
+		const xml2::XMLElement *next = current->FirstChildElement();
+		if (next != nullptr)
+		{
+			++level;
+			counters.resize((level + 1)*nCounters + 1);
+			std::fill(counters.begin() + level*nCounters, counters.end(), 0);
+			current = next;
+			continue;
+		}
+		next = current->NextSiblingElement();
+		while(next == nullptr && level > 0)
+		{
+			--level;
+			current = current->Parent()->ToElement();
+			next    = current->NextSiblingElement();
+		}
+		current = next;
+	}
+}
+
+std::vector<XmlCursor> XmlQuery::run(const xml2::XMLNode *context) const
+{
+	Run run;
+	if (context == nullptr)
+	{
+		return run.result;
+	}
+	if (this->program[0].op == OP_ROOT)
+	{
+		context = context->GetDocument();
+	}
+	run.counters.resize(this->steps.size());
+	run.walked.assign(this->steps.size(), nullptr);
+	this->step(0, context, run);
+	return run.result;
+}
+
+bool XmlQuery::absolute(void) const
+{
+	return this->program[0].op == OP_ROOT;
+}
+
+const std::string& XmlQuery::str(void) const
+{
+	return this->source;
+}
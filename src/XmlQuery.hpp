@@ -0,0 +1,128 @@
+/**
+ * @file XmlQuery.hpp
+ * @brief Defines a compiled query, for a practical subset of XPath.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef XMLQUERY_HPP_INCLUDED
+#define XMLQUERY_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "tinyxml2.h"
+#include "XmlCursor.hpp"
+
+namespace xml2 = tinyxml2;
+
+
+/**
+ * @brief A query compiled once into a small program, then run on as many
+ * nodes as needed.
+ *
+ * The supported subset is :
+ * - \b /a/b     the \b b children of the \b a children of the document ;
+ * - \b a/b      the same, from the node the query is run on ;
+ * - \b //b, a//b every \b b below the document, or below each \b a ;
+ * - \b *        any name ;
+ * - \b [2]      the second candidate of each parent (from 1, as XPath does) ;
+ * - \b [\@id], \b [\@id='x']  having the attribute, or having it with that value ;
+ * - \b [text()='x'], \b [.='x']  having that text ;
+ * - \b [name='x']  having a child \b name with that text.
+ *
+ * Predicates can be chained, each one filtering what the previous ones kept :
+ * \b record[\@kind='k1'][2] is the second \b record of kind \b k1.
+ * @author MTLCRBN
+ */
+class XmlQuery final
+{
+	private:
+		//! @brief The instructions of the program.
+		enum Op : uint8_t
+		{
+			OP_ROOT,        //!< Start from the document of the node.
+			OP_CHILD,       //!< Step to the children named a.
+			OP_DESCENDANT,  //!< Step to the descendants named a.
+			OP_POSITION,    //!< Keep the a-th candidate of each parent.
+			OP_HAS_ATT,     //!< Keep the candidates with an attribute a.
+			OP_ATT_EQUAL,   //!< Keep the candidates whose attribute a is b.
+			OP_TEXT_EQUAL,  //!< Keep the candidates whose text is b.
+			OP_CHILD_EQUAL  //!< Keep the candidates with a child a whose text is b.
+		};
+
+		//! @brief One instruction, its operands are indexes in strings (or a position).
+		struct Instruction
+		{
+			Op       op; //!< What to do.
+			uint32_t a;  //!< The first operand.
+			uint32_t b;  //!< The second operand.
+		};
+
+		//! @brief The state of one run of the program.
+		struct Run
+		{
+			std::vector<std::vector<uint32_t> > counters; //!< The position counters, per step.
+			std::vector<const xml2::XMLNode*>   walked;   //!< The last node walked, per descendant step.
+			std::vector<XmlCursor>              result;   //!< The selected elements.
+		};
+
+		static const uint32_t any = 0xFFFFFFFF; //!< The operand of a step on any name.
+
+		std::string              source;  //!< The query, as written.
+		std::vector<Instruction> program; //!< The compiled query.
+		std::vector<std::string> strings; //!< The names and values the program uses.
+		std::vector<size_t>      steps;   //!< Where each step starts in program, then its size.
+
+		/**
+		 * @brief Print the error at \a pos in the query and throw it.
+		 */
+		[[noreturn]] void fail(size_t pos, const std::string &what) const;
+
+		/**
+		 * @brief Add \a value to the strings of the program.
+		 * @return Its index.
+		 */
+		uint32_t store(const std::string &value);
+
+		/**
+		 * @brief Tell if \a candidate passes the name test and the predicates
+		 * of the step at \a pc, and count it in \a counters (one per predicate).
+		 * \a last is set once a position is reached : the next siblings cannot pass.
+		 */
+		bool accept(const xml2::XMLElement *candidate, size_t pc, size_t end, uint32_t *counters, bool &last) const;
+
+		/**
+		 * @brief Run the step \a s from \a from, then the next steps from each
+		 * element it selects, depth first.
+		 */
+		void step(size_t s, const xml2::XMLNode *from, Run &run) const;
+
+	public:
+		/**
+		 * @brief Compile \a query.
+		 * @param[in] query The query, in the subset described above.
+		 * @throw std::string if \a query is not in the subset.
+		 */
+		explicit XmlQuery(const std::string &query);
+
+		/**
+		 * @brief Run the query from \a context.
+		 * @param[in] context The node relative queries start from.
+		 * @return The selected elements, without duplicates, in document order
+		 * for each node the last step started from.
+		 */
+		std::vector<XmlCursor> run(const xml2::XMLNode *context) const;
+
+		/**
+		 * @brief Tell if the query starts from the document, whatever node it is run on.
+		 */
+		bool absolute(void) const;
+
+		/**
+		 * @brief Get the query, as written.
+		 */
+		const std::string& str(void) const;
+};
+
+#endif
@@ -0,0 +1,1503 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <climits>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "XmlSchema.hpp"
+
+
+namespace
+{
+	const char *const XSD = "http://www.w3.org/2001/XMLSchema"; //!< The namespace of the schemas.
+
+	const unsigned UNBOUNDED  = UINT_MAX; //!< maxOccurs="unbounded".
+	const size_t   MAX_NFA    = 1 << 16;  //!< The states of the automaton of a content, before it is determinized.
+	const size_t   MAX_DFA    = 1 << 14;  //!< The states of the automaton of a content.
+	const unsigned MAX_DEPTH  = 64;       //!< The derivations of a type.
+	const size_t   MAX_QUOTED = 40;       //!< The characters of a value quoted by the errors.
+	const uint32_t MAX_SCAN   = 8;        //!< The columns compared one by one, rather than through the atoms.
+
+	/**
+	 * @brief Get the local part of the name \a name.
+	 */
+	const char* local(const char *name)
+	{
+		const char *colon = strchr(name, ':');
+		return (colon == nullptr) ? name : colon + 1;
+	}
+
+	/**
+	 * @brief Tell if \a element is the element of schema \a name, whatever its prefix.
+	 */
+	bool is(const xml2::XMLElement *element, const char *name)
+	{
+		return strcmp(local(element->Name()), name) == 0;
+	}
+
+	/**
+	 * @brief Tell if \a c is a blank, as XML defines it.
+	 */
+	bool blank(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	/**
+	 * @brief Tell if \a text is only made of blanks.
+	 */
+	bool blank(const char *text)
+	{
+		while(blank(*text))
+		{
+			++text;
+		}
+		return *text == '\0';
+	}
+
+	/**
+	 * @brief Skip the digits from \a at.
+	 * @return The number of digits skipped.
+	 */
+	size_t digits(const char *&at, const char *end)
+	{
+		const char *begin = at;
+		while(at < end && *at >= '0' && *at <= '9')
+		{
+			++at;
+		}
+		return static_cast<size_t>(at - begin);
+	}
+
+	/**
+	 * @brief Read the number in [\a begin, \a end), checked beforehand.
+	 * Up to 15 digits without exponent, it is exact as a double, and so is
+	 * its division by a power of ten : strtod() is only called beyond.
+	 */
+	double number(const char *begin, const char *end)
+	{
+		static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+		const char *at = begin;
+		const bool negative = at < end && *at == '-';
+		at += (at < end && (*at == '+' || *at == '-')) ? 1 : 0;
+		uint64_t mantissa = 0;
+		size_t count    = 0;
+		size_t fraction = 0;
+		bool dot = false;
+		for(; at < end && count <= 15; ++at)
+		{
+			if (*at == '.' && !dot)
+			{
+				dot = true;
+				continue;
+			}
+			if (*at < '0' || *at > '9')
+			{
+				break;
+			}
+			mantissa  = mantissa * 10 + static_cast<uint64_t>(*at - '0');
+			count    += 1;
+			fraction += dot ? 1 : 0;
+		}
+		if (at != end || count > 15)
+		{
+			return strtod(begin, nullptr);
+		}
+		const double value = static_cast<double>(mantissa) / powers[fraction];
+		return negative ? -value : value;
+	}
+
+	/**
+	 * @brief Quote \a value for an error, cut if it is long.
+	 */
+	std::string quote(const char *begin, const char *end)
+	{
+		if (static_cast<size_t>(end - begin) > MAX_QUOTED)
+		{
+			return "'" + std::string(begin, MAX_QUOTED) + "...'";
+		}
+		return "'" + std::string(begin, end) + "'";
+	}
+}
+
+
+/**
+ * @brief Compile the schema : the types are compiled as the declarations of
+ * element reach them, a complex type once at a time, so that the recursive
+ * ones need no recursion.
+ */
+class XmlSchema::Compiler final
+{
+	private:
+		//! @brief A transition of the automaton being built, -1 for an empty one.
+		struct Edge
+		{
+			int32_t symbol; //!< The column read.
+			int32_t to;     //!< The next state.
+		};
+
+		//! @brief A part of the automaton being built, from one state to another.
+		struct Fragment
+		{
+			int32_t begin; //!< Its first state.
+			int32_t end;   //!< Its last state.
+		};
+
+		typedef std::unordered_map<std::string, const xml2::XMLElement*> Globals;
+
+		XmlSchema                                                 &schema;         //!< What is compiled.
+		const std::string                                         &fname;          //!< The file of the schema, for the errors.
+		std::unordered_map<std::string, std::string>              spaces;          //!< The namespace of each prefix of the root.
+		Globals                                                   elements;        //!< The global elements, by name.
+		Globals                                                   complexes;       //!< The named complex types.
+		Globals                                                   simples;         //!< The named simple types.
+		Globals                                                   groups;          //!< The named groups.
+		Globals                                                   attributeGroups; //!< The named groups of attributes.
+		Globals                                                   attributes;      //!< The global attributes.
+		std::unordered_map<const xml2::XMLElement*, int32_t>      declOf;          //!< The declaration of each xs:element.
+		std::unordered_map<const xml2::XMLElement*, int32_t>      complexOf;       //!< The type of each xs:complexType.
+		std::unordered_map<const xml2::XMLElement*, int32_t>      simpleOf;        //!< The type of each xs:simpleType.
+		std::unordered_map<std::string, int32_t>                  builtins;        //!< The type of each builtin used.
+		std::unordered_set<const xml2::XMLElement*>               deriving;        //!< The simple types being compiled.
+		std::vector<std::pair<int32_t, const xml2::XMLElement*> > pending;         //!< The complex types left to compile.
+		std::vector<std::vector<Edge> >                           nfa;             //!< The automaton being built.
+		std::vector<int32_t>                                      childOf;         //!< The declaration of each of its columns.
+		std::unordered_map<uint32_t, int32_t>                     columns;         //!< The column of each atom in it.
+
+		/**
+		 * @brief Print the error \a what about \a node, and throw.
+		 */
+		[[noreturn]] void fail(const xml2::XMLElement *node, const std::string &what) const
+		{
+			std::cerr << "[ERROR]: in the schema " << this->fname;
+			if (node != nullptr && node->SourceLine() > 0)
+			{
+				std::cerr << " at line " << node->SourceLine();
+			}
+			std::cerr << " : " << what << std::endl;
+			throw std::string("Bad schema");
+		}
+
+		/**
+		 * @brief Get the attribute \a name of \a node, which is required.
+		 */
+		const char* required(const xml2::XMLElement *node, const char *name) const
+		{
+			const char *value = node->Attribute(name);
+			if (value == nullptr)
+			{
+				this->fail(node, std::string("<") + node->Name() + "> has no " + name);
+			}
+			return value;
+		}
+
+		/**
+		 * @brief Find the global \a qname in \a globals, which must be there.
+		 */
+		const xml2::XMLElement* global(const Globals &globals, const xml2::XMLElement *node, const char *qname) const
+		{
+			const Globals::const_iterator found = globals.find(local(qname));
+			if (found == globals.end())
+			{
+				this->fail(node, std::string("nothing named ") + qname + " is declared for <" + node->Name() + ">");
+			}
+			return found->second;
+		}
+
+		/**
+		 * @brief Tell if the prefix of \a qname is bound to the namespace of the schemas.
+		 */
+		bool builtin(const char *qname) const
+		{
+			const char *colon = strchr(qname, ':');
+			const std::string prefix = (colon == nullptr) ? std::string() : std::string(qname, colon);
+			const std::unordered_map<std::string, std::string>::const_iterator found = this->spaces.find(prefix);
+			return found != this->spaces.end() && found->second == XSD;
+		}
+
+		/**
+		 * @brief Read \a node's minOccurs and maxOccurs.
+		 */
+		void occurs(const xml2::XMLElement *node, unsigned &min, unsigned &max) const
+		{
+			min = this->count(node, "minOccurs", 1);
+			max = this->count(node, "maxOccurs", 1);
+			if (max < min)
+			{
+				this->fail(node, "maxOccurs is less than minOccurs");
+			}
+		}
+
+		/**
+		 * @brief Read the count \a name of \a node, \a fallback if it has none.
+		 */
+		unsigned count(const xml2::XMLElement *node, const char *name, unsigned fallback) const
+		{
+			const char *value = node->Attribute(name);
+			if (value == nullptr)
+			{
+				return fallback;
+			}
+			if (strcmp(value, "unbounded") == 0)
+			{
+				return UNBOUNDED;
+			}
+			char *end = nullptr;
+			const unsigned long parsed = strtoul(value, &end, 10);
+			if (end == value || *end != '\0' || *value == '-' || parsed >= UNBOUNDED)
+			{
+				this->fail(node, std::string("bad ") + name + " '" + value + "'");
+			}
+			return static_cast<unsigned>(parsed);
+		}
+
+		/**
+		 * @brief Read the bound \a value of a facet.
+		 */
+		double bound(const xml2::XMLElement *node, const char *value) const
+		{
+			char *end = nullptr;
+			const double parsed = strtod(value, &end);
+			if (end == value || *end != '\0')
+			{
+				this->fail(node, std::string("bad bound '") + value + "'");
+			}
+			return parsed;
+		}
+
+		/**
+		 * @brief Get the declaration of the xs:element \a node (or of what it refers to).
+		 */
+		int32_t declaration(const xml2::XMLElement *node)
+		{
+			const char *ref = node->Attribute("ref");
+			if (ref != nullptr)
+			{
+				node = this->global(this->elements, node, ref);
+			}
+			const std::unordered_map<const xml2::XMLElement*, int32_t>::const_iterator found = this->declOf.find(node);
+			if (found != this->declOf.end())
+			{
+				return found->second;
+			}
+			const int32_t decl = static_cast<int32_t>(this->schema.elements.size());
+			this->declOf[node] = decl;
+			Element element;
+			element.name     = this->schema.atoms.intern(this->required(node, "name"));
+			element.fallback = node->Attribute("default") != nullptr || node->Attribute("fixed") != nullptr;
+			const char *type = node->Attribute("type");
+			if (type != nullptr)
+			{
+				this->resolve(node, type, element.complex, element.simple);
+			}
+			for(const xml2::XMLElement *child = node->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+			{
+				if (is(child, "complexType") && type == nullptr)
+				{
+					element.complex = this->complexType(child);
+				}
+				else if (is(child, "simpleType") && type == nullptr)
+				{
+					element.simple = this->simpleType(child);
+				}
+				else if (!is(child, "annotation"))
+				{
+					// The identity constraints (xs:unique, xs:key, xs:keyref) among them.
+					this->fail(child, std::string("<") + child->Name() + "> is not supported");
+				}
+			}
+			this->schema.elements.push_back(element);
+			return decl;
+		}
+
+		/**
+		 * @brief Find the type named \a qname, for \a node.
+		 * @param[out] complex Its index if it is complex, else -1.
+		 * @param[out] simple  Its index if it is simple, else -1 (both -1 : xs:anyType).
+		 */
+		void resolve(const xml2::XMLElement *node, const char *qname, int32_t &complex, int32_t &simple)
+		{
+			complex = simple = -1;
+			if (this->builtin(qname))
+			{
+				if (strcmp(local(qname), "anyType") != 0)
+				{
+					simple = this->builtinType(local(qname));
+				}
+				return;
+			}
+			const Globals::const_iterator found = this->complexes.find(local(qname));
+			if (found != this->complexes.end())
+			{
+				complex = this->complexType(found->second);
+				return;
+			}
+			simple = this->simpleType(this->global(this->simples, node, qname));
+		}
+
+		/**
+		 * @brief Get the simple type named \a qname, for \a node.
+		 */
+		int32_t simpleNamed(const xml2::XMLElement *node, const char *qname)
+		{
+			if (this->builtin(qname))
+			{
+				if (strcmp(local(qname), "anyType") == 0)
+				{
+					this->fail(node, "xs:anyType is not a simple type");
+				}
+				return this->builtinType(local(qname));
+			}
+			return this->simpleType(this->global(this->simples, node, qname));
+		}
+
+		/**
+		 * @brief Get the builtin type \a name.
+		 */
+		int32_t builtinType(const std::string &name)
+		{
+			const std::unordered_map<std::string, int32_t>::const_iterator found = this->builtins.find(name);
+			if (found != this->builtins.end())
+			{
+				return found->second;
+			}
+			//! @brief The bounds of an integer type.
+			struct Range
+			{
+				const char *name;   //!< Its name.
+				bool        minSet; //!< If it has a lower bound.
+				double      min;    //!< Its lower bound.
+				bool        maxSet; //!< If it has an upper bound.
+				double      max;    //!< Its upper bound.
+			};
+			static const Range ranges[] =
+			{
+				{"integer",            false, 0,                      false, 0},
+				{"long",               true,  -9223372036854775808.0, true,  9223372036854775807.0},
+				{"int",                true,  -2147483648.0,          true,  2147483647.0},
+				{"short",              true,  -32768,                 true,  32767},
+				{"byte",               true,  -128,                   true,  127},
+				{"nonNegativeInteger", true,  0,                      false, 0},
+				{"positiveInteger",    true,  1,                      false, 0},
+				{"nonPositiveInteger", false, 0,                      true,  0},
+				{"negativeInteger",    false, 0,                      true,  -1},
+				{"unsignedLong",       true,  0,                      true,  18446744073709551615.0},
+				{"unsignedInt",        true,  0,                      true,  4294967295.0},
+				{"unsignedShort",      true,  0,                      true,  65535},
+				{"unsignedByte",       true,  0,                      true,  255}
+			};
+			Simple type;
+			type.name = "xs:" + name;
+			type.trim = name != "string" && name != "normalizedString" && name != "anySimpleType";
+			if (name == "boolean")
+			{
+				type.base = Simple::BOOLEAN;
+			}
+			else if (name == "decimal")
+			{
+				type.base = Simple::DECIMAL;
+			}
+			else if (name == "float" || name == "double")
+			{
+				type.base = Simple::FLOAT;
+			}
+			for(const Range &range : ranges)
+			{
+				if (name == range.name)
+				{
+					type.base   = Simple::INTEGER;
+					type.minSet = range.minSet;
+					type.min    = range.min;
+					type.maxSet = range.maxSet;
+					type.max    = range.max;
+				}
+			}
+			const int32_t index = static_cast<int32_t>(this->schema.simples.size());
+			this->schema.simples.push_back(type);
+			this->builtins[name] = index;
+			return index;
+		}
+
+		/**
+		 * @brief Compile the xs:simpleType \a node, with the facets of the types it derives from.
+		 */
+		int32_t simpleType(const xml2::XMLElement *node)
+		{
+			const std::unordered_map<const xml2::XMLElement*, int32_t>::const_iterator found = this->simpleOf.find(node);
+			if (found != this->simpleOf.end())
+			{
+				return found->second;
+			}
+			if (!this->deriving.insert(node).second || this->deriving.size() > MAX_DEPTH)
+			{
+				this->fail(node, "the simple type derives from itself");
+			}
+			Simple type;
+			const xml2::XMLElement *restriction = nullptr;
+			for(const xml2::XMLElement *child = node->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+			{
+				if (is(child, "restriction"))
+				{
+					restriction = child;
+				}
+				else if (is(child, "list") || is(child, "union"))
+				{
+					type.base = Simple::TEXT;
+				}
+			}
+			if (restriction != nullptr)
+			{
+				type = this->restrict(restriction);
+			}
+			const char *name = node->Attribute("name");
+			type.name = (name == nullptr) ? "an anonymous type" : name;
+			this->deriving.erase(node);
+			const int32_t index = static_cast<int32_t>(this->schema.simples.size());
+			this->schema.simples.push_back(type);
+			this->simpleOf[node] = index;
+			return index;
+		}
+
+		/**
+		 * @brief Compile the xs:restriction \a node of a simple type : its base, and its facets.
+		 */
+		Simple restrict(const xml2::XMLElement *node)
+		{
+			Simple type;
+			const char *base = node->Attribute("base");
+			if (base != nullptr)
+			{
+				type = this->schema.simples[this->simpleNamed(node, base)];
+			}
+			std::vector<std::string> enumeration;
+			std::string pattern;
+			for(const xml2::XMLElement *facet = node->FirstChildElement(); facet != nullptr; facet = facet->NextSiblingElement())
+			{
+				const char *value = facet->Attribute("value");
+				if (is(facet, "simpleType") && base == nullptr)
+				{
+					type = this->schema.simples[this->simpleType(facet)];
+					continue;
+				}
+				if (is(facet, "annotation") || is(facet, "totalDigits") || is(facet, "fractionDigits"))
+				{
+					continue;
+				}
+				if (value == nullptr)
+				{
+					this->fail(facet, std::string("the facet <") + facet->Name() + "> has no value");
+				}
+				if (is(facet, "enumeration"))
+				{
+					enumeration.push_back(value);
+				}
+				else if (is(facet, "pattern"))
+				{
+					// The patterns of one step are alternatives, the ones of each step must all match.
+					pattern += (pattern.empty() ? "(?:" : "|(?:") + std::string(value) + ")";
+				}
+				else if (is(facet, "minInclusive") || is(facet, "minExclusive"))
+				{
+					type.minSet       = true;
+					type.min          = this->bound(facet, value);
+					type.minExclusive = is(facet, "minExclusive");
+				}
+				else if (is(facet, "maxInclusive") || is(facet, "maxExclusive"))
+				{
+					type.maxSet       = true;
+					type.max          = this->bound(facet, value);
+					type.maxExclusive = is(facet, "maxExclusive");
+				}
+				else if (is(facet, "length"))
+				{
+					type.minLength = type.maxLength = static_cast<size_t>(this->count(facet, "value", 0));
+				}
+				else if (is(facet, "minLength"))
+				{
+					type.minLength = static_cast<size_t>(this->count(facet, "value", 0));
+				}
+				else if (is(facet, "maxLength"))
+				{
+					type.maxLength = static_cast<size_t>(this->count(facet, "value", 0));
+				}
+				else if (is(facet, "whiteSpace"))
+				{
+					type.trim = strcmp(value, "collapse") == 0 || type.trim;
+				}
+				else
+				{
+					this->fail(facet, std::string("the facet <") + facet->Name() + "> is not supported");
+				}
+			}
+			if (!enumeration.empty())
+			{
+				type.enumeration = enumeration;
+			}
+			if (!pattern.empty())
+			{
+				try
+				{
+					type.patterns.push_back(std::regex(pattern, std::regex::ECMAScript | std::regex::optimize));
+				}
+				catch(const std::regex_error &)
+				{
+					this->fail(node, "the pattern " + pattern + " is not supported");
+				}
+			}
+			return type;
+		}
+
+		/**
+		 * @brief Get the index of the xs:complexType \a node, compiled later.
+		 */
+		int32_t complexType(const xml2::XMLElement *node)
+		{
+			const std::unordered_map<const xml2::XMLElement*, int32_t>::const_iterator found = this->complexOf.find(node);
+			if (found != this->complexOf.end())
+			{
+				return found->second;
+			}
+			const int32_t index = static_cast<int32_t>(this->schema.complexes.size());
+			this->schema.complexes.push_back(Complex());
+			this->complexOf[node] = index;
+			this->pending.push_back(std::make_pair(index, node));
+			return index;
+		}
+
+		/**
+		 * @brief Add the attribute \a node to \a list, replacing the one of the same name.
+		 */
+		void attribute(const xml2::XMLElement *node, std::vector<Attribute> &list)
+		{
+			const char *ref = node->Attribute("ref");
+			const xml2::XMLElement *declared = (ref == nullptr) ? node : this->global(this->attributes, node, ref);
+			Attribute attribute;
+			attribute.name     = local(this->required(declared, "name"));
+			attribute.required = node->Attribute("use", "required") != nullptr;
+			attribute.simple   = -1;
+			const char *type = declared->Attribute("type");
+			if (type != nullptr)
+			{
+				attribute.simple = this->simpleNamed(declared, type);
+			}
+			const xml2::XMLElement *inline_ = declared->FirstChildElement();
+			for(; inline_ != nullptr && type == nullptr; inline_ = inline_->NextSiblingElement())
+			{
+				if (is(inline_, "simpleType"))
+				{
+					attribute.simple = this->simpleType(inline_);
+				}
+			}
+			if (attribute.simple < 0)
+			{
+				attribute.simple = this->builtinType("anySimpleType");
+			}
+			for(std::vector<Attribute>::iterator it = list.begin(); it != list.end(); ++it)
+			{
+				if (it->name == attribute.name)
+				{
+					list.erase(it);
+					break;
+				}
+			}
+			if (node->Attribute("use", "prohibited") == nullptr)
+			{
+				list.push_back(attribute);
+			}
+		}
+
+		/**
+		 * @brief Collect the attributes, the groups of particles and the simple content of
+		 * the complex type (or extension, or group of attributes) \a node, with the ones of
+		 * the types it derives from.
+		 */
+		void content(const xml2::XMLElement *node, Complex &type, std::vector<const xml2::XMLElement*> &models, unsigned depth)
+		{
+			if (depth > MAX_DEPTH)
+			{
+				this->fail(node, "the type derives from itself");
+			}
+			if (node->BoolAttribute("mixed"))
+			{
+				type.mixed = true;
+			}
+			for(const xml2::XMLElement *child = node->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+			{
+				if (is(child, "sequence") || is(child, "choice") || is(child, "group"))
+				{
+					models.push_back(child);
+				}
+				else if (is(child, "attribute"))
+				{
+					this->attribute(child, type.attributes);
+				}
+				else if (is(child, "attributeGroup"))
+				{
+					this->content(this->global(this->attributeGroups, child, this->required(child, "ref")), type, models, depth + 1);
+				}
+				else if (is(child, "anyAttribute"))
+				{
+					type.anyAttribute = true;
+				}
+				else if (is(child, "simpleContent"))
+				{
+					this->simpleContent(child, type, depth);
+				}
+				else if (is(child, "complexContent"))
+				{
+					this->complexContent(child, type, models, depth);
+				}
+				else if (!is(child, "annotation"))
+				{
+					this->fail(child, std::string("<") + child->Name() + "> is not supported");
+				}
+			}
+		}
+
+		/**
+		 * @brief Collect the xs:simpleContent \a node : it must extend a simple type.
+		 */
+		void simpleContent(const xml2::XMLElement *node, Complex &type, unsigned depth)
+		{
+			const xml2::XMLElement *extension = node->FirstChildElement();
+			while(extension != nullptr && is(extension, "annotation"))
+			{
+				extension = extension->NextSiblingElement();
+			}
+			if (extension == nullptr || !is(extension, "extension"))
+			{
+				this->fail(node, "only the extension of a simple type is supported as simple content");
+			}
+			const char *base = this->required(extension, "base");
+			if (!this->builtin(base) && this->simples.find(local(base)) == this->simples.end())
+			{
+				this->fail(extension, std::string("the simple content extends ") + base + ", which is not a simple type");
+			}
+			type.simple = this->simpleNamed(extension, base);
+			std::vector<const xml2::XMLElement*> models;
+			this->content(extension, type, models, depth + 1);
+			if (!models.empty())
+			{
+				this->fail(extension, "a simple content cannot have elements");
+			}
+		}
+
+		/**
+		 * @brief Collect the xs:complexContent \a node : the base type, then what the extension
+		 * adds, or only what the restriction restates (but the attributes of the base type).
+		 */
+		void complexContent(const xml2::XMLElement *node, Complex &type, std::vector<const xml2::XMLElement*> &models, unsigned depth)
+		{
+			if (node->BoolAttribute("mixed"))
+			{
+				type.mixed = true;
+			}
+			for(const xml2::XMLElement *derived = node->FirstChildElement(); derived != nullptr; derived = derived->NextSiblingElement())
+			{
+				if (is(derived, "annotation"))
+				{
+					continue;
+				}
+				const char *base = this->required(derived, "base");
+				std::vector<const xml2::XMLElement*> inherited;
+				if (!this->builtin(base))
+				{
+					this->content(this->global(this->complexes, derived, base), type, inherited, depth + 1);
+				}
+				if (is(derived, "extension"))
+				{
+					models.insert(models.end(), inherited.begin(), inherited.end());
+				}
+				else if (!is(derived, "restriction"))
+				{
+					this->fail(derived, std::string("<") + derived->Name() + "> is not supported");
+				}
+				this->content(derived, type, models, depth + 1);
+			}
+		}
+
+		/**
+		 * @brief Add a state to the automaton being built.
+		 */
+		int32_t state(const xml2::XMLElement *node)
+		{
+			if (this->nfa.size() >= MAX_NFA)
+			{
+				this->fail(node, "the content model is too large");
+			}
+			this->nfa.push_back(std::vector<Edge>());
+			return static_cast<int32_t>(this->nfa.size() - 1);
+		}
+
+		/**
+		 * @brief Add a transition to the automaton being built.
+		 */
+		void edge(int32_t from, int32_t symbol, int32_t to)
+		{
+			this->nfa[static_cast<size_t>(from)].push_back({symbol, to});
+		}
+
+		/**
+		 * @brief Get the column of the declaration \a decl in the type being built.
+		 */
+		int32_t column(const xml2::XMLElement *node, int32_t decl)
+		{
+			const Element &element = this->schema.elements[static_cast<size_t>(decl)];
+			const std::unordered_map<uint32_t, int32_t>::const_iterator found = this->columns.find(element.name);
+			if (found == this->columns.end())
+			{
+				const int32_t column = static_cast<int32_t>(this->childOf.size());
+				this->childOf.push_back(decl);
+				this->columns[element.name] = column;
+				return column;
+			}
+			const Element &other = this->schema.elements[static_cast<size_t>(this->childOf[static_cast<size_t>(found->second)])];
+			if (other.complex != element.complex || other.simple != element.simple)
+			{
+				this->fail(node, "<" + this->schema.atoms.name(element.name) + "> is declared with two types in the same content");
+			}
+			return found->second;
+		}
+
+		/**
+		 * @brief Build the particle \a node, repeated as its minOccurs and maxOccurs tell.
+		 */
+		Fragment particle(const xml2::XMLElement *node)
+		{
+			unsigned min = 0;
+			unsigned max = 0;
+			this->occurs(node, min, max);
+			Fragment whole;
+			whole.begin = whole.end = this->state(node);
+			for(unsigned i = 0; i < min; ++i)
+			{
+				const Fragment once = this->single(node);
+				this->edge(whole.end, -1, once.begin);
+				whole.end = once.end;
+			}
+			if (max == UNBOUNDED)
+			{
+				const Fragment once = this->single(node);
+				const int32_t loop = this->state(node);
+				this->edge(whole.end, -1, loop);
+				this->edge(loop, -1, once.begin);
+				this->edge(once.end, -1, loop);
+				whole.end = loop;
+				return whole;
+			}
+			for(unsigned i = min; i < max; ++i)
+			{
+				const Fragment once = this->single(node);
+				const int32_t end = this->state(node);
+				this->edge(whole.end, -1, once.begin);
+				this->edge(whole.end, -1, end);
+				this->edge(once.end, -1, end);
+				whole.end = end;
+			}
+			return whole;
+		}
+
+		/**
+		 * @brief Build the particle \a node once.
+		 */
+		Fragment single(const xml2::XMLElement *node)
+		{
+			Fragment fragment;
+			fragment.begin = this->state(node);
+			if (is(node, "element"))
+			{
+				const int32_t column = this->column(node, this->declaration(node));
+				fragment.end = this->state(node);
+				this->edge(fragment.begin, column, fragment.end);
+				return fragment;
+			}
+			if (is(node, "group"))
+			{
+				const xml2::XMLElement *group = this->global(this->groups, node, this->required(node, "ref"));
+				const xml2::XMLElement *model = group->FirstChildElement();
+				while(model != nullptr && is(model, "annotation"))
+				{
+					model = model->NextSiblingElement();
+				}
+				if (model == nullptr || !(is(model, "sequence") || is(model, "choice")))
+				{
+					this->fail(group, "only a group of xs:sequence or xs:choice is supported");
+				}
+				const Fragment inner = this->particle(model);
+				this->edge(fragment.begin, -1, inner.begin);
+				fragment.end = inner.end;
+				return fragment;
+			}
+			const bool choice = is(node, "choice");
+			if (!choice && !is(node, "sequence"))
+			{
+				this->fail(node, std::string("<") + node->Name() + "> is not supported");
+			}
+			fragment.end = choice ? this->state(node) : fragment.begin;
+			for(const xml2::XMLElement *child = node->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+			{
+				if (is(child, "annotation"))
+				{
+					continue;
+				}
+				const Fragment inner = this->particle(child);
+				if (choice)
+				{
+					this->edge(fragment.begin, -1, inner.begin);
+					this->edge(inner.end, -1, fragment.end);
+				}
+				else
+				{
+					this->edge(fragment.end, -1, inner.begin);
+					fragment.end = inner.end;
+				}
+			}
+			return fragment;
+		}
+
+		/**
+		 * @brief Add to \a set the states reached from it without reading anything.
+		 */
+		void closure(std::vector<int32_t> &set) const
+		{
+			std::vector<int32_t> todo(set);
+			std::vector<uint8_t> seen(this->nfa.size(), 0);
+			for(int32_t state : set)
+			{
+				seen[static_cast<size_t>(state)] = 1;
+			}
+			while(!todo.empty())
+			{
+				const int32_t state = todo.back();
+				todo.pop_back();
+				for(const Edge &edge : this->nfa[static_cast<size_t>(state)])
+				{
+					if (edge.symbol < 0 && !seen[static_cast<size_t>(edge.to)])
+					{
+						seen[static_cast<size_t>(edge.to)] = 1;
+						set.push_back(edge.to);
+						todo.push_back(edge.to);
+					}
+				}
+			}
+			std::sort(set.begin(), set.end());
+		}
+
+		/**
+		 * @brief Turn the automaton built, from \a begin to \a accept, into the table of \a type.
+		 */
+		void determinize(const xml2::XMLElement *node, int32_t begin, int32_t accept, Complex &type) const
+		{
+			type.columns = static_cast<uint32_t>(this->childOf.size());
+			type.childOf = this->childOf;
+			std::map<std::vector<int32_t>, int32_t> ids;
+			std::vector<std::vector<int32_t> > sets(1, std::vector<int32_t>(1, begin));
+			this->closure(sets[0]);
+			ids[sets[0]] = 0;
+			for(size_t current = 0; current < sets.size(); ++current)
+			{
+				const std::vector<int32_t> from = sets[current];
+				type.accepting.push_back(std::binary_search(from.begin(), from.end(), accept) ? 1 : 0);
+				for(uint32_t column = 0; column < type.columns; ++column)
+				{
+					std::vector<int32_t> next;
+					for(int32_t state : from)
+					{
+						for(const Edge &edge : this->nfa[static_cast<size_t>(state)])
+						{
+							if (edge.symbol == static_cast<int32_t>(column))
+							{
+								next.push_back(edge.to);
+							}
+						}
+					}
+					if (next.empty())
+					{
+						type.table.push_back(-1);
+						continue;
+					}
+					std::sort(next.begin(), next.end());
+					next.erase(std::unique(next.begin(), next.end()), next.end());
+					this->closure(next);
+					const std::map<std::vector<int32_t>, int32_t>::const_iterator found = ids.find(next);
+					if (found != ids.end())
+					{
+						type.table.push_back(found->second);
+						continue;
+					}
+					if (sets.size() >= MAX_DFA)
+					{
+						this->fail(node, "the content model is too large");
+					}
+					const int32_t id = static_cast<int32_t>(sets.size());
+					ids[next] = id;
+					sets.push_back(next);
+					type.table.push_back(id);
+				}
+			}
+		}
+
+		/**
+		 * @brief Compile the complex type \a index, of the xs:complexType \a node.
+		 */
+		void compile(int32_t index, const xml2::XMLElement *node)
+		{
+			Complex type;
+			std::vector<const xml2::XMLElement*> models;
+			this->content(node, type, models, 0);
+			if (type.attributes.size() > 64)
+			{
+				this->fail(node, "more than 64 attributes are not supported");
+			}
+			for(size_t i = 0; i < type.attributes.size(); ++i)
+			{
+				if (type.attributes[i].required)
+				{
+					type.required |= uint64_t(1) << i;
+				}
+			}
+			this->nfa.clear();
+			this->childOf.clear();
+			this->columns.clear();
+			const int32_t begin = this->state(node);
+			int32_t end = begin;
+			for(const xml2::XMLElement *model : models)
+			{
+				const Fragment fragment = this->particle(model);
+				this->edge(end, -1, fragment.begin);
+				end = fragment.end;
+			}
+			this->determinize(node, begin, end, type);
+			this->schema.complexes[static_cast<size_t>(index)] = type;
+		}
+
+	public:
+		/**
+		 * @brief Prepare the compilation into \a schema of the file \a fname.
+		 */
+		Compiler(XmlSchema &schema, const std::string &fname) : schema(schema), fname(fname)
+		{
+
+		}
+
+		/**
+		 * @brief Compile the schema whose root is \a root, into the schema.
+		 */
+		void run(const xml2::XMLElement *root)
+		{
+			if (root == nullptr || !is(root, "schema"))
+			{
+				this->fail(root, "the root is not <xs:schema>");
+			}
+			for(const xml2::XMLAttribute *attribute = root->FirstAttribute(); attribute != nullptr; attribute = attribute->Next())
+			{
+				if (strcmp(attribute->Name(), "xmlns") == 0)
+				{
+					this->spaces[""] = attribute->Value();
+				}
+				else if (strncmp(attribute->Name(), "xmlns:", 6) == 0)
+				{
+					this->spaces[attribute->Name() + 6] = attribute->Value();
+				}
+			}
+			for(const xml2::XMLElement *child = root->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+			{
+				Globals *globals = is(child, "element")        ? &this->elements        :
+				                   is(child, "complexType")    ? &this->complexes       :
+				                   is(child, "simpleType")     ? &this->simples         :
+				                   is(child, "group")          ? &this->groups          :
+				                   is(child, "attributeGroup") ? &this->attributeGroups :
+				                   is(child, "attribute")      ? &this->attributes      : nullptr;
+				if (globals != nullptr)
+				{
+					(*globals)[this->required(child, "name")] = child;
+				}
+				else if (!is(child, "annotation"))
+				{
+					this->fail(child, std::string("<") + child->Name() + "> is not supported");
+				}
+			}
+			std::vector<int32_t> roots;
+			for(const xml2::XMLElement *child = root->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+			{
+				if (is(child, "element"))
+				{
+					roots.push_back(this->declaration(child));
+				}
+			}
+			while(!this->pending.empty())
+			{
+				const std::pair<int32_t, const xml2::XMLElement*> next = this->pending.back();
+				this->pending.pop_back();
+				this->compile(next.first, next.second);
+			}
+			const size_t atoms = this->schema.atoms.size();
+			this->schema.roots.assign(atoms, -1);
+			for(int32_t decl : roots)
+			{
+				this->schema.roots[this->schema.elements[static_cast<size_t>(decl)].name] = decl;
+			}
+			for(Complex &type : this->schema.complexes)
+			{
+				type.columnOf.assign(atoms, -1);
+				for(uint32_t column = 0; column < type.columns; ++column)
+				{
+					const uint32_t atom = this->schema.elements[static_cast<size_t>(type.childOf[column])].name;
+					type.columnOf[atom] = static_cast<int32_t>(column);
+					type.names.push_back(this->schema.atoms.name(atom));
+				}
+			}
+		}
+};
+
+
+XmlSchema::XmlSchema(const std::string &fname)
+{
+	xml2::XMLDocument doc;
+	doc.SetTrackLines(true);
+	if (doc.LoadFile(fname.c_str()) != xml2::XML_SUCCESS)
+	{
+		std::cerr << "[ERROR]: while loading the schema " << fname << std::endl;
+		throw std::string("File not found");
+	}
+	Compiler(*this, fname).run(doc.RootElement());
+}
+
+bool XmlSchema::validate(const xml2::XMLElement *root, std::string &error) const
+{
+	error.clear();
+	const int32_t decl = this->rootOf(root, error);
+	return decl >= 0 && this->check(root, decl, error);
+}
+
+bool XmlSchema::validateRecord(const xml2::XMLElement *root, std::string &error) const
+{
+	error.clear();
+	const int32_t decl = this->rootOf(root, error);
+	if (decl < 0)
+	{
+		return false;
+	}
+	const Element &declared = this->elements[static_cast<size_t>(decl)];
+	if (declared.complex < 0 || this->complexes[static_cast<size_t>(declared.complex)].simple >= 0)
+	{
+		return this->check(root, decl, error);
+	}
+	const Complex &type = this->complexes[static_cast<size_t>(declared.complex)];
+	if (!this->attributes(root, &type, error))
+	{
+		return false;
+	}
+	for(const xml2::XMLNode *node = root->FirstChild(); node != nullptr; node = node->NextSibling())
+	{
+		const xml2::XMLElement *child = node->ToElement();
+		if (child == nullptr)
+		{
+			if (!type.mixed && node->ToText() != nullptr && !blank(node->Value()))
+			{
+				return this->fail(root, "text is not allowed in <" + std::string(root->Name()) + ">", error);
+			}
+			continue;
+		}
+		const int32_t column = this->columnOf(type, child);
+		if (column < 0)
+		{
+			return this->fail(child, "<" + std::string(child->Name()) + "> is not allowed here", error);
+		}
+		if (!this->check(child, type.childOf[static_cast<size_t>(column)], error))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int32_t XmlSchema::rootOf(const xml2::XMLElement *root, std::string &error) const
+{
+	if (root == nullptr)
+	{
+		error = "there is no root element";
+		return -1;
+	}
+	const uint32_t atom = this->atoms.find(local(root->Name()));
+	if (atom == XmlAtoms::none || this->roots[atom] < 0)
+	{
+		this->fail(root, "<" + std::string(root->Name()) + "> is not declared as a global element", error);
+		return -1;
+	}
+	return this->roots[atom];
+}
+
+bool XmlSchema::check(const xml2::XMLElement *top, int32_t decl, std::string &error) const
+{
+	std::vector<Frame> frames;
+	if (!this->enter(top, decl, frames, error))
+	{
+		return false;
+	}
+	while(!frames.empty())
+	{
+		if (!this->step(frames, error))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool XmlSchema::step(std::vector<Frame> &frames, std::string &error) const
+{
+	Frame &frame = frames.back();
+	const Complex &type = *frame.type;
+	const xml2::XMLNode *node = frame.next;
+	if (node == nullptr)
+	{
+		if (!type.accepting[static_cast<size_t>(frame.state)])
+		{
+			return this->fail(frame.element, "the content ends too early, " + this->expected(type, frame.state) + " was expected", error);
+		}
+		frames.pop_back();
+		return true;
+	}
+	frame.next = node->NextSibling();
+	const xml2::XMLElement *child = node->ToElement();
+	if (child == nullptr)
+	{
+		if (!type.mixed && node->ToText() != nullptr && !blank(node->Value()))
+		{
+			return this->fail(frame.element, "text is not allowed in <" + std::string(frame.element->Name()) + ">", error);
+		}
+		return true;
+	}
+	const int32_t column = this->columnOf(type, child);
+	const int32_t next = (column < 0) ? -1 : type.table[static_cast<size_t>(frame.state) * type.columns + static_cast<size_t>(column)];
+	if (next < 0)
+	{
+		return this->fail(child, "<" + std::string(child->Name()) + "> is not allowed here, " + this->expected(type, frame.state) + " was expected", error);
+	}
+	frame.state = next;
+	// frame is not used after : pushing may move it.
+	return this->enter(child, type.childOf[static_cast<size_t>(column)], frames, error);
+}
+
+bool XmlSchema::enter(const xml2::XMLElement *element, int32_t decl, std::vector<Frame> &frames, std::string &error) const
+{
+	const Element &declared = this->elements[static_cast<size_t>(decl)];
+	if (declared.complex < 0 && declared.simple < 0)
+	{
+		return true;
+	}
+	if (declared.complex < 0)
+	{
+		return this->attributes(element, nullptr, error) && this->text(element, this->simples[static_cast<size_t>(declared.simple)], declared.fallback, error);
+	}
+	const Complex &type = this->complexes[static_cast<size_t>(declared.complex)];
+	if (!this->attributes(element, &type, error))
+	{
+		return false;
+	}
+	if (type.simple >= 0)
+	{
+		return this->text(element, this->simples[static_cast<size_t>(type.simple)], declared.fallback, error);
+	}
+	if (element->Unexpanded())
+	{
+		return this->fail(element, "the content was not parsed (lazy load)", error);
+	}
+	frames.push_back({element, &type, 0, element->FirstChild()});
+	return true;
+}
+
+bool XmlSchema::attributes(const xml2::XMLElement *element, const Complex *type, std::string &error) const
+{
+	uint64_t seen = 0;
+	for(const xml2::XMLAttribute *attribute = element->FirstAttribute(); attribute != nullptr; attribute = attribute->Next())
+	{
+		const char *name = attribute->Name();
+		if ((strncmp(name, "xmlns", 5) == 0 && (name[5] == '\0' || name[5] == ':')) || strncmp(name, "xsi:", 4) == 0)
+		{
+			continue;
+		}
+		size_t index = 0;
+		const size_t count = (type == nullptr) ? 0 : type->attributes.size();
+		while(index < count && type->attributes[index].name != local(name))
+		{
+			++index;
+		}
+		if (index == count)
+		{
+			if (type != nullptr && type->anyAttribute)
+			{
+				continue;
+			}
+			return this->fail(element, "the attribute " + std::string(name) + " is not declared", error);
+		}
+		std::string why;
+		if (!this->accepts(this->simples[static_cast<size_t>(type->attributes[index].simple)], attribute->Value(), why))
+		{
+			return this->fail(element, "the attribute " + std::string(name) + " : " + why, error);
+		}
+		seen |= uint64_t(1) << index;
+	}
+	const uint64_t missing = (type == nullptr) ? 0 : type->required & ~seen;
+	for(size_t index = 0; missing != 0; ++index)
+	{
+		if (missing & (uint64_t(1) << index))
+		{
+			return this->fail(element, "the attribute " + type->attributes[index].name + " is required", error);
+		}
+	}
+	return true;
+}
+
+bool XmlSchema::text(const xml2::XMLElement *element, const Simple &type, bool fallback, std::string &error) const
+{
+	const char *value = "";
+	std::string joined;
+	bool many = false;
+	for(const xml2::XMLNode *node = element->FirstChild(); node != nullptr; node = node->NextSibling())
+	{
+		if (node->ToElement() != nullptr)
+		{
+			return this->fail(node, "<" + std::string(element->Name()) + "> cannot have child elements", error);
+		}
+		if (node->ToText() == nullptr)
+		{
+			continue;
+		}
+		if (*value == '\0')
+		{
+			value = node->Value();
+			continue;
+		}
+		if (!many)
+		{
+			joined = value;
+			many   = true;
+		}
+		joined += node->Value();
+	}
+	if (many)
+	{
+		value = joined.c_str();
+	}
+	if (*value == '\0' && fallback)
+	{
+		return true;
+	}
+	std::string why;
+	if (!this->accepts(type, value, why))
+	{
+		return this->fail(element, why, error);
+	}
+	return true;
+}
+
+bool XmlSchema::accepts(const Simple &type, const char *value, std::string &why) const
+{
+	const char *begin = value;
+	const char *end   = value + strlen(value);
+	if (type.trim)
+	{
+		while(begin < end && blank(*begin))
+		{
+			++begin;
+		}
+		while(end > begin && blank(end[-1]))
+		{
+			--end;
+		}
+	}
+	// Within, each run of blanks is one space : the value is copied only if one has to change.
+	std::string collapsed;
+	for(const char *c = begin; type.trim && c < end; ++c)
+	{
+		if (blank(*c) && (*c != ' ' || blank(c[1])))
+		{
+			for(const char *d = begin; d < end; ++d)
+			{
+				if (!blank(*d))
+				{
+					collapsed += *d;
+				}
+				else if (!blank(d[-1]))
+				{
+					collapsed += ' ';
+				}
+			}
+			begin = collapsed.data();
+			end   = begin + collapsed.size();
+			break;
+		}
+	}
+	const size_t size = static_cast<size_t>(end - begin);
+	const char *at = begin;
+	bool syntax = true;
+	switch(type.base)
+	{
+		case Simple::TEXT:
+			break;
+		case Simple::BOOLEAN:
+			syntax = (size == 4 && strncmp(begin, "true", 4) == 0) || (size == 5 && strncmp(begin, "false", 5) == 0)
+			      || (size == 1 && (*begin == '0' || *begin == '1'));
+			break;
+		case Simple::INTEGER:
+			at += (at < end && (*at == '+' || *at == '-')) ? 1 : 0;
+			syntax = digits(at, end) > 0 && at == end;
+			break;
+		case Simple::DECIMAL:
+		case Simple::FLOAT:
+			if (type.base == Simple::FLOAT && ((size == 3 && (strncmp(begin, "INF", 3) == 0 || strncmp(begin, "NaN", 3) == 0))
+			                               || (size == 4 && strncmp(begin, "-INF", 4) == 0)))
+			{
+				break;
+			}
+			at += (at < end && (*at == '+' || *at == '-')) ? 1 : 0;
+			{
+				size_t count = digits(at, end);
+				if (at < end && *at == '.')
+				{
+					++at;
+					count += digits(at, end);
+				}
+				syntax = count > 0;
+			}
+			if (syntax && type.base == Simple::FLOAT && at < end && (*at == 'e' || *at == 'E'))
+			{
+				++at;
+				at += (at < end && (*at == '+' || *at == '-')) ? 1 : 0;
+				syntax = digits(at, end) > 0;
+			}
+			syntax = syntax && at == end;
+			break;
+	}
+	if (!syntax)
+	{
+		why = quote(begin, end) + " is not a valid " + type.name;
+		return false;
+	}
+	if (type.base == Simple::INTEGER || type.base == Simple::DECIMAL || type.base == Simple::FLOAT)
+	{
+		double value = number(begin, end);
+		if (size == 3 && strncmp(begin, "INF", 3) == 0)
+		{
+			value = HUGE_VAL;
+		}
+		else if (size == 4 && strncmp(begin, "-INF", 4) == 0)
+		{
+			value = -HUGE_VAL;
+		}
+		if (type.minSet && (type.minExclusive ? !(value > type.min) : !(value >= type.min)))
+		{
+			why = quote(begin, end) + " is below the minimum of " + type.name;
+			return false;
+		}
+		if (type.maxSet && (type.maxExclusive ? !(value < type.max) : !(value <= type.max)))
+		{
+			why = quote(begin, end) + " is above the maximum of " + type.name;
+			return false;
+		}
+	}
+	if (type.minLength > 0 || type.maxLength != SIZE_MAX)
+	{
+		size_t length = 0;
+		for(const char *c = begin; c < end; ++c)
+		{
+			length += ((static_cast<unsigned char>(*c) & 0xC0) != 0x80) ? 1 : 0;
+		}
+		if (length < type.minLength || length > type.maxLength)
+		{
+			why = quote(begin, end) + " does not have the length of " + type.name;
+			return false;
+		}
+	}
+	if (!type.enumeration.empty())
+	{
+		bool found = false;
+		for(size_t i = 0; i < type.enumeration.size() && !found; ++i)
+		{
+			found = type.enumeration[i].size() == size && type.enumeration[i].compare(0, size, begin, size) == 0;
+		}
+		if (!found)
+		{
+			why = quote(begin, end) + " is not one of the values of " + type.name;
+			return false;
+		}
+	}
+	for(const std::regex &pattern : type.patterns)
+	{
+		if (!std::regex_match(begin, end, pattern))
+		{
+			why = quote(begin, end) + " does not match the pattern of " + type.name;
+			return false;
+		}
+	}
+	return true;
+}
+
+int32_t XmlSchema::columnOf(const Complex &type, const xml2::XMLElement *element) const
+{
+	const char *name = local(element->Name());
+	if (type.columns <= MAX_SCAN)
+	{
+		for(uint32_t column = 0; column < type.columns; ++column)
+		{
+			if (type.names[column] == name)
+			{
+				return static_cast<int32_t>(column);
+			}
+		}
+		return -1;
+	}
+	const uint32_t atom = this->atoms.find(name);
+	return (atom == XmlAtoms::none) ? -1 : type.columnOf[atom];
+}
+
+std::string XmlSchema::expected(const Complex &type, int32_t state) const
+{
+	std::string names;
+	for(uint32_t column = 0; column < type.columns; ++column)
+	{
+		if (type.table[static_cast<size_t>(state) * type.columns + column] >= 0)
+		{
+			const Element &child = this->elements[static_cast<size_t>(type.childOf[column])];
+			names += (names.empty() ? "<" : " or <") + this->atoms.name(child.name) + ">";
+		}
+	}
+	if (type.accepting[static_cast<size_t>(state)])
+	{
+		names += names.empty() ? "the end" : " or the end";
+	}
+	return names.empty() ? "nothing" : names;
+}
+
+bool XmlSchema::fail(const xml2::XMLNode *node, const std::string &what, std::string &error) const
+{
+	std::string path;
+	const xml2::XMLElement *element = node->ToElement();
+	for(const xml2::XMLElement *at = element; at != nullptr; at = (at->Parent() == nullptr) ? nullptr : at->Parent()->ToElement())
+	{
+		size_t position = 1;
+		for(const xml2::XMLElement *before = at->PreviousSiblingElement(at->Name()); before != nullptr; before = before->PreviousSiblingElement(at->Name()))
+		{
+			++position;
+		}
+		path = "/" + std::string(at->Name()) + ((position > 1) ? "[" + std::to_string(position) + "]" : std::string()) + path;
+	}
+	error = path;
+	if (element != nullptr && element->SourceLine() > 0)
+	{
+		error += " (line " + std::to_string(element->SourceLine()) + ")";
+	}
+	else if (element != nullptr && element->SourceEnd() > 0)
+	{
+		// The lines were not counted : the offsets always are.
+		error += " (byte " + std::to_string(element->SourceBegin()) + ")";
+	}
+	error += " : " + what;
+	return false;
+}
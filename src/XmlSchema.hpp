@@ -0,0 +1,234 @@
+/**
+ * @file XmlSchema.hpp
+ * @brief Defines the validation of a document against a XML schema, compiled
+ * to one automaton per complex type.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ *
+ * Only a practical subset of XSD 1.0 is compiled, anything else is refused
+ * when the schema is loaded, never ignored :
+ * - global and local \b xs:element (\b name, \b type, \b ref, inline types,
+ *   \b minOccurs, \b maxOccurs, \b default, \b fixed), an element without any
+ *   type (or of type \b xs:anyType) accepting anything ;
+ * - \b xs:complexType, named or not, with \b xs:sequence, \b xs:choice and
+ *   \b xs:group nested at will, \b mixed, \b xs:attribute, \b xs:attributeGroup,
+ *   \b xs:anyAttribute, \b xs:simpleContent extending a simple type, and
+ *   \b xs:complexContent extending or restricting a complex type ;
+ * - \b xs:simpleType restricting a builtin or a named simple type, with the
+ *   facets \b enumeration, \b minInclusive, \b maxInclusive, \b minExclusive,
+ *   \b maxExclusive, \b length, \b minLength, \b maxLength, \b pattern and
+ *   \b whiteSpace.
+ *
+ * \b xs:all, \b xs:any, the identity constraints and \b xsi:type are not.
+ * The builtin types checked are \b boolean, \b decimal, \b float, \b double
+ * and the integers (with their ranges) ; the other ones, as \b xs:list and
+ * \b xs:union, are only checked as text. The names of the document are
+ * compared without their prefix, the namespaces are not checked.
+ */
+#ifndef XMLSCHEMA_HPP_INCLUDED
+#define XMLSCHEMA_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <regex>
+#include <cstdint>
+#include "tinyxml2.h"
+#include "XmlAtoms.hpp"
+
+namespace xml2 = tinyxml2;
+
+
+/**
+ * @brief A XML schema, compiled once, to validate the documents loaded with
+ * it (see XmlOptions::schema) while walking their tree once, without parsing
+ * them again.
+ *
+ * The content model of each complex type is compiled to a deterministic
+ * automaton : a table of the next state for each state and each name of
+ * child, so checking the children of an element costs one table lookup per
+ * child. The simple types are compiled to the list of their facets.
+ * @code
+ * XmlOptions options;
+ * options.schema = std::make_shared<XmlSchema>("catalog.xsd");
+ * XmlLoader loader("catalog.xml", options); // throws if it is not valid
+ * @endcode
+ * A schema never changes once compiled : it can be shared by many loaders and threads.
+ * @author MTLCRBN
+ */
+class XmlSchema final
+{
+	private:
+		class Compiler;
+
+		//! @brief A simple type, with all the facets of its derivation.
+		struct Simple
+		{
+			//! @brief What its value must be written as.
+			enum Base
+			{
+				TEXT,    //!< Anything.
+				BOOLEAN, //!< true, false, 1 or 0.
+				INTEGER, //!< An integer, with an optional sign.
+				DECIMAL, //!< A decimal number.
+				FLOAT    //!< A decimal number, with an optional exponent, or INF, -INF, NaN.
+			};
+
+			Base                     base         = TEXT;  //!< What its value must be written as.
+			bool                     trim         = false; //!< If the blanks are collapsed : dropped around the value, one space within.
+			bool                     minSet       = false; //!< If there is a lower bound.
+			bool                     maxSet       = false; //!< If there is an upper bound.
+			bool                     minExclusive = false; //!< If the lower bound is excluded.
+			bool                     maxExclusive = false; //!< If the upper bound is excluded.
+			double                   min          = 0;     //!< The lower bound.
+			double                   max          = 0;     //!< The upper bound.
+			size_t                   minLength    = 0;     //!< The minimum number of characters.
+			size_t                   maxLength    = SIZE_MAX; //!< The maximum number of characters.
+			std::vector<std::string> enumeration;          //!< The only values allowed, if any.
+			std::vector<std::regex>  patterns;             //!< What the value must all match.
+			std::string              name;                 //!< Its name, for the errors.
+		};
+
+		//! @brief An attribute of a complex type.
+		struct Attribute
+		{
+			std::string name;     //!< Its local name.
+			int32_t     simple;   //!< Its type, in simples.
+			bool        required; //!< If it cannot be left out.
+		};
+
+		//! @brief A declaration of element.
+		struct Element
+		{
+			uint32_t name     = XmlAtoms::none; //!< Its local name.
+			int32_t  complex  = -1;             //!< Its complex type in complexes, -1 if it is not.
+			int32_t  simple   = -1;             //!< Its simple type in simples, -1 if it is not (neither : anything).
+			bool     fallback = false;          //!< If it has a default or fixed value, for an empty content.
+		};
+
+		//! @brief A complex type, and the automaton of its content.
+		struct Complex
+		{
+			bool                     mixed        = false; //!< If text may be between the children.
+			bool                     anyAttribute = false; //!< If undeclared attributes are allowed.
+			int32_t                  simple       = -1;    //!< Its simple content in simples, -1 for elements.
+			std::vector<Attribute>   attributes;           //!< Its attributes.
+			uint64_t                 required     = 0;     //!< The mask of the required attributes.
+			uint32_t                 columns      = 0;     //!< The number of names of children.
+			std::vector<int32_t>     table;                //!< The next state of [state * columns + column], -1 if refused.
+			std::vector<uint8_t>     accepting;            //!< If the content may end at each state.
+			std::vector<int32_t>     childOf;              //!< The declaration of the child of each column, in elements.
+			std::vector<int32_t>     columnOf;             //!< The column of each atom, -1 if it has none.
+			std::vector<std::string> names;                //!< The local name of each column.
+		};
+
+		//! @brief An element whose children are being checked.
+		struct Frame
+		{
+			const xml2::XMLElement* element; //!< The element.
+			const Complex*          type;    //!< Its type.
+			int32_t                 state;   //!< The state of its automaton.
+			const xml2::XMLNode*    next;    //!< Its next child to check.
+		};
+
+		XmlAtoms              atoms;     //!< The names of the elements declared.
+		std::vector<Simple>   simples;   //!< The simple types.
+		std::vector<Complex>  complexes; //!< The complex types.
+		std::vector<Element>  elements;  //!< The declarations of elements.
+		std::vector<int32_t>  roots;     //!< The global declaration of each atom, -1 if it has none.
+
+		/**
+		 * @brief Find the declaration \a root matches among the global ones.
+		 * @return It, or -1 (and \a error is set) if there is none.
+		 */
+		int32_t rootOf(const xml2::XMLElement *root, std::string &error) const;
+
+		/**
+		 * @brief Check \a top and its whole subtree against \a decl.
+		 */
+		bool check(const xml2::XMLElement *top, int32_t decl, std::string &error) const;
+
+		/**
+		 * @brief Check the attributes and the text of \a element against \a decl,
+		 * and push it on \a frames if its children have to be checked.
+		 */
+		bool enter(const xml2::XMLElement *element, int32_t decl, std::vector<Frame> &frames, std::string &error) const;
+
+		/**
+		 * @brief Check the next child of \a frame, pushing it on \a frames if its
+		 * children have to be checked, or check that the content of \a frame may
+		 * end there if it has no more child (\a frame is then popped).
+		 */
+		bool step(std::vector<Frame> &frames, std::string &error) const;
+
+		/**
+		 * @brief Check the attributes of \a element against \a type (nullptr if it has none).
+		 */
+		bool attributes(const xml2::XMLElement *element, const Complex *type, std::string &error) const;
+
+		/**
+		 * @brief Check the text content of \a element against \a type.
+		 * @param[in] fallback If an empty content is replaced by a default value.
+		 */
+		bool text(const xml2::XMLElement *element, const Simple &type, bool fallback, std::string &error) const;
+
+		/**
+		 * @brief Check \a value against \a type.
+		 * @param[out] why What is wrong with it, if it is not valid.
+		 */
+		bool accepts(const Simple &type, const char *value, std::string &why) const;
+
+		/**
+		 * @brief Get the column of the children named as \a element in \a type, -1 if it has none.
+		 */
+		int32_t columnOf(const Complex &type, const xml2::XMLElement *element) const;
+
+		/**
+		 * @brief List the names of children \a type accepts at \a state, for the errors.
+		 */
+		std::string expected(const Complex &type, int32_t state) const;
+
+		/**
+		 * @brief Write the error \a what about \a element in \a error, with its path and line
+		 * (its byte offset if the lines were not counted, see XMLDocument::SetTrackLines()).
+		 * @return false.
+		 */
+		bool fail(const xml2::XMLNode *element, const std::string &what, std::string &error) const;
+
+		XmlSchema(void)                              = delete;
+		XmlSchema(const XmlSchema &other)            = delete;
+		XmlSchema& operator=(const XmlSchema &other) = delete;
+
+	public:
+		/**
+		 * @brief Load and compile the schema \a fname.
+		 * @param[in] fname The XSD file.
+		 * @throw std::string if \a fname cannot be read, or is not a schema.
+		 * @throw std::string if it uses something out of the subset compiled (see XmlSchema.hpp).
+		 */
+		explicit XmlSchema(const std::string &fname);
+
+		/**
+		 * @brief Check a whole document : \a root must match a global element,
+		 * and its subtree its declaration.
+		 * The subtree must be fully parsed (not skipped by a lazy load).
+		 * @param[in]  root  The root element of the document.
+		 * @param[out] error What is wrong, where, if it is not valid.
+		 * @return true if it is valid.
+		 */
+		bool validate(const xml2::XMLElement *root, std::string &error) const;
+
+		/**
+		 * @brief Check a record loaded alone under its root (see XmlOptions::streaming) :
+		 * the root must match a global element, with valid attributes, and each of
+		 * its children the declaration its name has in the content of the root.
+		 * The order and the number of the children of the root are not checked,
+		 * since they are not all there.
+		 * @param[in]  root  The root element, with the record as child (or nothing).
+		 * @param[out] error What is wrong, where, if it is not valid.
+		 * @return true if it is valid.
+		 */
+		bool validateRecord(const xml2::XMLElement *root, std::string &error) const;
+};
+
+#endif
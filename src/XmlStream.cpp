@@ -0,0 +1,214 @@
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+#include "XmlStream.hpp"
+
+
+namespace
+{
+	const size_t CHUNK_SIZE = 256*1024; //!< How many characters are read at once.
+	const size_t PEEK_SIZE  = 9;        //!< Enough characters to tell what a tag is ("<![CDATA[").
+}
+
+XmlStream::XmlStream(const std::string &fname) : fname(fname)
+{
+	this->started = true;
+	this->rewind();
+}
+
+void XmlStream::rewind(void)
+{
+	if (!this->started)
+	{
+		return;
+	}
+	this->input = XmlInput::open(this->fname);
+	this->window.assign(CHUNK_SIZE + 1, '\0');
+	this->begin    = 0;
+	this->end      = 0;
+	this->started  = false;
+	this->finished = false;
+	this->depth    = 0;
+	this->scanned  = 0;
+
+	// Skip the prolog, up to the opening tag of the root.
+	char *tag = nullptr;
+	char *after = nullptr;
+	while(after == nullptr)
+	{
+		const size_t at = this->nextTag();
+		if (at == this->end || this->window[at + 1] == '/')
+		{
+			this->fail("there is no root");
+		}
+		tag   = &this->window[at];
+		after = xml2::XMLUtil::SkipTag(tag + 1);
+		if (after == nullptr && !this->more())
+		{
+			this->fail("the root tag is not complete");
+		}
+	}
+	this->head.assign(tag, after);
+	if (after[-2] == '/')
+	{
+		// <root/> : there are no records.
+		this->head.erase(this->head.size() - 2, 1);
+		this->finished = true;
+	}
+	const char *name = tag + 1;
+	while(xml2::XMLUtil::IsNameChar(static_cast<unsigned char>(*name)))
+	{
+		++name;
+	}
+	this->tail  = "</" + std::string(tag + 1, static_cast<size_t>(name - tag - 1)) + ">";
+	this->begin = static_cast<size_t>(after - this->window.data());
+}
+
+bool XmlStream::more(void)
+{
+	if (this->begin > 0)
+	{
+		std::memmove(this->window.data(), this->window.data() + this->begin, this->end - this->begin);
+		this->end  -= this->begin;
+		this->begin = 0;
+	}
+	if (this->window.size() < this->end + CHUNK_SIZE + 1)
+	{
+		// Only a record bigger than the window makes it grow.
+		this->window.resize(std::max(this->window.size()*2, this->end + CHUNK_SIZE + 1));
+	}
+	const size_t got = this->input->read(this->window.data() + this->end, CHUNK_SIZE);
+	this->end += got;
+	this->window[this->end] = '\0';
+	return got > 0;
+}
+
+size_t XmlStream::nextTag(void)
+{
+	while(true)
+	{
+		const char *data = this->window.data();
+		const char *open = static_cast<const char*>(std::memchr(data + this->begin, '<', this->end - this->begin));
+		if (open == nullptr)
+		{
+			// Only text : it is dropped.
+			this->begin = this->end;
+			if (!this->more())
+			{
+				return this->end;
+			}
+			continue;
+		}
+		this->begin = static_cast<size_t>(open - data);
+		if (this->end - this->begin < PEEK_SIZE && this->more())
+		{
+			continue;
+		}
+		char *p = &this->window[this->begin];
+		if (p[1] != '!' && p[1] != '?')
+		{
+			return this->begin;
+		}
+		// Comments, CDATA, DTD and processing instructions are skipped.
+		const char *close = ">";
+		if (xml2::XMLUtil::StringEqual(p, "<!--", 4))
+		{
+			close = "-->";
+		}
+		else if (xml2::XMLUtil::StringEqual(p, "<![CDATA[", 9))
+		{
+			close = "]]>";
+		}
+		else if (p[1] == '?')
+		{
+			close = "?>";
+		}
+		const char *found = std::strstr(p + 2, close);
+		if (found == nullptr)
+		{
+			if (!this->more())
+			{
+				this->fail("a comment or a declaration is not closed");
+			}
+			continue;
+		}
+		this->begin = static_cast<size_t>(found + std::strlen(close) - this->window.data());
+	}
+}
+
+bool XmlStream::next(const std::string &name, const char *&record, size_t &size)
+{
+	this->started = true;
+	while(!this->finished)
+	{
+		const size_t at = this->nextTag();
+		if (at == this->end)
+		{
+			this->fail("the root is not closed");
+		}
+		char *tag = &this->window[at];
+		if (tag[1] == '/')
+		{
+			this->finished = true;
+			break;
+		}
+		char *after = nullptr;
+		if (this->depth == 0)
+		{
+			after = xml2::XMLUtil::SkipTag(tag + 1);
+			if (after != nullptr && after[-2] != '/')
+			{
+				this->depth   = 1;
+				this->scanned = static_cast<size_t>(after - tag);
+			}
+		}
+		if (this->depth > 0)
+		{
+			// A record bigger than the window is balanced from where the
+			// last scan stopped, not from its beginning.
+			char *stop = nullptr;
+			after = xml2::XMLUtil::SkipElement(tag + this->scanned, &this->depth, &stop);
+			if (after == nullptr)
+			{
+				this->scanned = static_cast<size_t>(stop - tag);
+			}
+		}
+		if (after == nullptr)
+		{
+			// The record goes on after the window.
+			if (!this->more())
+			{
+				this->fail("an element is not closed");
+			}
+			continue;
+		}
+		this->depth   = 0;
+		this->scanned = 0;
+		this->begin   = static_cast<size_t>(after - this->window.data());
+		const size_t length = name.size();
+		if (std::strncmp(tag + 1, name.c_str(), length) == 0 && !xml2::XMLUtil::IsNameChar(static_cast<unsigned char>(tag[1 + length])))
+		{
+			record = tag;
+			size   = static_cast<size_t>(after - tag);
+			return true;
+		}
+	}
+	return false;
+}
+
+const std::string& XmlStream::root(void) const
+{
+	return this->head;
+}
+
+const std::string& XmlStream::rootEnd(void) const
+{
+	return this->tail;
+}
+
+void XmlStream::fail(const std::string &what) const
+{
+	std::cerr << "[ERROR]: while reading " << this->fname << " : " << what << std::endl;
+	throw std::string("Bad format");
+}
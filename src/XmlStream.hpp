@@ -0,0 +1,100 @@
+/**
+ * @file XmlStream.hpp
+ * @brief Defines the reader cutting a file into records, one at a time.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef XMLSTREAM_HPP_INCLUDED
+#define XMLSTREAM_HPP_INCLUDED
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "XmlInput.hpp"
+
+
+/**
+ * @brief Read a file through a sliding window, and hand the children of its
+ * root over one at a time, without parsing them.
+ *
+ * The window only holds the record being handed over and what was read after
+ * it, so the memory needed is bounded by the largest record, not by the file.
+ * The records are found by balancing their tags (see XMLUtil::SkipElement()).
+ * @author MTLCRBN
+ */
+class XmlStream final
+{
+	private:
+		std::string               fname;    //!< The file read.
+		std::unique_ptr<XmlInput> input;    //!< Where the characters come from.
+		std::vector<char>         window;   //!< The characters read and not handed over yet.
+		size_t                    begin;    //!< Where the unread part of window starts.
+		size_t                    end;      //!< Where the characters of window end.
+		std::string               head;     //!< The opening tag of the root.
+		std::string               tail;     //!< The closing tag of the root.
+		bool                      started;  //!< If a record was asked for since open().
+		bool                      finished; //!< If the root is closed.
+		int                       depth;    //!< The elements open in the record being balanced, 0 between records.
+		size_t                    scanned;  //!< How far from its '<' the record being balanced was scanned.
+
+		/**
+		 * @brief Read more characters at the end of the window, moving what
+		 * was not handed over yet to its beginning.
+		 * @return false if there is nothing more to read.
+		 */
+		bool more(void);
+
+		/**
+		 * @brief Find the next tag of the window, more() being called as needed,
+		 * and skip what is not an element.
+		 * @return The offset of the '<' in window, or the one of its end.
+		 */
+		size_t nextTag(void);
+
+		/**
+		 * @brief Print the error and throw it.
+		 */
+		[[noreturn]] void fail(const std::string &what) const;
+
+		XmlStream(void)                              = delete;
+		XmlStream(const XmlStream &other)            = delete;
+		XmlStream& operator=(const XmlStream &other) = delete;
+
+	public:
+		/**
+		 * @brief Open \a fname, and read it up to the opening tag of its root.
+		 * @param[in] fname The file, compressed or not as XmlInput allows it.
+		 * @throw std::string if \a fname cannot be opened or has no root.
+		 */
+		explicit XmlStream(const std::string &fname);
+
+		/**
+		 * @brief Start again from the beginning of the file, if a record was asked for.
+		 * @throw std::string if the file cannot be opened anymore.
+		 */
+		void rewind(void);
+
+		/**
+		 * @brief Get the opening tag of the root, as it is in the file (but never self-closing).
+		 */
+		const std::string& root(void) const;
+
+		/**
+		 * @brief Get the closing tag of the root.
+		 */
+		const std::string& rootEnd(void) const;
+
+		/**
+		 * @brief Find the next child of the root named \a name.
+		 * The other children, texts and comments of the root are skipped.
+		 * @param[in]  name   The name of the records.
+		 * @param[out] record Where the record starts, until the next call.
+		 * @param[out] size   Its number of characters.
+		 * @throw std::string if the file is not well formed.
+		 * @return false once the root is closed.
+		 */
+		bool next(const std::string &name, const char *&record, size_t &size);
+};
+
+#endif
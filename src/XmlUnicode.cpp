@@ -0,0 +1,436 @@
+#include <cstring>
+#include <cstdint>
+
+#include "XmlUnicode.hpp"
+
+#ifdef __SSE2__
+#	include <emmintrin.h>
+#endif
+// The validation uses SSSE3 when the target has it, or when the processor
+// running it has it, the functions using it being compiled for it only.
+#if defined(RWXML_WITHOUT_SSSE3)
+#elif defined(__SSSE3__)
+#	define RWXML_SSSE3
+#	define RWXML_TARGET_SSSE3
+#elif defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#	define RWXML_SSSE3
+#	define RWXML_TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+#ifdef RWXML_SSSE3
+#	include <tmmintrin.h>
+#endif
+
+
+namespace
+{
+	const size_t BLOCK = 16; //!< How many UTF-16 units a vectorized step transcodes.
+
+	/**
+	 * @brief The UTF-16 unit at \a src.
+	 */
+	inline unsigned int unitAt(const char *src, bool bigEndian)
+	{
+		const unsigned char *bytes = reinterpret_cast<const unsigned char*>(src);
+		return bigEndian ? (bytes[0] << 8 | bytes[1]) : (bytes[1] << 8 | bytes[0]);
+	}
+
+	/**
+	 * @brief Transcode BLOCK units at once if they are all ASCII.
+	 * \a src has 2*BLOCK bytes, and \a dst room for BLOCK characters.
+	 * @return false if one of them is not, nothing is written then.
+	 */
+	inline bool asciiBlock(const char *src, char *dst, bool bigEndian)
+	{
+#ifdef __SSE2__
+		__m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+		__m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+		if (bigEndian)
+		{
+			low  = _mm_or_si128(_mm_slli_epi16(low, 8), _mm_srli_epi16(low, 8));
+			high = _mm_or_si128(_mm_slli_epi16(high, 8), _mm_srli_epi16(high, 8));
+		}
+		const __m128i above = _mm_and_si128(_mm_or_si128(low, high), _mm_set1_epi16(static_cast<short>(0xFF80)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(above, _mm_setzero_si128())) != 0xFFFF)
+		{
+			return false;
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(low, high));
+		return true;
+#else
+		// The bits which have to be 0 in an ASCII unit, in the order of the bytes.
+		static const unsigned char le[8] = {0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF};
+		static const unsigned char be[8] = {0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80};
+		uint64_t mask;
+		std::memcpy(&mask, bigEndian ? be : le, 8);
+		uint64_t words[BLOCK/4];
+		std::memcpy(words, src, sizeof(words));
+		uint64_t above = 0;
+		for(size_t i = 0; i < BLOCK/4; ++i)
+		{
+			above |= words[i] & mask;
+		}
+		if (above != 0)
+		{
+			return false;
+		}
+		const size_t at = bigEndian ? 1 : 0;
+		for(size_t i = 0; i < BLOCK; ++i)
+		{
+			dst[i] = src[2*i + at];
+		}
+		return true;
+#endif
+	}
+
+	/**
+	 * @brief Tell if the 32 bytes at \a text are all ASCII.
+	 */
+	inline bool asciiRun(const char *text)
+	{
+#ifdef __SSE2__
+		const __m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
+		const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 16));
+		return _mm_movemask_epi8(_mm_or_si128(low, high)) == 0;
+#else
+		uint64_t words[4];
+		std::memcpy(words, text, sizeof(words));
+		return ((words[0] | words[1] | words[2] | words[3]) & 0x8080808080808080ULL) == 0;
+#endif
+	}
+
+	/**
+	 * @brief The size of the UTF-8 character at \a text, before \a end.
+	 * @return Its size, 0 if it is not valid, or -1 if it is cut by \a end.
+	 */
+	inline int character(const unsigned char *text, const unsigned char *end)
+	{
+		const unsigned char lead = text[0];
+		if (lead < 0x80)
+		{
+			return 1;
+		}
+		// The range of the second byte, which rules out the overlong forms,
+		// the surrogates and what is above U+10FFFF (Unicode, table 3-7).
+		int size = 0;
+		unsigned char low  = 0x80;
+		unsigned char high = 0xBF;
+		if (lead >= 0xC2 && lead <= 0xDF)
+		{
+			size = 2;
+		}
+		else if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			size = 3;
+			low  = (lead == 0xE0) ? 0xA0 : 0x80;
+			high = (lead == 0xED) ? 0x9F : 0xBF;
+		}
+		else if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			size = 4;
+			low  = (lead == 0xF0) ? 0x90 : 0x80;
+			high = (lead == 0xF4) ? 0x8F : 0xBF;
+		}
+		else
+		{
+			return 0;
+		}
+		for(int i = 1; i < size; ++i)
+		{
+			if (text + i == end)
+			{
+				return -1;
+			}
+			if (text[i] < low || text[i] > high)
+			{
+				return 0;
+			}
+			low  = 0x80;
+			high = 0xBF;
+		}
+		return size;
+	}
+
+	/**
+	 * @brief Check [\a at, \a end) character by character, \a at being the start of one.
+	 * @return The end of the valid characters.
+	 */
+	const unsigned char* validFrom(const unsigned char *at, const unsigned char *end)
+	{
+		while(at < end)
+		{
+			if (end - at >= 32 && asciiRun(reinterpret_cast<const char*>(at)))
+			{
+				at += 32;
+				continue;
+			}
+			// Up to the next run of ASCII, character by character.
+			const unsigned char *stop = (end - at > 32) ? at + 32 : end;
+			while(at < stop)
+			{
+				const int length = character(at, end);
+				if (length <= 0)
+				{
+					return at;
+				}
+				at += length;
+			}
+		}
+		return end;
+	}
+
+	/**
+	 * @brief The start of the character the byte at \a at is in, \a begin being the start of one.
+	 */
+	inline const unsigned char* characterStart(const unsigned char *begin, const unsigned char *at)
+	{
+		for(int i = 0; i < 3 && at > begin && (*at & 0xC0) == 0x80; ++i)
+		{
+			--at;
+		}
+		return at;
+	}
+
+#ifdef RWXML_SSSE3
+	// What each pair of bytes can be wrong with (J. Keiser, D. Lemire,
+	// "Validating UTF-8 In Less Than One Instruction Per Byte", 2021).
+	const unsigned char TOO_SHORT   = 1 << 0; //!< A lead not followed by a continuation.
+	const unsigned char TOO_LONG    = 1 << 1; //!< A continuation after ASCII.
+	const unsigned char OVERLONG_3  = 1 << 2; //!< E0 80..9F.
+	const unsigned char TOO_LARGE   = 1 << 3; //!< F4 90..BF, or F5..FF.
+	const unsigned char SURROGATE   = 1 << 4; //!< ED A0..BF.
+	const unsigned char OVERLONG_2  = 1 << 5; //!< C0 or C1.
+	const unsigned char TOO_LARGE_2 = 1 << 6; //!< F5..FF 80..8F.
+	const unsigned char OVERLONG_4  = 1 << 6; //!< F0 80..8F.
+	const unsigned char TWO_CONTS   = 1 << 7; //!< Two continuations, legal only after a 3 or 4 bytes lead.
+	const unsigned char CARRY       = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+	/**
+	 * @brief The errors of the 16 bytes \a input, \a previous being the 16 bytes before.
+	 * @return Non zero bytes where there is an error.
+	 */
+	RWXML_TARGET_SSSE3 inline __m128i blockErrors(__m128i input, __m128i previous)
+	{
+		const __m128i nibble = _mm_set1_epi8(0x0F);
+		const __m128i prev1  = _mm_alignr_epi8(input, previous, 15);
+		const __m128i byte1High = _mm_shuffle_epi8(_mm_setr_epi8(
+			TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+			TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+			TOO_SHORT | OVERLONG_2,
+			TOO_SHORT,
+			TOO_SHORT | OVERLONG_3 | SURROGATE,
+			TOO_SHORT | TOO_LARGE | TOO_LARGE_2 | OVERLONG_4),
+			_mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+		const __m128i byte1Low = _mm_shuffle_epi8(_mm_setr_epi8(
+			CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+			CARRY | OVERLONG_2,
+			CARRY,
+			CARRY,
+			CARRY | TOO_LARGE,
+			CARRY | TOO_LARGE | TOO_LARGE_2, CARRY | TOO_LARGE | TOO_LARGE_2, CARRY | TOO_LARGE | TOO_LARGE_2,
+			CARRY | TOO_LARGE | TOO_LARGE_2, CARRY | TOO_LARGE | TOO_LARGE_2, CARRY | TOO_LARGE | TOO_LARGE_2,
+			CARRY | TOO_LARGE | TOO_LARGE_2, CARRY | TOO_LARGE | TOO_LARGE_2,
+			CARRY | TOO_LARGE | TOO_LARGE_2 | SURROGATE,
+			CARRY | TOO_LARGE | TOO_LARGE_2,
+			CARRY | TOO_LARGE | TOO_LARGE_2),
+			_mm_and_si128(prev1, nibble));
+		const __m128i byte2High = _mm_shuffle_epi8(_mm_setr_epi8(
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+			static_cast<char>(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_2 | OVERLONG_4),
+			static_cast<char>(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE),
+			static_cast<char>(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+			static_cast<char>(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT),
+			_mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+		const __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+		// Two continuations in a row are only legal as the 3rd or 4th byte of a character.
+		const __m128i third  = _mm_subs_epu8(_mm_alignr_epi8(input, previous, 14), _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+		const __m128i fourth = _mm_subs_epu8(_mm_alignr_epi8(input, previous, 13), _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+		const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+		return _mm_xor_si128(must23, special);
+	}
+
+	/**
+	 * @brief Non zero if the 16 bytes \a input end with a character cut.
+	 */
+	RWXML_TARGET_SSSE3 inline __m128i blockCut(__m128i input)
+	{
+		const char all = static_cast<char>(0xFF);
+		return _mm_subs_epu8(input, _mm_setr_epi8(all, all, all, all, all, all, all, all, all, all, all, all, all,
+			static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1)));
+	}
+
+	/**
+	 * @brief Check [\a begin, \a end) 16 bytes at a time with SSSE3 : the blocks are
+	 * checked as a whole, an error being located character by character.
+	 * @return The end of the valid characters.
+	 */
+	RWXML_TARGET_SSSE3 const unsigned char* validSsse3(const unsigned char *begin, const unsigned char *end)
+	{
+		const unsigned char *at = begin;
+		const __m128i zero = _mm_setzero_si128();
+		__m128i previous = zero;
+		__m128i cut      = zero;
+		bool    clean    = true; // If no character may go on in the next block.
+		while(end - at >= 16)
+		{
+			if (clean && end - at >= 48 && asciiRun(reinterpret_cast<const char*>(at)))
+			{
+				// ASCII bytes before a block check as zeros do.
+				previous = zero;
+				at += 32;
+				continue;
+			}
+			const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(at));
+			__m128i errors = cut;
+			if (_mm_movemask_epi8(input) != 0)
+			{
+				errors = blockErrors(input, previous);
+				cut    = blockCut(input);
+				clean  = false;
+			}
+			else
+			{
+				cut   = zero;
+				clean = true;
+			}
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(errors, zero)) != 0xFFFF)
+			{
+				// It may come from a character started in the previous block.
+				at = characterStart(begin, (at - begin >= 16) ? at - 16 : begin);
+				return validFrom(at, end);
+			}
+			previous = input;
+			at += 16;
+		}
+		// The last character checked may go on after, or be cut by the end.
+		at = characterStart(begin, (at > begin) ? at - 1 : begin);
+		return validFrom(at, end);
+	}
+
+	/**
+	 * @brief Tell if the processor running this has SSSE3, asked once.
+	 */
+	inline bool hasSsse3(void)
+	{
+#ifdef __SSSE3__
+		return true;
+#else
+		static const bool has = (__builtin_cpu_init(), __builtin_cpu_supports("ssse3") != 0);
+		return has;
+#endif
+	}
+#endif
+}
+
+
+XmlUnicode::Encoding XmlUnicode::detect(const unsigned char *head, size_t size, size_t &bom)
+{
+	bom = 0;
+	if (size >= 2 && head[0] == 0xFE && head[1] == 0xFF)
+	{
+		bom = 2;
+		return UTF16BE;
+	}
+	if (size >= 2 && head[0] == 0xFF && head[1] == 0xFE)
+	{
+		bom = 2;
+		return UTF16LE;
+	}
+	if (size >= 4 && head[0] == 0x00 && head[1] == '<' && head[2] == 0x00 && head[3] == '?')
+	{
+		return UTF16BE;
+	}
+	if (size >= 4 && head[0] == '<' && head[1] == 0x00 && head[2] == '?' && head[3] == 0x00)
+	{
+		return UTF16LE;
+	}
+	return UTF8;
+}
+
+bool XmlUnicode::utf16ToUtf8(const char *&src, const char *srcEnd, char *&dst, char *dstEnd, bool bigEndian)
+{
+	while(srcEnd - src >= 2)
+	{
+		if (srcEnd - src >= static_cast<ptrdiff_t>(2*BLOCK) && dstEnd - dst >= static_cast<ptrdiff_t>(BLOCK) && asciiBlock(src, dst, bigEndian))
+		{
+			src += 2*BLOCK;
+			dst += BLOCK;
+			continue;
+		}
+		// One block character by character, before trying the vector again.
+		for(size_t i = 0; i < BLOCK && srcEnd - src >= 2; ++i)
+		{
+			const unsigned int unit = unitAt(src, bigEndian);
+			unsigned long code = unit;
+			size_t units = 1;
+			size_t bytes = 3;
+			if (unit < 0x80)
+			{
+				bytes = 1;
+			}
+			else if (unit < 0x800)
+			{
+				bytes = 2;
+			}
+			else if (unit >= 0xD800 && unit < 0xDC00)
+			{
+				if (srcEnd - src < 4)
+				{
+					return true;
+				}
+				const unsigned int next = unitAt(src + 2, bigEndian);
+				if (next < 0xDC00 || next >= 0xE000)
+				{
+					return false;
+				}
+				code  = 0x10000 + ((unit - 0xD800) << 10) + (next - 0xDC00);
+				units = 2;
+				bytes = 4;
+			}
+			else if (unit >= 0xDC00 && unit < 0xE000)
+			{
+				return false;
+			}
+			if (dstEnd - dst < static_cast<ptrdiff_t>(bytes))
+			{
+				return true;
+			}
+			switch(bytes)
+			{
+				case 1:
+					*dst++ = static_cast<char>(code);
+					break;
+				case 2:
+					*dst++ = static_cast<char>(0xC0 | (code >> 6));
+					*dst++ = static_cast<char>(0x80 | (code & 0x3F));
+					break;
+				case 3:
+					*dst++ = static_cast<char>(0xE0 | (code >> 12));
+					*dst++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+					*dst++ = static_cast<char>(0x80 | (code & 0x3F));
+					break;
+				default:
+					*dst++ = static_cast<char>(0xF0 | (code >> 18));
+					*dst++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+					*dst++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+					*dst++ = static_cast<char>(0x80 | (code & 0x3F));
+					break;
+			}
+			src += 2*units;
+		}
+	}
+	return true;
+}
+
+size_t XmlUnicode::validUtf8(const char *text, size_t size)
+{
+	const unsigned char *begin = reinterpret_cast<const unsigned char*>(text);
+	const unsigned char *end   = begin + size;
+#ifdef RWXML_SSSE3
+	if (hasSsse3())
+	{
+		return static_cast<size_t>(validSsse3(begin, end) - begin);
+	}
+#endif
+	return static_cast<size_t>(validFrom(begin, end) - begin);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file XmlUnicode.hpp
+ * @brief Defines the detection of the encoding of a xml file, the transcoding to UTF-8,
+ * and its validation.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ *
+ * The transcoding and the validation use SSE2 when the target has it (\b __SSE2__),
+ * 64 bits words otherwise. The validation uses SSSE3 when the processor has it,
+ * unless \b RWXML_WITHOUT_SSSE3 is defined (the CMake option \b RWXML_WITH_SSSE3).
+ */
+#ifndef XMLUNICODE_HPP_INCLUDED
+#define XMLUNICODE_HPP_INCLUDED
+
+#include <cstddef>
+
+
+/**
+ * @brief Tell which encoding a xml file uses, and bring UTF-16 back to UTF-8,
+ * the only encoding TinyXML2 reads.
+ * @author MTLCRBN
+ */
+class XmlUnicode final
+{
+	public:
+		/**
+		 * @brief The encodings recognized.
+		 */
+		enum Encoding
+		{
+			UTF8,    //!< UTF-8, or anything ASCII compatible.
+			UTF16LE, //!< UTF-16, little endian.
+			UTF16BE  //!< UTF-16, big endian.
+		};
+
+		/**
+		 * @brief Tell the encoding of a file from its first bytes : its byte
+		 * order mark, or the "<?" of its declaration (XML 1.0, appendix F).
+		 * The UTF-8 byte order mark is left to TinyXML2.
+		 * @param[in]  head The first bytes of the file.
+		 * @param[in]  size How many there are (4 are enough).
+		 * @param[out] bom  The size of the byte order mark to skip.
+		 * @return The encoding.
+		 */
+		static Encoding detect(const unsigned char *head, size_t size, size_t &bom);
+
+		/**
+		 * @brief Transcode UTF-16 to UTF-8, as far as both buffers allow it.
+		 *
+		 * It stops at the first character which does not fit in [\a dst, \a dstEnd),
+		 * or which is not complete in [\a src, \a srcEnd) (an odd byte, or the first
+		 * half of a surrogate pair) : it is left for the next call.
+		 * @param[in,out] src       The UTF-16 bytes, moved after what was transcoded.
+		 * @param[in]     srcEnd    Their end.
+		 * @param[in,out] dst       Where to write, moved after what was written.
+		 * @param[in]     dstEnd    The end of the room available.
+		 * @param[in]     bigEndian The byte order of \a src.
+		 * @return false if \a src holds an unpaired surrogate, \a src is then left on it.
+		 */
+		static bool utf16ToUtf8(const char *&src, const char *srcEnd, char *&dst, char *dstEnd, bool bigEndian);
+
+		/**
+		 * @brief Check that \a text is UTF-8 : no byte which cannot start or continue
+		 * a character, no overlong form, no surrogate, nothing above U+10FFFF.
+		 *
+		 * If the processor has SSSE3 (asked once, or known at compile time with \b -mssse3),
+		 * it checks 16 bytes at a time with vector table lookups, and only goes through
+		 * the characters one by one to locate an error. Otherwise, the ASCII runs are
+		 * skipped 32 bytes at a time, and the other characters are checked one by one.
+		 * @param[in] text The text to check.
+		 * @param[in] size Its size, in bytes.
+		 * @return The size of its longest valid beginning : \a size if it is valid.
+		 * A character cut by the end of \a text is not part of it.
+		 */
+		static size_t validUtf8(const char *text, size_t size);
+
+		XmlUnicode(void) = delete;
+};
+
+#endif
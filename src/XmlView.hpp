@@ -0,0 +1,69 @@
+/**
+ * @file XmlView.hpp
+ * @brief Defines a view on characters of a loaded document.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ *
+ * With C++17, a view converts to a \b std::string_view.
+ */
+#ifndef XMLVIEW_HPP_INCLUDED
+#define XMLVIEW_HPP_INCLUDED
+
+#include <string>
+#include <cstddef>
+#include <cstring>
+#if __cplusplus >= 201703L
+#	include <string_view>
+#endif
+
+
+/**
+ * @brief Characters of the parse buffer of a document, not copied and not
+ * null terminated (see XmlLoader::rawText()).
+ *
+ * It is valid until the document is reloaded, or until the same text or
+ * attribute is read through text() or attribute(), which decodes it in place.
+ * @author MTLCRBN
+ */
+struct XmlView
+{
+	const char* data = nullptr; //!< The first character, nullptr for none.
+	size_t      size = 0;       //!< The number of characters.
+
+	/**
+	 * @brief Tell if there is no character.
+	 */
+	bool empty(void) const
+	{
+		return this->size == 0;
+	}
+
+	/**
+	 * @brief Copy the characters.
+	 */
+	std::string str(void) const
+	{
+		return (this->data == nullptr) ? std::string() : std::string(this->data, this->size);
+	}
+
+	/**
+	 * @brief Tell if the characters are \a other.
+	 */
+	bool operator==(const char *other) const
+	{
+		return strlen(other) == this->size && (this->size == 0 || memcmp(this->data, other, this->size) == 0);
+	}
+
+#if __cplusplus >= 201703L
+	/**
+	 * @brief Look at the characters as a \b std::string_view.
+	 */
+	operator std::string_view(void) const
+	{
+		return std::string_view(this->data, this->size);
+	}
+#endif
+};
+
+#endif
@@ -31,6 +31,9 @@ distribution.
 #   include <cstddef>
 #   include <cstdarg>
 #endif
+#if defined(__linux__)
+#   include <sys/mman.h>
+#endif
 
 #if defined(_MSC_VER) && (_MSC_VER >= 1400 ) && (!defined WINCE)
 	// Microsoft Visual Studio, version 2005 and higher. Not WinCE.
@@ -257,6 +260,48 @@ void StrPair::CollapseWhitespace()
 }
 
 
+const char* StrPair::Raw( size_t* length ) const
+{
+    if ( !_start ) {
+        *length = 0;
+        return "";
+    }
+    if ( _flags & NEEDS_FLUSH ) {
+        *length = _end - _start;
+        return _start;
+    }
+    *length = strlen( _start );
+    return _start;
+}
+
+
+size_t StrPair::RelocatedSize( const char* from, const char* to ) const
+{
+    if ( !_start || _start < from || _start >= to || ( _flags & NEEDS_DELETE ) ) {
+        return 0;
+    }
+    // An unflushed span keeps a byte for the null terminator GetStr() writes.
+    if ( _flags & NEEDS_FLUSH ) {
+        return _end - _start + 1;
+    }
+    return strlen( _start ) + 1;
+}
+
+
+void StrPair::Relocate( const char* from, const char* to, char** arena )
+{
+    const size_t size = RelocatedSize( from, to );
+    if ( !size ) {
+        return;
+    }
+    memcpy( *arena, _start, size-1 );
+    (*arena)[size-1] = 0;
+    _start = *arena;
+    _end = *arena + size-1;
+    *arena += size;
+}
+
+
 const char* StrPair::GetStr()
 {
     TIXMLASSERT( _start );
@@ -378,6 +423,92 @@ const char* XMLUtil::ReadBOM( const char* p, bool* bom )
 }
 
 
+char* XMLUtil::SkipElement( char* p )
+{
+    int depth = 1;
+    char* stop = 0;
+    return SkipElement( p, &depth, &stop );
+}
+
+
+char* XMLUtil::SkipElement( char* p, int* depth, char** stop )
+{
+    TIXMLASSERT( p );
+    TIXMLASSERT( *depth > 0 );
+    while ( true ) {
+        char* const tag = strchr( p, '<' );
+        if ( !tag ) {
+            *stop = p + strlen( p );
+            return 0;
+        }
+        p = tag + 1;
+        if ( *p == '/' ) {
+            p = strchr( p, '>' );
+            if ( !p ) {
+                *stop = tag;
+                return 0;
+            }
+            ++p;
+            if ( --*depth == 0 ) {
+                return p;
+            }
+        }
+        else if ( *p == '!' || *p == '?' ) {
+            // Comments, CDATA, DTD and processing instructions: their content
+            // may hold tags, which must not be counted.
+            const char* end = ">";
+            if ( StringEqual( p, "!--", 3 ) ) {
+                end = "-->";
+            }
+            else if ( StringEqual( p, "![CDATA[", 8 ) ) {
+                end = "]]>";
+            }
+            else if ( *p == '?' ) {
+                end = "?>";
+            }
+            p = strstr( p + 1, end );
+            if ( !p ) {
+                *stop = tag;
+                return 0;
+            }
+            p += strlen( end );
+        }
+        else {
+            p = SkipTag( p );
+            if ( !p ) {
+                *stop = tag;
+                return 0;
+            }
+            if ( *(p-2) != '/' ) {
+                ++*depth;
+            }
+        }
+    }
+}
+
+
+char* XMLUtil::SkipTag( char* p )
+{
+    TIXMLASSERT( p );
+    // Its attribute values may hold a '>'.
+    char quote = 0;
+    for( ; *p; ++p ) {
+        if ( quote ) {
+            if ( *p == quote ) {
+                quote = 0;
+            }
+        }
+        else if ( *p == '"' || *p == '\'' ) {
+            quote = *p;
+        }
+        else if ( *p == '>' ) {
+            return p + 1;
+        }
+    }
+    return 0;
+}
+
+
 void XMLUtil::ConvertUTF32ToUTF8( unsigned long input, char* output, int* length )
 {
     const unsigned long BYTE_MASK = 0xBF;
@@ -701,17 +832,53 @@ char* XMLDocument::Identify( char* p, XMLNode** node )
 }
 
 
-bool XMLDocument::Accept( XMLVisitor* visitor ) const
+// Visit the subtree under 'top' by walking the parent and sibling links
+// rather than by recursion, so that a deep document costs no call stack.
+// The callbacks and their return values are honored exactly as a recursive
+// Accept() would.
+static bool AcceptSubtree( const XMLNode* top, XMLVisitor* visitor )
 {
+    TIXMLASSERT( top );
     TIXMLASSERT( visitor );
-    if ( visitor->VisitEnter( *this ) ) {
-        for ( const XMLNode* node=FirstChild(); node; node=node->NextSibling() ) {
-            if ( !node->Accept( visitor ) ) {
+    const XMLNode* node = top;
+    bool result = true;
+    for( ;; ) {
+        // Enter the node, and go down if its children have to be visited.
+        const XMLElement* element = node->ToElement();
+        const XMLDocument* document = node->ToDocument();
+        if ( element || document ) {
+            const bool enter = element ? visitor->VisitEnter( *element, element->FirstAttribute() )
+                                       : visitor->VisitEnter( *document );
+            if ( enter && node->FirstChild() ) {
+                node = node->FirstChild();
+                continue;
+            }
+            result = element ? visitor->VisitExit( *element ) : visitor->VisitExit( *document );
+        }
+        else {
+            result = node->Accept( visitor );
+        }
+        // The node is done: move to its next sibling, or exit its parents.
+        for( ;; ) {
+            if ( node == top ) {
+                return result;
+            }
+            if ( result && node->NextSibling() ) {
+                node = node->NextSibling();
                 break;
             }
+            node = node->Parent();
+            TIXMLASSERT( node );
+            element = node->ToElement();
+            result = element ? visitor->VisitExit( *element ) : visitor->VisitExit( *node->ToDocument() );
         }
     }
-    return visitor->VisitExit( *this );
+}
+
+
+bool XMLDocument::Accept( XMLVisitor* visitor ) const
+{
+    return AcceptSubtree( this, visitor );
 }
 
 
@@ -744,6 +911,15 @@ const char* XMLNode::Value() const
     return _value.GetStr();
 }
 
+const char* XMLNode::RawValue( size_t* length ) const
+{
+    if ( this->ToDocument() ) {
+        *length = 0;
+        return 0;
+    }
+    return _value.Raw( length );
+}
+
 void XMLNode::SetValue( const char* str, bool staticMem )
 {
     if ( staticMem ) {
@@ -757,13 +933,19 @@ void XMLNode::SetValue( const char* str, bool staticMem )
 
 void XMLNode::DeleteChildren()
 {
+    // Delete the leaves first, walking back up through the parents,
+    // so that no destructor ever has children left to delete.
+    XMLNode* node = this;
     while( _firstChild ) {
         TIXMLASSERT( _lastChild );
         TIXMLASSERT( _firstChild->_document == _document );
-        XMLNode* node = _firstChild;
-        Unlink( node );
-
+        while( node->_firstChild ) {
+            node = node->_firstChild;
+        }
+        XMLNode* parent = node->_parent;
+        parent->Unlink( node );
         DeleteNode( node );
+        node = parent;
     }
     _firstChild = _lastChild = 0;
 }
@@ -949,30 +1131,39 @@ const XMLElement* XMLNode::PreviousSiblingElement( const char* name ) const
 
 char* XMLNode::ParseDeep( char* p, StrPair* parentEnd )
 {
-    // This is a recursive method, but thinking about it "at the current level"
-    // it is a pretty simple flat list:
+    // The content is read as a pretty simple flat list of tags:
     //		<foo/>
     //		<!-- comment -->
-    //
-    // With a special case:
     //		<foo>
     //		</foo>
-    //		<!-- comment -->
     //
-    // Where the closing element (/foo) *must* be the next thing after the opening
-    // element, and the names must match. BUT the tricky bit is that the closing
-    // element will be read by the child.
+    // Where the closing element (/foo) *must* match the innermost opening
+    // element still open. Opening elements are kept on the 'open' stack
+    // (and not yet linked in the DOM) until their closing element is read.
+    // The parse is iterative: the depth of the document costs this stack,
+    // never call stack.
     //
-    // 'endTag' is the end tag for this node, it is returned by a call to a child.
-    // 'parentEnd' is the end tag for the parent, which is filled in and returned.
+    // 'parentEnd' is the end tag for this node, if it is read at this level
+    // it is filled in and returned.
+    DynArray< XMLElement*, 16 > open;
+    XMLNode* parent = this;
+    XMLParseFilter* filter = _document->ParseFilter();
+    const int lazyDepth = _document->LazyDepth();
+    const bool trackLines = _document->TrackLines();
 
-    while( p && *p ) {
+    while( p ) {
+        _document->Await( p );
+        if ( !*p ) {
+            break;
+        }
         XMLNode* node = 0;
 
         p = _document->Identify( p, &node );
         if ( node == 0 ) {
             break;
         }
+        // Past the '<', for an element.
+        char* const tag = p - 1;
 
         StrPair endTag;
         p = node->ParseDeep( p, &endTag );
@@ -997,39 +1188,97 @@ char* XMLNode::ParseDeep( char* p, StrPair* parentEnd )
 
         XMLElement* ele = node->ToElement();
         if ( ele ) {
-            // We read the end tag. Return it to the parent.
+            if ( ele->ClosingType() != XMLElement::CLOSING ) {
+                ele->_begin = _document->OffsetOf( tag );
+                ele->_end   = _document->OffsetOf( p );
+                if ( trackLines ) {
+                    ele->_line = _document->LineOf( tag );
+                }
+            }
             if ( ele->ClosingType() == XMLElement::CLOSING ) {
-                if ( parentEnd ) {
-                    ele->_value.TransferTo( parentEnd );
+                // We read the end tag of this node. Return it to the caller.
+                if ( open.Empty() ) {
+                    if ( parentEnd ) {
+                        ele->_value.TransferTo( parentEnd );
+                    }
+                    node->_memPool->SetTracked();   // created and then immediately deleted.
+                    DeleteNode( node );
+                    return p;
                 }
+
+                // We read the end tag of the innermost open element: it is
+                // complete, and can be linked to its own parent.
+                XMLElement* closed = open.Pop();
+                const bool mismatch = !XMLUtil::StringEqual( ele->Name(), closed->Name() );
                 node->_memPool->SetTracked();   // created and then immediately deleted.
                 DeleteNode( node );
-                return p;
+                if ( mismatch ) {
+                    _document->SetError( XML_ERROR_MISMATCHED_ELEMENT, closed->Name(), 0 );
+                    DeleteNode( closed );
+                    break;
+                }
+                node = closed;
+                node->ToElement()->_end = _document->OffsetOf( p );
+                parent = open.Empty() ? this : open.PeekTop();
+                if ( filter ) {
+                    filter->Exit( *closed );
+                }
             }
-
-            // Handle an end tag returned to this level.
-            // And handle a bunch of annoying errors.
-            bool mismatch = false;
-            if ( endTag.Empty() ) {
+            else if ( filter && !filter->Enter( *ele ) ) {
+                // Dropped: its content is skipped without creating any node.
                 if ( ele->ClosingType() == XMLElement::OPEN ) {
-                    mismatch = true;
+                    _document->AwaitAll();
+                    p = XMLUtil::SkipElement( p );
+                    if ( !p ) {
+                        _document->SetError( XML_ERROR_MISMATCHED_ELEMENT, ele->Name(), 0 );
+                    }
+                }
+                node->_memPool->SetTracked();   // created and then immediately deleted.
+                DeleteNode( node );
+                if ( !p ) {
+                    break;
                 }
+                continue;
             }
-            else {
-                if ( ele->ClosingType() != XMLElement::OPEN ) {
-                    mismatch = true;
+            else if ( ele->ClosingType() == XMLElement::OPEN ) {
+                if ( !*p ) {
+                    // The document ends right after the opening tag.
+                    _document->SetError( XML_ERROR_MISMATCHED_ELEMENT, ele->Name(), 0 );
+                    DeleteNode( node );
+                    break;
+                }
+                if ( open.Size() + 1 != lazyDepth ) {
+                    open.Push( ele );
+                    parent = ele;
+                    continue;
                 }
-                else if ( !XMLUtil::StringEqual( endTag.GetStr(), ele->Name() ) ) {
-                    mismatch = true;
+                // Deep enough: the content is kept for Expand().
+                ele->_lazy = p;
+                _document->AwaitAll();
+                p = XMLUtil::SkipElement( p );
+                if ( !p ) {
+                    _document->SetError( XML_ERROR_MISMATCHED_ELEMENT, ele->Name(), 0 );
+                    DeleteNode( node );
+                    break;
+                }
+                ele->_end = _document->OffsetOf( p );
+                if ( filter ) {
+                    filter->Exit( *ele );
                 }
             }
-            if ( mismatch ) {
-                _document->SetError( XML_ERROR_MISMATCHED_ELEMENT, ele->Name(), 0 );
-                DeleteNode( node );
-                break;
+            else if ( filter ) {
+                filter->Exit( *ele );
             }
         }
-        InsertEndChild( node );
+        parent->InsertEndChild( node );
+    }
+
+    // Elements still open were never closed: they are dropped.
+    while( !open.Empty() ) {
+        DeleteNode( open.Pop() );
+        if ( !_document->Error() ) {
+            _document->SetError( XML_ERROR_PARSING, 0, 0 );
+        }
     }
     return 0;
 }
@@ -1269,6 +1518,11 @@ const char* XMLAttribute::Value() const
     return _value.GetStr();
 }
 
+const char* XMLAttribute::RawValue( size_t* length ) const
+{
+    return _value.Raw( length );
+}
+
 char* XMLAttribute::ParseDeep( char* p, bool processEntities )
 {
     // Parse using the name rules: bug fix, was using ParseText before
@@ -1413,7 +1667,11 @@ void XMLAttribute::SetAttribute( float v )
 // --------- XMLElement ---------- //
 XMLElement::XMLElement( XMLDocument* doc ) : XMLNode( doc ),
     _closingType( 0 ),
-    _rootAttribute( 0 )
+    _line( 0 ),
+    _rootAttribute( 0 ),
+    _lazy( 0 ),
+    _begin( 0 ),
+    _end( 0 )
 {
 }
 
@@ -1461,6 +1719,16 @@ const char* XMLElement::GetText() const
 }
 
 
+const char* XMLElement::GetRawText( size_t* length ) const
+{
+    if ( FirstChild() && FirstChild()->ToText() ) {
+        return FirstChild()->RawValue( length );
+    }
+    *length = 0;
+    return 0;
+}
+
+
 void	XMLElement::SetText( const char* inText )
 {
 	if ( FirstChild() && FirstChild()->ToText() )
@@ -1717,7 +1985,7 @@ void XMLElement::DeleteAttribute( XMLAttribute* attribute )
 //	<ele></ele>
 //	<ele>foo<b>bar</b></ele>
 //
-char* XMLElement::ParseDeep( char* p, StrPair* strPair )
+char* XMLElement::ParseDeep( char* p, StrPair* )
 {
     // Read the element name.
     p = XMLUtil::SkipWhiteSpace( p );
@@ -1735,17 +2003,51 @@ char* XMLElement::ParseDeep( char* p, StrPair* strPair )
         return 0;
     }
 
+    // Only the tag is read here: the content of an opening element
+    // is read by the parent, in XMLNode::ParseDeep().
     p = ParseAttributes( p );
-    if ( !p || !*p || _closingType ) {
-        return p;
-    }
-
-    p = XMLNode::ParseDeep( p, strPair );
     return p;
 }
 
 
 
+XMLError XMLElement::Expand( bool all )
+{
+    if ( !_lazy ) {
+        return XML_SUCCESS;
+    }
+    char* p = _lazy;
+    _lazy = 0;
+
+    // The filter only knows the elements of the first parse.
+    XMLParseFilter* filter = _document->ParseFilter();
+    _document->SetParseFilter( 0 );
+    if ( _document->TrackLines() ) {
+        _document->LineOf( p, _document->_charBuffer + _begin, _line );
+    }
+    // Expanding a subtree level by level would skip its deepest levels
+    // again at each level: all of it is parsed at once.
+    const int lazyDepth = _document->LazyDepth();
+    if ( all ) {
+        _document->SetLazyDepth( 0 );
+    }
+    StrPair endTag;
+    p = XMLNode::ParseDeep( p, &endTag );
+    _document->SetParseFilter( filter );
+    _document->SetLazyDepth( lazyDepth );
+
+    if ( !p ) {
+        if ( !_document->Error() ) {
+            _document->SetError( XML_ERROR_PARSING_ELEMENT, Name(), 0 );
+        }
+    }
+    else if ( !XMLUtil::StringEqual( endTag.GetStr(), Name() ) ) {
+        _document->SetError( XML_ERROR_MISMATCHED_ELEMENT, Name(), 0 );
+    }
+    return _document->ErrorID();
+}
+
+
 XMLNode* XMLElement::ShallowClone( XMLDocument* doc ) const
 {
     if ( !doc ) {
@@ -1787,15 +2089,7 @@ bool XMLElement::ShallowEqual( const XMLNode* compare ) const
 
 bool XMLElement::Accept( XMLVisitor* visitor ) const
 {
-    TIXMLASSERT( visitor );
-    if ( visitor->VisitEnter( *this, _rootAttribute ) ) {
-        for ( const XMLNode* node=FirstChild(); node; node=node->NextSibling() ) {
-            if ( !node->Accept( visitor ) ) {
-                break;
-            }
-        }
-    }
-    return visitor->VisitExit( *this );
+    return AcceptSubtree( this, visitor );
 }
 
 
@@ -1826,15 +2120,81 @@ const char* XMLDocument::_errorNames[XML_ERROR_COUNT] = {
 };
 
 
+char* PageRegion::Alloc( size_t size, HugePages mode, size_t* mapped )
+{
+    size = ( size + SIZE - 1 ) / SIZE * SIZE;
+#if defined(__linux__)
+#   if defined(MAP_HUGETLB)
+    if ( mode == RESERVED_HUGE_PAGES ) {
+        void* mem = mmap( 0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+        if ( mem != MAP_FAILED ) {
+            *mapped = size;
+            return static_cast<char*>( mem );
+        }
+    }
+#   endif
+    if ( mode != NO_HUGE_PAGES ) {
+        // Map a huge page more, to keep a part aligned on SIZE.
+        void* mem = mmap( 0, size + SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        if ( mem != MAP_FAILED ) {
+            char* start = static_cast<char*>( mem );
+            char* aligned = reinterpret_cast<char*>( ( reinterpret_cast<uintptr_t>( start ) + SIZE - 1 ) & ~static_cast<uintptr_t>( SIZE - 1 ) );
+            if ( aligned > start ) {
+                munmap( start, aligned - start );
+            }
+            if ( start + SIZE > aligned ) {
+                munmap( aligned + size, start + SIZE - aligned );
+            }
+#   if defined(MADV_HUGEPAGE)
+            madvise( aligned, size, MADV_HUGEPAGE );
+#   endif
+            *mapped = size;
+            return aligned;
+        }
+    }
+#else
+    (void)mode;
+#endif
+    *mapped = 0;
+    return new char[size];
+}
+
+
+void PageRegion::Free( char* mem, size_t mapped )
+{
+#if defined(__linux__)
+    if ( mapped ) {
+        munmap( mem, mapped );
+        return;
+    }
+#else
+    TIXMLASSERT( !mapped );
+#endif
+    delete [] mem;
+}
+
+
 XMLDocument::XMLDocument( bool processEntities, Whitespace whitespace ) :
     XMLNode( 0 ),
     _writeBOM( false ),
     _processEntities( processEntities ),
+    _retainMemory( false ),
     _errorID(XML_SUCCESS),
     _whitespace( whitespace ),
     _errorStr1( 0 ),
     _errorStr2( 0 ),
-    _charBuffer( 0 )
+    _charBuffer( 0 ),
+    _charBufferCapacity( 0 ),
+    _charBufferMapped( 0 ),
+    _hugePages( NO_HUGE_PAGES ),
+    _parseFilter( 0 ),
+    _lazyDepth( 0 ),
+    _trackLines( false ),
+    _parseFeed( 0 ),
+    _fedTo( 0 ),
+    _fedEnd( 0 ),
+    _lineMark( 0 ),
+    _lineCount( 1 )
 {
     // avoid VC++ C4355 warning about 'this' in initializer list (C4355 is off by default in VS2012+)
     _document = this;
@@ -1843,6 +2203,7 @@ XMLDocument::XMLDocument( bool processEntities, Whitespace whitespace ) :
 
 XMLDocument::~XMLDocument()
 {
+    _retainMemory = false;
     Clear();
 }
 
@@ -1858,8 +2219,25 @@ void XMLDocument::Clear()
     _errorStr1 = 0;
     _errorStr2 = 0;
 
-    delete [] _charBuffer;
-    _charBuffer = 0;
+    if ( _retainMemory ) {
+        // Orphan nodes (created but never linked) may still live in the
+        // pools; only re-thread the ones that are entirely free.
+        if ( _elementPool.CurrentAllocs() == 0 ) {
+            _elementPool.Reset();
+        }
+        if ( _attributePool.CurrentAllocs() == 0 ) {
+            _attributePool.Reset();
+        }
+        if ( _textPool.CurrentAllocs() == 0 ) {
+            _textPool.Reset();
+        }
+        if ( _commentPool.CurrentAllocs() == 0 ) {
+            _commentPool.Reset();
+        }
+    }
+    else {
+        DeleteBuffer();
+    }
 
 #if 0
     _textPool.Trace( "text" );
@@ -2029,8 +2407,7 @@ XMLError XMLDocument::LoadFile( FILE* fp )
     }
 
     const size_t size = filelength;
-    TIXMLASSERT( _charBuffer == 0 );
-    _charBuffer = new char[size+1];
+    ReserveBuffer( size );
     size_t read = fread( _charBuffer, 1, size, fp );
     if ( read != size ) {
         SetError( XML_ERROR_FILE_READ_ERROR, 0, 0 );
@@ -2079,10 +2456,19 @@ XMLError XMLDocument::Parse( const char* p, size_t len )
     if ( len == (size_t)(-1) ) {
         len = strlen( p );
     }
-    TIXMLASSERT( _charBuffer == 0 );
-    _charBuffer = new char[ len+1 ];
+    ReserveBuffer( len );
     memcpy( _charBuffer, p, len );
+    return ParseBuffer( len );
+}
+
+
+XMLError XMLDocument::ParseBuffer( size_t len )
+{
+    TIXMLASSERT( _charBuffer );
+    TIXMLASSERT( len < _charBufferCapacity );
     _charBuffer[len] = 0;
+    _fedTo = 0;
+    _fedEnd = len;
 
     Parse();
     if ( Error() ) {
@@ -2149,20 +2535,314 @@ void XMLDocument::PrintError() const
     }
 }
 
+char* XMLDocument::ReserveBuffer( size_t size, size_t keep )
+{
+    // Room for 'size' characters and the null terminator. A retained
+    // buffer is reused as is when it is big enough.
+    TIXMLASSERT( keep <= size );
+    if ( _charBuffer && _charBufferCapacity > size ) {
+        return _charBuffer;
+    }
+    size_t mapped = 0;
+    char* buffer = NewBuffer( size+1, &mapped );
+    if ( keep ) {
+        TIXMLASSERT( _charBuffer );
+        memcpy( buffer, _charBuffer, keep );
+    }
+    DeleteBuffer();
+    _charBuffer = buffer;
+    _charBufferCapacity = size+1;
+    _charBufferMapped = mapped;
+    return _charBuffer;
+}
+
+
+char* XMLDocument::NewBuffer( size_t size, size_t* mapped ) const
+{
+    if ( _hugePages == NO_HUGE_PAGES || size < PageRegion::SIZE ) {
+        *mapped = 0;
+        return new char[size];
+    }
+    return PageRegion::Alloc( size, _hugePages, mapped );
+}
+
+
+void XMLDocument::DeleteBuffer()
+{
+    if ( _charBuffer ) {
+        PageRegion::Free( _charBuffer, _charBufferMapped );
+    }
+    _charBuffer = 0;
+    _charBufferCapacity = 0;
+    _charBufferMapped = 0;
+}
+
+
+void XMLDocument::SetHugePages( HugePages mode )
+{
+    _hugePages = mode;
+    _elementPool.SetHugePages( mode );
+    _attributePool.SetHugePages( mode );
+    _textPool.SetHugePages( mode );
+    _commentPool.SetHugePages( mode );
+}
+
+bool XMLDocument::Compact()
+{
+    AwaitAll();
+    const char* from = _charBuffer;
+    const char* to = _charBuffer + _charBufferCapacity;
+
+    // Count the nodes of the tree, and the characters they use.
+    int elements = 0;
+    int attributes = 0;
+    int texts = 0;
+    int others = 0;
+    size_t size = 0;
+    const XMLNode* node = FirstChild();
+    while ( node ) {
+        size += node->_value.RelocatedSize( from, to );
+        if ( const XMLElement* element = node->ToElement() ) {
+            if ( element->Unexpanded() ) {
+                return false;
+            }
+            ++elements;
+            for( const XMLAttribute* a = element->_rootAttribute; a; a = a->_next ) {
+                ++attributes;
+                size += a->_name.RelocatedSize( from, to ) + a->_value.RelocatedSize( from, to );
+            }
+        }
+        else if ( node->ToText() ) {
+            ++texts;
+        }
+        else {
+            ++others;
+        }
+        if ( node->FirstChild() ) {
+            node = node->FirstChild();
+            continue;
+        }
+        while ( node->Parent() != this && !node->NextSibling() ) {
+            node = node->Parent();
+        }
+        node = node->NextSibling();
+    }
+    // Orphan nodes would be freed with the blocks they live in.
+    if ( elements != _elementPool.CurrentAllocs() || attributes != _attributePool.CurrentAllocs()
+         || texts != _textPool.CurrentAllocs() || others != _commentPool.CurrentAllocs() ) {
+        return false;
+    }
+
+    size_t mapped = 0;
+    char* arena = NewBuffer( size, &mapped );
+    char* at = arena;
+    const int elementMark = _elementPool.BeginMove();
+    const int attributeMark = _attributePool.BeginMove();
+    const int textMark = _textPool.BeginMove();
+    const int commentMark = _commentPool.BeginMove();
+
+    // Copy each node where its parent's copy is, in depth-first order.
+    // The old tree is only read, its strings being taken over.
+    XMLNode* old = _firstChild;
+    XMLNode* parent = this;
+    _firstChild = _lastChild = 0;
+    while ( old ) {
+        XMLNode* copy = Relocate( old, from, to, &at );
+        parent->InsertEndChild( copy );
+        if ( old->_firstChild ) {
+            parent = copy;
+            old = old->_firstChild;
+            continue;
+        }
+        while ( old->_parent != this && !old->_next ) {
+            old = old->_parent;
+            parent = parent->_parent;
+        }
+        old = old->_next;
+    }
+    TIXMLASSERT( at == arena + size );
+
+    _elementPool.EndMove( elementMark, elements );
+    _attributePool.EndMove( attributeMark, attributes );
+    _textPool.EndMove( textMark, texts );
+    _commentPool.EndMove( commentMark, others );
+    DeleteBuffer();
+    _charBuffer = arena;
+    _charBufferCapacity = size;
+    _charBufferMapped = mapped;
+    _lineMark = 0;
+    _lineCount = 1;
+    return true;
+}
+
+
+XMLNode* XMLDocument::Relocate( XMLNode* node, const char* from, const char* to, char** arena )
+{
+    XMLNode* copy = 0;
+    if ( XMLElement* element = node->ToElement() ) {
+        XMLElement* e = new (_elementPool.Alloc()) XMLElement( this );
+        e->_memPool = &_elementPool;
+        e->_closingType = element->_closingType;
+        e->_line = element->_line;
+        e->_begin = element->_begin;
+        e->_end = element->_end;
+        copy = e;
+    }
+    else if ( XMLText* text = node->ToText() ) {
+        XMLText* t = new (_textPool.Alloc()) XMLText( this );
+        t->_memPool = &_textPool;
+        t->SetCData( text->CData() );
+        copy = t;
+    }
+    else {
+        if ( node->ToComment() ) {
+            copy = new (_commentPool.Alloc()) XMLComment( this );
+        }
+        else if ( node->ToDeclaration() ) {
+            copy = new (_commentPool.Alloc()) XMLDeclaration( this );
+        }
+        else {
+            TIXMLASSERT( node->ToUnknown() );
+            copy = new (_commentPool.Alloc()) XMLUnknown( this );
+        }
+        copy->_memPool = &_commentPool;
+    }
+    node->_value.TransferTo( &copy->_value );
+    copy->_value.Relocate( from, to, arena );
+    copy->_userData = node->_userData;
+
+    if ( XMLElement* element = node->ToElement() ) {
+        XMLAttribute* last = 0;
+        for( XMLAttribute* a = element->_rootAttribute; a; a = a->_next ) {
+            XMLAttribute* attrib = new (_attributePool.Alloc()) XMLAttribute();
+            attrib->_memPool = &_attributePool;
+            attrib->_memPool->SetTracked();
+            a->_name.TransferTo( &attrib->_name );
+            attrib->_name.Relocate( from, to, arena );
+            a->_value.TransferTo( &attrib->_value );
+            attrib->_value.Relocate( from, to, arena );
+            if ( last ) {
+                last->_next = attrib;
+            }
+            else {
+                copy->ToElement()->_rootAttribute = attrib;
+            }
+            last = attrib;
+        }
+    }
+    return copy;
+}
+
+
 void XMLDocument::Parse()
 {
     TIXMLASSERT( NoChildren() ); // Clear() must have been called previously
     TIXMLASSERT( _charBuffer );
     char* p = _charBuffer;
+    Await( p );
     p = XMLUtil::SkipWhiteSpace( p );
     p = const_cast<char*>( XMLUtil::ReadBOM( p, &_writeBOM ) );
     if ( !*p ) {
         SetError( XML_ERROR_EMPTY_DOCUMENT, 0, 0 );
         return;
     }
+    _lineMark = _charBuffer;
+    _lineCount = 1;
     ParseDeep(p, 0 );
 }
 
+
+// Tell if 'pattern' is in [p, end), and where it ends.
+static const char* FindIn( const char* p, const char* end, const char* pattern )
+{
+    const size_t length = strlen( pattern );
+    for( ; p + length <= end; ++p ) {
+        if ( memcmp( p, pattern, length ) == 0 ) {
+            return p + length;
+        }
+    }
+    return 0;
+}
+
+// Tell if the tag at 'p' is closed before 'end', its quoted values skipped.
+static bool TagIn( const char* p, const char* end )
+{
+    for( char quote = 0; p < end; ++p ) {
+        if ( quote ) {
+            quote = ( *p == quote ) ? 0 : quote;
+        }
+        else if ( *p == '"' || *p == '\'' ) {
+            quote = *p;
+        }
+        else if ( *p == '>' ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void XMLDocument::WaitFor( const char* p )
+{
+    for( ;; ) {
+        // [_charBuffer, fed] is written, and 'fed' is a '<'.
+        const char* const fed = _charBuffer + _fedTo;
+        const char* q = p;
+        while( q < fed && XMLUtil::IsWhiteSpace( *q ) ) {
+            ++q;
+        }
+        if ( q < fed ) {
+            const char* close = 0;
+            if ( *q != '<' ) {
+                // A text: it ends on a '<', 'fed' at the latest.
+                return;
+            }
+            if ( fed - q >= 4 && memcmp( q, "<!--", 4 ) == 0 ) {
+                close = "-->";
+            }
+            else if ( fed - q >= 9 && memcmp( q, "<![CDATA[", 9 ) == 0 ) {
+                close = "]]>";
+            }
+            else if ( q[1] == '?' ) {
+                close = "?>";
+            }
+            else if ( q[1] == '!' ) {
+                close = ">";
+            }
+            if ( close ? FindIn( q + 2, fed, close ) != 0 : TagIn( q + 1, fed ) ) {
+                return;
+            }
+        }
+        if ( _fedTo >= _fedEnd ) {
+            return;
+        }
+        _fedTo = _parseFeed->Ready( _fedTo );
+    }
+}
+
+void XMLDocument::AwaitAll()
+{
+    while( _parseFeed && _fedTo < _fedEnd ) {
+        _fedTo = _parseFeed->Ready( _fedTo );
+    }
+}
+
+
+int XMLDocument::LineOf( const char* p, const char* from, int fromLine )
+{
+    if ( from ) {
+        _lineMark = from;
+        _lineCount = fromLine;
+    }
+    TIXMLASSERT( _lineMark && _lineMark <= p );
+    const char* q = _lineMark;
+    while ( ( q = static_cast<const char*>( memchr( q, '\n', p - q ) ) ) != 0 ) {
+        ++_lineCount;
+        ++q;
+    }
+    _lineMark = p;
+    return _lineCount;
+}
+
 XMLPrinter::XMLPrinter( FILE* file, bool compact, int depth ) :
     _elementJustOpened( false ),
     _firstElement( true ),
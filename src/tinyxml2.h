@@ -41,6 +41,7 @@ distribution.
 #   include <cstring>
 #endif
 #include <stdint.h>
+#include <new>
 
 /*
    TODO: intern strings instead of allocation.
@@ -145,6 +146,14 @@ public:
 
     const char* GetStr();
 
+    /**
+    	The characters of the span as they are in the buffer : before
+    	GetStr() is first called, exactly as they were parsed (entities
+    	and newlines left as they are, and not null terminated) ; after,
+    	the processed string.
+    */
+    const char* Raw( size_t* length ) const;
+
     bool Empty() const {
         return _start == _end;
     }
@@ -161,6 +170,13 @@ public:
 
     void TransferTo( StrPair* other );
 
+    // internal: the bytes Relocate() copies, 0 if the characters are
+    // not in [from, to).
+    size_t RelocatedSize( const char* from, const char* to ) const;
+    // internal: copy the characters in [from, to) to '*arena', which
+    // is moved past them.
+    void Relocate( const char* from, const char* to, char** arena );
+
 private:
     void Reset();
     void CollapseWhitespace();
@@ -294,6 +310,35 @@ private:
 };
 
 
+/** How the character buffer and the memory pools of a document
+	are allocated (see XMLDocument::SetHugePages()).
+*/
+enum HugePages {
+    NO_HUGE_PAGES,			///< From the heap.
+    TRANSPARENT_HUGE_PAGES,	///< In 2 MB aligned regions, advised as huge pages.
+    RESERVED_HUGE_PAGES		///< From the reserved huge pages, as TRANSPARENT_HUGE_PAGES if there are none left.
+};
+
+
+/*
+	Memory taken in regions of 2 MB aligned on 2 MB, for the kernel to
+	back each one with a single huge page, so that walking a big
+	document misses the TLB once per 2 MB instead of once per 4 KB.
+	Where the system has no huge pages, or refuses the mapping, the
+	region silently comes from the heap.
+*/
+class PageRegion
+{
+public:
+    enum { SIZE = 2*1024*1024 };
+
+    // Take 'size' bytes, rounded up to SIZE, as 'mode' asks; '*mapped'
+    // is set to the length to give back to Free(), 0 if from the heap.
+    static char* Alloc( size_t size, HugePages mode, size_t* mapped );
+    static void Free( char* mem, size_t mapped );
+};
+
+
 /*
 	Parent virtual class of a pool for fast allocation
 	and deallocation of objects.
@@ -319,17 +364,25 @@ template< int SIZE >
 class MemPoolT : public MemPool
 {
 public:
-    MemPoolT() : _root(0), _currentAllocs(0), _nAllocs(0), _maxAllocs(0), _nUntracked(0)	{}
+    MemPoolT() : _root(0), _currentAllocs(0), _nAllocs(0), _maxAllocs(0), _nUntracked(0),
+        _hugePages(NO_HUGE_PAGES), _regionAt(0), _regionEnd(0)	{}
     ~MemPoolT() {
         Clear();
     }
     
     void Clear() {
-        // Delete the blocks.
+        // Delete the blocks, or the regions they were cut from.
         while( !_blockPtrs.Empty()) {
             Block* b  = _blockPtrs.Pop();
-            delete b;
+            if ( _regions.Empty() ) {
+                delete b;
+            }
+        }
+        while( !_regions.Empty() ) {
+            Region region = _regions.Pop();
+            PageRegion::Free( region.mem, region.mapped );
         }
+        _regionAt = _regionEnd = 0;
         _root = 0;
         _currentAllocs = 0;
         _nAllocs = 0;
@@ -337,6 +390,24 @@ public:
         _nUntracked = 0;
     }
 
+    // Keep the blocks, but thread all of them back into the free list in
+    // address order. Only legal once every item has been freed.
+    void Reset() {
+        TIXMLASSERT( _currentAllocs == 0 );
+        _root = 0;
+        for( int i=_blockPtrs.Size()-1; i>=0; --i ) {
+            Block* block = _blockPtrs[i];
+            for( int j=0; j<COUNT-1; ++j ) {
+                block->chunk[j].next = &block->chunk[j+1];
+            }
+            block->chunk[COUNT-1].next = _root;
+            _root = block->chunk;
+        }
+        _nAllocs = 0;
+        _maxAllocs = 0;
+        _nUntracked = 0;
+    }
+
     virtual int ItemSize() const	{
         return SIZE;
     }
@@ -344,10 +415,18 @@ public:
         return _currentAllocs;
     }
 
+    // Allocate the next blocks as 'mode' says. A pool keeps the mode
+    // of its first block: it only changes while it has none.
+    void SetHugePages( HugePages mode ) {
+        if ( _blockPtrs.Empty() ) {
+            _hugePages = mode;
+        }
+    }
+
     virtual void* Alloc() {
         if ( !_root ) {
             // Need a new block.
-            Block* block = new Block();
+            Block* block = NewBlock();
             _blockPtrs.Push( block );
 
             for( int i=0; i<COUNT-1; ++i ) {
@@ -393,6 +472,39 @@ public:
         return _nUntracked;
     }
 
+    // Start moving every item to new blocks: the next ones are taken
+    // past the blocks there are now, whose number is returned.
+    int BeginMove() {
+        _root = 0;
+        return _blockPtrs.Size();
+    }
+    // Drop the first 'mark' blocks, once the 'moved' items they held
+    // were all copied. No destructor is run.
+    void EndMove( int mark, int moved ) {
+        TIXMLASSERT( mark <= _blockPtrs.Size() );
+        _currentAllocs -= moved;
+        if ( !_regions.Empty() ) {
+            // A block cut from a region cannot be freed alone: its
+            // chunks are only made free again.
+            for( int i=mark-1; i>=0; --i ) {
+                Block* block = _blockPtrs[i];
+                for( int j=0; j<COUNT-1; ++j ) {
+                    block->chunk[j].next = &block->chunk[j+1];
+                }
+                block->chunk[COUNT-1].next = _root;
+                _root = block->chunk;
+            }
+            return;
+        }
+        for( int i=0; i<mark; ++i ) {
+            delete _blockPtrs[i];
+        }
+        for( int i=mark; i<_blockPtrs.Size(); ++i ) {
+            _blockPtrs[i-mark] = _blockPtrs[i];
+        }
+        _blockPtrs.PopArr( mark );
+    }
+
 	// This number is perf sensitive. 4k seems like a good tradeoff on my machine.
 	// The test file is large, 170k.
 	// Release:		VS2010 gcc(no opt)
@@ -415,6 +527,27 @@ private:
     struct Block {
         Chunk chunk[COUNT];
     };
+    struct Region {
+        char*  mem;
+        size_t mapped;
+    };
+
+    Block* NewBlock() {
+        if ( _hugePages == NO_HUGE_PAGES ) {
+            return new Block();
+        }
+        if ( _regionAt + sizeof( Block ) > _regionEnd ) {
+            Region region;
+            region.mem = PageRegion::Alloc( PageRegion::SIZE, _hugePages, &region.mapped );
+            _regions.Push( region );
+            _regionAt = region.mem;
+            _regionEnd = region.mem + PageRegion::SIZE;
+        }
+        Block* block = new (_regionAt) Block;
+        _regionAt += sizeof( Block );
+        return block;
+    }
+
     DynArray< Block*, 10 > _blockPtrs;
     Chunk* _root;
 
@@ -422,6 +555,11 @@ private:
     int _nAllocs;
     int _maxAllocs;
     int _nUntracked;
+
+    HugePages _hugePages;
+    DynArray< Region, 10 > _regions;
+    char* _regionAt;
+    char* _regionEnd;
 };
 
 
@@ -567,6 +705,29 @@ public:
     }
 
     static const char* ReadBOM( const char* p, bool* hasBOM );
+
+    /**
+    	Skip the content of an element whose opening tag was just read,
+    	up to and including its closing tag, by balancing the tags only:
+    	nothing is allocated, and the names of the skipped tags are not
+    	checked. Returns the character after the closing tag, or null if
+    	the element is never closed.
+    */
+    static char* SkipElement( char* p );
+    /**
+    	The same, resumable: '*depth' elements are open before 'p'.
+    	When the text ends before they are all closed, returns null,
+    	with '*depth' the elements still open and '*stop' where to
+    	scan again from once the text goes on (the start of the last
+    	tag, which may be cut).
+    */
+    static char* SkipElement( char* p, int* depth, char** stop );
+    /**
+    	Skip the rest of the tag 'p' is in, quoted attribute values
+    	included. Returns the character after its '>', or null if the
+    	tag is not complete.
+    */
+    static char* SkipTag( char* p );
     // p is the starting location,
     // the UTF-8 value of the entity will be placed in value, and length filled in.
     static const char* GetCharacterRef( const char* p, char* value, int* length );
@@ -687,6 +848,12 @@ public:
     */
     const char* Value() const;
 
+    /**
+    	The value as it is in the parsed buffer, without processing
+    	it (see StrPair::Raw()). 'length' gets its number of characters.
+    */
+    const char* RawValue( size_t* length ) const;
+
     /** Set the Value of an XML node.
     	@sa Value()
     */
@@ -1064,6 +1231,7 @@ private:
 class TINYXML2_LIB XMLAttribute
 {
     friend class XMLElement;
+    friend class XMLDocument;
 public:
     /// The name of the attribute.
     const char* Name() const;
@@ -1071,6 +1239,9 @@ public:
     /// The value of the attribute.
     const char* Value() const;
 
+    /// The value of the attribute as it is in the parsed buffer (see StrPair::Raw()).
+    const char* RawValue( size_t* length ) const;
+
     /// The next attribute in the list.
     const XMLAttribute* Next() const {
         return _next;
@@ -1174,6 +1345,7 @@ private:
 class TINYXML2_LIB XMLElement : public XMLNode
 {
     friend class XMLDocument;
+    friend class XMLNode;
 public:
     /// Get the name of an element (which is the Value() of the node.)
     const char* Name() const		{
@@ -1447,6 +1619,13 @@ public:
     */
     const char* GetText() const;
 
+    /**
+    	Same as GetText(), but the text as it is in the parsed buffer,
+    	without processing it (see StrPair::Raw()). 'length' gets its
+    	number of characters. Returns null if there is no text.
+    */
+    const char* GetRawText( size_t* length ) const;
+
     /** Convenience function for easy access to the text inside an element. Although easy
     	and concise, SetText() is limited compared to creating an XMLText child
     	and mutating it directly.
@@ -1542,6 +1721,43 @@ public:
     int ClosingType() const {
         return _closingType;
     }
+
+    /**
+    	The byte offset of the '<' of this element in the parsed buffer
+    	(the file, or what XMLDocument::ReserveBuffer() was given), and
+    	the one just past the '>' of its closing tag. Both are 0 if the
+    	element was not parsed.
+    */
+    size_t SourceBegin() const {
+        return _begin;
+    }
+    size_t SourceEnd() const {
+        return _end;
+    }
+    /**
+    	The line (from 1) the element starts on, if the document was
+    	parsed with XMLDocument::SetTrackLines(), 0 otherwise.
+    */
+    int SourceLine() const {
+        return _line;
+    }
+
+    /**
+    	True if the content of this element was skipped by a lazy parse
+    	(see XMLDocument::SetLazyDepth()): it has its attributes, but no
+    	children until Expand() is called.
+    */
+    bool Unexpanded() const {
+        return _lazy != 0;
+    }
+    /**
+    	Parse the content of an unexpanded element, down to the lazy
+    	depth of the document again, or all of it if 'all' is set.
+    	Does nothing on an expanded one.
+    	Returns XML_SUCCESS (0) on success, or an errorID.
+    */
+    XMLError Expand( bool all=false );
+
     virtual XMLNode* ShallowClone( XMLDocument* document ) const;
     virtual bool ShallowEqual( const XMLNode* compare ) const;
 
@@ -1564,10 +1780,15 @@ private:
 
     enum { BUF_SIZE = 200 };
     int _closingType;
+    int _line;
     // The attribute list is ordered; there is no 'lastAttribute'
     // because the list needs to be scanned for dupes before adding
     // a new attribute.
     XMLAttribute* _rootAttribute;
+    // The start of the content not parsed yet, if any.
+    char* _lazy;
+    size_t _begin;
+    size_t _end;
 };
 
 
@@ -1577,6 +1798,47 @@ enum Whitespace {
 };
 
 
+/** A filter the document asks, while parsing, which elements to keep.
+
+	Enter() is called on each opening tag, once its attributes are read but
+	before its content: an element it refuses is dropped, and its content
+	is skipped with XMLUtil::SkipElement() without creating any node.
+	Exit() is called when an element Enter() kept is complete.
+*/
+class TINYXML2_LIB XMLParseFilter
+{
+public:
+    virtual ~XMLParseFilter() {}
+
+    /// Return false to skip the element and all its content.
+    virtual bool Enter( const XMLElement& element ) = 0;
+    /// Called once a kept element is closed.
+    virtual void Exit( const XMLElement& /*element*/ ) {}
+};
+
+
+/** A feed the document waits on, while parsing a buffer still being written.
+
+	The parser only reads a node once the feed tells the characters up to a
+	'<' after it are written: in a well formed document, no element tag nor
+	text goes across a '<' it did not start with. Comments, CDATA, declarations
+	and processing instructions are waited for up to their end.
+*/
+class TINYXML2_LIB XMLParseFeed
+{
+public:
+    virtual ~XMLParseFeed() {}
+
+    /**
+    	Block until the buffer is complete past the offset 'after', or
+    	until it is all written. Return the offset it is complete up to,
+    	included: the offset of a '<' of the document, or its size once
+    	everything is written.
+    */
+    virtual size_t Ready( size_t after ) = 0;
+};
+
+
 /** A Document binds together all the functionality.
 	It can be saved, loaded, and printed to the screen.
 	All Nodes are connected and allocated to a Document.
@@ -1611,6 +1873,25 @@ public:
     */
     XMLError Parse( const char* xml, size_t nBytes=(size_t)(-1) );
 
+    /**
+    	Give direct access to the document character buffer, so
+    	that a custom reader (a decompressor, for example) can
+    	write the XML into it without an intermediate copy.
+    	The buffer is grown to hold at least 'size' characters
+    	plus the null terminator, and its first 'keep' characters
+    	are preserved. Call Clear() before filling it, and
+    	ParseBuffer() once it is filled.
+    */
+    char* ReserveBuffer( size_t size, size_t keep=0 );
+
+    /**
+    	Parse the first 'nBytes' characters of the buffer
+    	returned by ReserveBuffer().
+    	Returns XML_NO_ERROR (0) on success, or
+    	an errorID.
+    */
+    XMLError ParseBuffer( size_t nBytes );
+
     /**
     	Load an XML file from disk.
     	Returns XML_NO_ERROR (0) on success, or
@@ -1654,6 +1935,18 @@ public:
         return _whitespace;
     }
 
+    /**
+    	Change what the constructor was given, for the next parses :
+    	if the entities of the texts and attributes are decoded, and
+    	if the blanks of the texts are collapsed.
+    */
+    void SetProcessEntities( bool process ) {
+        _processEntities = process;
+    }
+    void SetWhitespaceMode( Whitespace whitespace ) {
+        _whitespace = whitespace;
+    }
+
     /**
     	Returns true if this document has a leading Byte Order Mark of UTF8.
     */
@@ -1762,6 +2055,115 @@ public:
     /// Clear the document, resetting it to the initial state.
     void Clear();
 
+    /**
+    	When set, Clear() (and so LoadFile() and Parse()) keeps the
+    	memory pool blocks and the character buffer instead of freeing
+    	them. A document reused for a stream of files then stops
+    	allocating once it has seen the largest of them.
+    	Everything is still released by the destructor.
+    */
+    void SetRetainMemory( bool retain ) {
+        _retainMemory = retain;
+    }
+    bool RetainMemory() const {
+        return _retainMemory;
+    }
+
+    /**
+    	Allocate the character buffer and the memory pools of the next
+    	parses as 'mode' says. With huge pages, a big document is walked
+    	with far fewer TLB misses, but each pool then takes 2 MB at
+    	least: it is meant for big documents. A buffer smaller than
+    	2 MB stays on the heap, and the pools that already hold blocks
+    	keep their mode, so set it before the first parse.
+    	Falls back to the heap where huge pages are not available.
+    */
+    void SetHugePages( HugePages mode );
+    HugePages HugePagesMode() const {
+        return _hugePages;
+    }
+
+    /**
+    	Move the nodes of a long-lived document into new pool blocks,
+    	in depth-first order, and the characters they use into a buffer
+    	just big enough for them, freeing the parsed one (markup,
+    	blanks and comments included) and the old blocks. A walk of the
+    	tree then reads memory forward. The nodes are copied, so they
+    	take twice their memory while it runs; the old blocks go back to
+    	the allocator, for the next allocations.
+    	Every pointer to a node or to a string of the document becomes
+    	invalid; the source offsets and lines are kept.
+    	Returns false, changing nothing, if an element is unexpanded
+    	(see SetLazyDepth()) or if a node is out of the tree.
+    */
+    bool Compact();
+
+    /**
+    	Set the filter the next parses ask which elements to keep,
+    	null (the default) to keep them all. The filter is not owned.
+    */
+    void SetParseFilter( XMLParseFilter* filter ) {
+        _parseFilter = filter;
+    }
+    XMLParseFilter* ParseFilter() const {
+        return _parseFilter;
+    }
+
+    /**
+    	Set the feed the next ParseBuffer() waits on, so that the buffer
+    	can be parsed while it is being written, null (the default) for a
+    	buffer already written. The feed is not owned.
+    */
+    void SetParseFeed( XMLParseFeed* feed ) {
+        _parseFeed = feed;
+    }
+    XMLParseFeed* ParseFeed() const {
+        return _parseFeed;
+    }
+
+    /**
+    	When set to a depth above 0, the next parses only read that
+    	many levels of elements: the content of the deepest ones is
+    	skipped with XMLUtil::SkipElement(), and parsed on demand by
+    	XMLElement::Expand(), again that many levels at a time.
+    	The names of the tags skipped are only checked on expansion.
+    */
+    void SetLazyDepth( int depth ) {
+        _lazyDepth = depth;
+    }
+    int LazyDepth() const {
+        return _lazyDepth;
+    }
+
+    /**
+    	When set, the next parses count the lines, so that each
+    	element knows the line it starts on (XMLElement::SourceLine()).
+    	The byte offsets are always recorded.
+    */
+    void SetTrackLines( bool track ) {
+        _trackLines = track;
+    }
+    bool TrackLines() const {
+        return _trackLines;
+    }
+
+    // internal: the line of 'p', counted from the last line asked for,
+    // or from 'from' on 'fromLine' if given.
+    int LineOf( const char* p, const char* from=0, int fromLine=0 );
+    // internal: the offset of 'p' in the buffer.
+    size_t OffsetOf( const char* p ) const {
+        return static_cast<size_t>( p - _charBuffer );
+    }
+
+    // internal: wait until the node at 'p' is written (see XMLParseFeed).
+    void Await( const char* p ) {
+        if ( _parseFeed && _fedTo < _fedEnd ) {
+            WaitFor( p );
+        }
+    }
+    // internal: wait until the whole buffer is written.
+    void AwaitAll();
+
     // internal
     char* Identify( char* p, XMLNode** node );
 
@@ -1778,11 +2180,23 @@ private:
 
     bool        _writeBOM;
     bool        _processEntities;
+    bool        _retainMemory;
     XMLError    _errorID;
     Whitespace  _whitespace;
     const char* _errorStr1;
     const char* _errorStr2;
     char*       _charBuffer;
+    size_t      _charBufferCapacity;
+    size_t      _charBufferMapped;
+    HugePages   _hugePages;
+    XMLParseFilter* _parseFilter;
+    int         _lazyDepth;
+    bool        _trackLines;
+    XMLParseFeed* _parseFeed;
+    size_t      _fedTo;
+    size_t      _fedEnd;
+    const char* _lineMark;
+    int         _lineCount;
 
     MemPoolT< sizeof(XMLElement) >	 _elementPool;
     MemPoolT< sizeof(XMLAttribute) > _attributePool;
@@ -1792,6 +2206,10 @@ private:
 	static const char* _errorNames[XML_ERROR_COUNT];
 
     void Parse();
+    void WaitFor( const char* p );
+    XMLNode* Relocate( XMLNode* node, const char* from, const char* to, char** arena );
+    char* NewBuffer( size_t size, size_t* mapped ) const;
+    void DeleteBuffer();
 };
 
 
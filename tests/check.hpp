@@ -0,0 +1,90 @@
+/**
+ * @file check.hpp
+ * @brief Defines the checks of the tests : each failed one is printed, and
+ * the test fails at the end if one did.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef CHECK_HPP_INCLUDED
+#define CHECK_HPP_INCLUDED
+
+#include <iostream>
+#include <string>
+
+/**
+ * @brief The number of checks failed so far.
+ */
+inline int& checkFailures(void)
+{
+	static int failures = 0;
+	return failures;
+}
+
+/**
+ * @brief Check that \a condition holds, print it with where it is otherwise.
+ */
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) \
+		{ \
+			std::cerr << "[ERROR]: " << __FILE__ << ":" << __LINE__ << " : " << #condition << std::endl; \
+			++checkFailures(); \
+		} \
+	} while (0)
+
+/**
+ * @brief Check that \a a equals \a b, print both otherwise.
+ */
+#define CHECK_EQUAL(a, b) \
+	do { \
+		if (!((a) == (b))) \
+		{ \
+			std::cerr << "[ERROR]: " << __FILE__ << ":" << __LINE__ << " : " << #a << " == " << #b \
+			          << " (" << (a) << " != " << (b) << ")" << std::endl; \
+			++checkFailures(); \
+		} \
+	} while (0)
+
+/**
+ * @brief Check that \a statement throws the std::string the library throws.
+ */
+#define CHECK_THROWS(statement) \
+	do { \
+		bool thrown = false; \
+		try { statement; } catch (const std::string&) { thrown = true; } \
+		if (!thrown) \
+		{ \
+			std::cerr << "[ERROR]: " << __FILE__ << ":" << __LINE__ << " : " << #statement << " did not throw" << std::endl; \
+			++checkFailures(); \
+		} \
+	} while (0)
+
+/**
+ * @brief Run \a test, counting what it throws as a failure.
+ */
+inline void run(const std::string &name, void (*test)(void))
+{
+	try
+	{
+		test();
+	}
+	catch (const std::string &error)
+	{
+		std::cerr << "[ERROR]: " << name << " threw " << error << std::endl;
+		++checkFailures();
+	}
+	std::cout << name << std::endl;
+}
+
+/**
+ * @brief The exit code of the test.
+ */
+inline int summary(void)
+{
+	if (checkFailures() != 0)
+		std::cerr << checkFailures() << " check(s) failed" << std::endl;
+	return checkFailures() == 0 ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,126 @@
+/**
+ * @file fixtures.hpp
+ * @brief Defines the documents the tests and the benchmarks load, generated
+ * so that none has to be stored.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#ifndef FIXTURES_HPP_INCLUDED
+#define FIXTURES_HPP_INCLUDED
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#ifdef RWXML_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef RWXML_WITH_ZSTD
+#include <vector>
+#include <zstd.h>
+#endif
+
+/**
+ * @brief Generate a catalog of \a count records, such as :
+ * @code
+ * <catalog><record id="sku-0" kind="0"><name>item 0</name><price>0.5</price><tags><tag>a</tag><tag>b0</tag></tags></record>...</catalog>
+ * @endcode
+ * The price of the record \b i is \b i + 0.5.
+ */
+inline std::string catalog(size_t count)
+{
+	std::string xml("<catalog>\n");
+	for (size_t i = 0; i < count; ++i)
+	{
+		const std::string n = std::to_string(i);
+		xml += "\t<record id=\"sku-" + n + "\" kind=\"" + std::to_string(i % 7) + "\">"
+		       "<name>item " + n + "</name><price>" + n + ".5</price>"
+		       "<tags><tag>a</tag><tag>b" + n + "</tag></tags></record>\n";
+	}
+	return xml + "</catalog>\n";
+}
+
+/**
+ * @brief Generate a catalog of \a count records of about \a bytes each : each
+ * one has as many \b item children as needed, numbered from 0.
+ */
+inline std::string bigRecords(size_t count, size_t bytes)
+{
+	std::string xml("<catalog>\n");
+	for (size_t i = 0; i < count; ++i)
+	{
+		std::string record = "<record id=\"" + std::to_string(i) + "\">";
+		for (size_t item = 0; record.size() < bytes; ++item)
+			record += "<item n=\"" + std::to_string(item) + "\">value</item>";
+		xml += record + "</record>\n";
+	}
+	return xml + "</catalog>\n";
+}
+
+/**
+ * @brief Generate \a depth elements nested in each other, the deepest one
+ * holding the text \b leaf.
+ */
+inline std::string deep(size_t depth)
+{
+	std::string xml;
+	xml.reserve(depth * 7 + 4);
+	for (size_t i = 0; i < depth; ++i)
+		xml += "<d>";
+	xml += "leaf";
+	for (size_t i = 0; i < depth; ++i)
+		xml += "</d>";
+	return xml;
+}
+
+/**
+ * @brief Write \a content into \a fname.
+ * @return \a fname.
+ */
+inline std::string writeFile(const std::string &fname, const std::string &content)
+{
+	std::ofstream out(fname.c_str(), std::ios::binary);
+	out.write(content.data(), content.size());
+	return fname;
+}
+
+/**
+ * @brief Read the whole content of \a fname, "" if it cannot be read.
+ */
+inline std::string readFile(const std::string &fname)
+{
+	std::ifstream in(fname.c_str(), std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+#ifdef RWXML_WITH_ZLIB
+/**
+ * @brief Write \a content gzipped into \a fname.
+ * @return \a fname.
+ */
+inline std::string writeGzip(const std::string &fname, const std::string &content)
+{
+	gzFile out = gzopen(fname.c_str(), "wb");
+	gzwrite(out, content.data(), static_cast<unsigned>(content.size()));
+	gzclose(out);
+	return fname;
+}
+#endif
+
+#ifdef RWXML_WITH_ZSTD
+/**
+ * @brief Write \a content compressed with zstd into \a fname, as a single frame.
+ * @return \a fname.
+ */
+inline std::string writeZstd(const std::string &fname, const std::string &content)
+{
+	std::vector<char> packed(ZSTD_compressBound(content.size()));
+	const size_t size = ZSTD_compress(packed.data(), packed.size(), content.data(), content.size(), 3);
+	std::ofstream out(fname.c_str(), std::ios::binary);
+	out.write(packed.data(), static_cast<std::streamsize>(size));
+	return fname;
+}
+#endif
+
+#endif
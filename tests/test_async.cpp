@@ -0,0 +1,131 @@
+/**
+ * @file test_async.cpp
+ * @brief Tests XmlLoader::openAsync() (C++20, built with rwxml_async only) :
+ * the coroutine is resumed on its executor, here a loop run by the main
+ * thread, with the loader ready or with the exception of the loading.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+/**
+ * @brief A coroutine started at once, whose end is told by done().
+ */
+struct Task
+{
+	struct promise_type
+	{
+		Task get_return_object(void) { return Task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+		std::suspend_never initial_suspend(void) noexcept { return {}; }
+		std::suspend_always final_suspend(void) noexcept { return {}; }
+		void return_void(void) {}
+		void unhandled_exception(void) { std::terminate(); }
+	};
+
+	std::coroutine_handle<promise_type> handle; //!< The coroutine.
+
+	Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+	Task(const Task &other) = delete;
+	~Task(void) { this->handle.destroy(); }
+
+	bool done(void) const { return this->handle.done(); }
+};
+
+/**
+ * @brief A single threaded executor : the functions posted are run by the
+ * thread calling run(), one at a time.
+ */
+class Loop
+{
+	private:
+		std::mutex                            mutex;  //!< Guards queue.
+		std::condition_variable               posted; //!< Notified once a function is posted.
+		std::deque<std::function<void(void)>> queue;  //!< The functions posted, not run yet.
+
+	public:
+		//! @brief The executor posting to this loop.
+		XmlLoading::Executor executor(void)
+		{
+			return [this](std::function<void(void)> work) {
+				std::lock_guard<std::mutex> lock(this->mutex);
+				this->queue.push_back(std::move(work));
+				this->posted.notify_one();
+			};
+		}
+
+		//! @brief Run what is posted until \a task is done.
+		void run(const Task &task)
+		{
+			while (!task.done())
+			{
+				std::unique_lock<std::mutex> lock(this->mutex);
+				this->posted.wait(lock, [this]() { return !this->queue.empty(); });
+				std::function<void(void)> work = std::move(this->queue.front());
+				this->queue.pop_front();
+				lock.unlock();
+				work();
+			}
+		}
+};
+
+/**
+ * @brief Load \a fname, and tell on which thread the coroutine was resumed, what it read or what it caught.
+ */
+static Task open(const std::string &fname, Loop &loop, std::thread::id &resumed, std::string &read)
+{
+	try
+	{
+		std::unique_ptr<XmlLoader> loader = co_await XmlLoader::openAsync(fname, loop.executor());
+		resumed = std::this_thread::get_id();
+		read = loader->name() + " " + std::to_string(loader->select("record").size());
+	}
+	catch (const std::string &)
+	{
+		resumed = std::this_thread::get_id();
+		read = "error";
+	}
+}
+
+/**
+ * @brief The coroutine is resumed by the loop, with the document loaded.
+ */
+static void loaded(void)
+{
+	writeFile("async.xml", catalog(5000));
+	Loop loop;
+	std::thread::id resumed;
+	std::string read;
+	Task task = open("async.xml", loop, resumed, read);
+	CHECK(!task.done());
+	loop.run(task);
+	CHECK(resumed == std::this_thread::get_id());
+	CHECK_EQUAL(read, std::string("catalog 5000"));
+}
+
+/**
+ * @brief The coroutine is resumed by the loop, with what the loading threw.
+ */
+static void missing(void)
+{
+	Loop loop;
+	std::thread::id resumed;
+	std::string read;
+	Task task = open("async-missing.xml", loop, resumed, read);
+	loop.run(task);
+	CHECK(resumed == std::this_thread::get_id());
+	CHECK_EQUAL(read, std::string("error"));
+}
+
+int main(void)
+{
+	run("async loaded", loaded);
+	run("async missing", missing);
+	return summary();
+}
@@ -0,0 +1,79 @@
+/**
+ * @file test_attributes.cpp
+ * @brief Tests that a XmlAttributeMap reads the same as XmlLoader::attribute().
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+/**
+ * @brief What a record is read into.
+ */
+struct Record
+{
+	std::string id;
+	int         kind   = -1;
+	double      weight = -1.0;
+	bool        sale   = false;
+	uint64_t    stock  = 0;
+};
+
+/**
+ * @brief Every attribute known is read into its member, the others are left unchanged.
+ */
+static void members(void)
+{
+	writeFile("attributes.xml",
+		"<catalog>"
+		"<record id=\"a\" kind=\"3\" weight=\"1.25\" sale=\"true\" stock=\"18446744073709551615\" other=\"x\"/>"
+		"<record id=\"b\" kind=\"many\"/>"
+		"</catalog>");
+	static const auto fields = xmlAttributes(
+		xmlField("id",     &Record::id),
+		xmlField("kind",   &Record::kind),
+		xmlField("weight", &Record::weight),
+		xmlField("sale",   &Record::sale),
+		xmlField("stock",  &Record::stock));
+	CHECK_EQUAL(fields.size(), 5u);
+
+	XmlLoader loader("attributes.xml");
+	std::vector<Record> records;
+	loader.forEachNodeNamed("record", [&]() {
+		Record record;
+		loader.attributes(fields, record);
+		CHECK_EQUAL(record.id, loader.attribute<std::string>("id"));
+		records.push_back(record);
+	});
+	CHECK_EQUAL(records.size(), 2u);
+	CHECK_EQUAL(records[0].kind, 3);
+	CHECK_EQUAL(records[0].weight, 1.25);
+	CHECK(records[0].sale);
+	CHECK_EQUAL(records[0].stock, 18446744073709551615ULL);
+	CHECK_EQUAL(records[1].kind, -1);
+	CHECK_EQUAL(records[1].weight, -1.0);
+
+	size_t read = 0;
+	loader.forEachNodeNamed("record", [&](XmlCursor record) {
+		Record out;
+		read += record.attributes(fields, out);
+	});
+	CHECK_EQUAL(read, 6u);
+}
+
+/**
+ * @brief An attribute cannot be mapped twice.
+ */
+static void twice(void)
+{
+	CHECK_THROWS(xmlAttributes(xmlField("id", &Record::id), xmlField("id", &Record::kind)));
+}
+
+int main(void)
+{
+	run("attributes members", members);
+	run("attributes twice", twice);
+	return summary();
+}
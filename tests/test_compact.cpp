@@ -0,0 +1,137 @@
+/**
+ * @file test_compact.cpp
+ * @brief Tests that a compacted document reads as it did before : its nodes,
+ * their characters (entities and CDATA included), offsets and lines, loaded
+ * at once or lazily.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+/**
+ * @brief A catalog with everything a text or an attribute can hold.
+ */
+static std::string mixed(size_t records)
+{
+	std::string xml("<catalog>\n\t<!-- the records -->\n");
+	for (size_t i = 0; i < records; ++i)
+	{
+		const std::string n = std::to_string(i);
+		xml += "\t<record id=\"sku-" + n + "\" note=\"a &amp; b &#233;\">\n"
+		       "\t\t<name>item &lt;" + n + "&gt;</name>\n"
+		       "\t\t<code><![CDATA[<raw " + n + ">]]></code>\n"
+		       "\t\t<price>" + n + ".5</price>\n"
+		       "\t\t<empty/>\n"
+		       "\t\t<tags><tag>a</tag><tag>b" + n + "</tag></tags>\n"
+		       "\t</record>\n";
+	}
+	return xml + "</catalog>\n";
+}
+
+/**
+ * @brief Print \a cursor and everything below it, with the offsets, lines and texts read.
+ */
+static void dump(XmlCursor cursor, std::string &out)
+{
+	xml2::XMLPrinter printer;
+	cursor.get()->Accept(&printer);
+	out += printer.CStr();
+	for (XmlCursor child : cursor.children())
+	{
+		out += child.name() + " " + std::to_string(child.sourceBegin()) + "-" + std::to_string(child.sourceEnd());
+		out += " " + std::to_string(child.sourceLine()) + " " + child.text<std::string>() + "|";
+		out += child.attribute<std::string>("note") + "\n";
+		dump(child, out);
+	}
+}
+
+/**
+ * @brief Print the document of \a loader, from its root.
+ */
+static std::string dump(XmlLoader &loader)
+{
+	std::string out;
+	for (XmlCursor child : loader.backToRoot().children())
+		dump(child, out);
+	return out;
+}
+
+/**
+ * @brief The same reads before and after compacting, the document loaded at once.
+ */
+static void eager(void)
+{
+	XmlOptions options;
+	options.lineNumbers = true;
+	XmlLoader loader(writeFile("compact.xml", mixed(500)), options);
+	const std::string before = dump(loader);
+	CHECK(before.find("item <7>") != std::string::npos);
+	CHECK(before.find("<raw 7>") != std::string::npos);
+	CHECK_EQUAL(dump(loader.compact()), before);
+	CHECK_EQUAL(dump(loader.compact()), before);
+
+	// The navigation starts again from the root.
+	loader.node("record");
+	CHECK_EQUAL(loader.attribute<std::string>("id"), std::string("sku-0"));
+	CHECK_EQUAL(loader.element("code").text<std::string>(), std::string("<raw 0>"));
+}
+
+/**
+ * @brief A lazily loaded document, partly expanded or not, compacts as the document loaded at once.
+ */
+static void lazy(void)
+{
+	XmlOptions options;
+	options.lineNumbers = true;
+	XmlLoader eager(writeFile("compact.xml", mixed(500)), options);
+	const std::string expected = dump(eager);
+	options.lazyDepth = 1;
+	XmlLoader untouched("compact.xml", options);
+	CHECK_EQUAL(dump(untouched.compact()), expected);
+	XmlLoader partly("compact.xml", options);
+	partly.node("record").element("price");
+	CHECK_EQUAL(partly.text<std::string>(), std::string("0.5"));
+	CHECK_EQUAL(dump(partly.compact()), expected);
+}
+
+/**
+ * @brief A frozen document is not anymore once compacted, and hashes the same.
+ */
+static void frozen(void)
+{
+	XmlLoader loader(writeFile("compact.xml", mixed(200)));
+	loader.hashAll();
+	const uint64_t before = loader.node("record").hash();
+	CHECK(before != 0u);
+	loader.compact();
+	CHECK(!loader.frozen());
+	loader.hashAll();
+	CHECK_EQUAL(loader.node("record").hash(), before);
+}
+
+/**
+ * @brief A compacted loader reloads another file, and compacts it.
+ */
+static void reloaded(void)
+{
+	XmlLoader loader(writeFile("compact.xml", mixed(50)));
+	loader.compact();
+	writeFile("compact-2.xml", catalog(300));
+	XmlLoader fresh("compact-2.xml");
+	const std::string expected = dump(fresh);
+	loader.reload("compact-2.xml");
+	CHECK_EQUAL(dump(loader), expected);
+	CHECK_EQUAL(dump(loader.compact()), expected);
+}
+
+int main(void)
+{
+	run("compact eager", eager);
+	run("compact lazy", lazy);
+	run("compact frozen", frozen);
+	run("compact reloaded", reloaded);
+	return summary();
+}
@@ -0,0 +1,149 @@
+/**
+ * @file test_cursor.cpp
+ * @brief Tests the cursor mode of XmlLoader, and the steps to the next element
+ * or node whatever its name.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const char *people =
+	"<people>\n"
+	"\t<person><name>A</name><age>1</age><city>X</city></person>\n"
+	"\t<person><age>2</age><name>B</name></person>\n"
+	"\t<values><v>1</v><v>2</v><v>3</v></values>\n"
+	"\t<values><v>4</v><v>5</v></values>\n"
+	"\t<empty/>\n"
+	"</people>\n"; //!< The document of every test.
+
+/**
+ * @brief The fields of each record, read in any order, whatever the order they are in.
+ */
+static void fields(void)
+{
+	XmlLoader loader(writeFile("cursor.xml", people));
+	loader.cursorMode(true);
+	std::string seen;
+	loader.forEachNodeNamed("person", [&]() {
+		seen += loader.element("name").text<std::string>();
+		seen += loader.element("age").text<std::string>();
+		seen += ";";
+	});
+	CHECK_EQUAL(seen, std::string("A1;B2;"));
+}
+
+/**
+ * @brief A field not found after the cursor is searched from the first child,
+ * and one found nowhere leaves the cursor where it was.
+ */
+static void wrap(void)
+{
+	XmlLoader loader(writeFile("cursor.xml", people));
+	loader.cursorMode(true).node("person");
+	CHECK_EQUAL(loader.element("city").text<std::string>(), std::string("X"));
+	CHECK_EQUAL(loader.element("name").text<std::string>(), std::string("A"));
+	loader.element("missing");
+	CHECK_EQUAL(loader.name(), std::string(""));
+	CHECK_EQUAL(loader.element("age").text<std::string>(), std::string("1"));
+	CHECK_EQUAL(loader.element("city").text<std::string>(), std::string("X"));
+}
+
+/**
+ * @brief Children of the same name are read one after the other, wrapping
+ * at the end ; without the cursor, the first one is always read.
+ */
+static void repeated(void)
+{
+	XmlLoader loader(writeFile("cursor.xml", people));
+	loader.node("values");
+	std::string seen;
+	for (int i = 0; i < 4; ++i)
+		seen += loader.element("v").text<std::string>();
+	CHECK_EQUAL(seen, std::string("1111"));
+	loader.cursorMode(true);
+	seen.clear();
+	for (int i = 0; i < 4; ++i)
+		seen += loader.element("v").text<std::string>();
+	CHECK_EQUAL(seen, std::string("1231"));
+	loader.cursorMode(false);
+	CHECK_EQUAL(loader.element("v").text<std::string>(), std::string("1"));
+}
+
+/**
+ * @brief The cursor is dropped each time the current node changes.
+ */
+static void dropped(void)
+{
+	XmlLoader loader(writeFile("cursor.xml", people));
+	loader.cursorMode(true).node("values");
+	loader.element("v");
+	loader.element("v");
+	CHECK_EQUAL(loader.prev().node("values").element("v").text<std::string>(), std::string("1"));
+	loader.element("v");
+	CHECK_EQUAL(loader.backToRoot().node("values").element("v").text<std::string>(), std::string("1"));
+	loader.element("v");
+	CHECK(loader.nextNode());
+	CHECK_EQUAL(loader.element("v").text<std::string>(), std::string("4"));
+	CHECK_EQUAL(loader.element("v").text<std::string>(), std::string("5"));
+
+	std::string seen;
+	loader.backToRoot().forEachNodeNamed("values", [&]() {
+		seen += loader.element("v").text<std::string>();
+	});
+	CHECK_EQUAL(seen, std::string("14"));
+}
+
+/**
+ * @brief nextElement() steps over children of different names, and stops on the
+ * last one ; element() in cursor mode goes on from where it stopped.
+ */
+static void nextElement(void)
+{
+	XmlLoader loader(writeFile("cursor.xml", people));
+	loader.node("person");
+	std::string seen;
+	while (loader.nextElement())
+		seen += loader.name() + "=" + loader.text<std::string>() + " ";
+	CHECK_EQUAL(seen, std::string("name=A age=1 city=X "));
+	CHECK_EQUAL(loader.name(), std::string("city"));
+
+	loader.prev().node("person").cursorMode(true);
+	CHECK(loader.nextElement());
+	CHECK_EQUAL(loader.element("city").text<std::string>(), std::string("X"));
+	CHECK(!loader.nextElement());
+	CHECK_EQUAL(loader.name(), std::string("city"));
+
+	// A node without children : the node stays selected.
+	loader.backToRoot().node("empty");
+	CHECK(!loader.nextElement());
+	CHECK_EQUAL(loader.name(), std::string("empty"));
+}
+
+/**
+ * @brief nextNode() steps over siblings of different names, and stops on the last one.
+ */
+static void nextNode(void)
+{
+	XmlLoader loader(writeFile("cursor.xml", people));
+	loader.node("person");
+	std::string seen = loader.name();
+	while (loader.nextNode())
+		seen += " " + loader.name();
+	CHECK_EQUAL(seen, std::string("person person values values empty"));
+	CHECK_EQUAL(loader.name(), std::string("empty"));
+	CHECK_EQUAL(loader.prev().name(), std::string("people"));
+}
+
+int main(void)
+{
+	run("cursor fields", fields);
+	run("cursor wrap", wrap);
+	run("cursor repeated", repeated);
+	run("cursor dropped", dropped);
+	run("cursor next element", nextElement);
+	run("cursor next node", nextNode);
+	return summary();
+}
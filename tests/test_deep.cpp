@@ -0,0 +1,79 @@
+/**
+ * @file test_deep.cpp
+ * @brief Tests that documents far deeper than the call stack allows to recurse
+ * are parsed, visited, printed and deleted.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const size_t depth = 1000000; //!< The depth of the documents.
+
+/**
+ * @brief The number of elements from \a top down to its deepest first child.
+ */
+static size_t measureDepth(const xml2::XMLElement *top)
+{
+	size_t levels = 0;
+	for (const xml2::XMLElement *at = top; at != nullptr; at = at->FirstChildElement())
+		++levels;
+	return levels;
+}
+
+/**
+ * @brief A deep document is parsed, printed as it was, and deleted,
+ * and a deep mismatch is found.
+ */
+static void document(void)
+{
+	const std::string xml = deep(depth);
+	{
+		xml2::XMLDocument doc;
+		CHECK_EQUAL(doc.Parse(xml.data(), xml.size()), xml2::XML_SUCCESS);
+		CHECK_EQUAL(measureDepth(doc.RootElement()), depth);
+
+		xml2::XMLPrinter printer(nullptr, true);
+		doc.Print(&printer);
+		CHECK(std::string(printer.CStr()) == xml);
+	}
+
+	std::string broken = xml;
+	broken.replace(broken.size() - 4, 4, "</e>");
+	xml2::XMLDocument doc;
+	CHECK_EQUAL(doc.Parse(broken.data(), broken.size()), xml2::XML_ERROR_MISMATCHED_ELEMENT);
+}
+
+/**
+ * @brief A deep document is loaded, lazily too, and walked down to its leaf.
+ */
+static void loader(void)
+{
+	writeFile("deep.xml", deep(depth));
+	for (unsigned lazy = 0; lazy <= 64; lazy += 64)
+	{
+		XmlOptions options;
+		options.lazyDepth = lazy;
+		XmlLoader loader("deep.xml", options);
+		XmlCursor last;
+		for (XmlCursor child : loader.children("d"))
+			last = child;
+		size_t levels = 1;
+		for (XmlCursor d = last; d; d = d.element("d"))
+		{
+			last = d;
+			++levels;
+		}
+		CHECK_EQUAL(levels, depth);
+		CHECK_EQUAL(last.text<std::string>(), std::string("leaf"));
+	}
+}
+
+int main(void)
+{
+	run("deep document", document);
+	run("deep loader", loader);
+	return summary();
+}
@@ -0,0 +1,110 @@
+/**
+ * @file test_editor.cpp
+ * @brief Tests that XmlEditor saves what was not changed byte for byte,
+ * navigates as XmlLoader does, and does not save a compressed file as plain xml.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlEditor.hpp"
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const std::string original =
+	"<catalog version=\"1\">\n"
+	"  <!-- the records -->\n"
+	"  <record id=\"a\"><name>A &amp; B</name><price>1.5</price></record>\n"
+	"  <note>keep   this</note>\n"
+	"  <record id=\"b\" ><name>B</name><price>2</price></record>\n"
+	"</catalog>\n"; //!< The file edited.
+
+/**
+ * @brief Saving without any change copies the file.
+ */
+static void unchanged(void)
+{
+	XmlEditor editor(writeFile("editor.xml", original));
+	CHECK(!editor.modified());
+	editor.saveAs("editor-copy.xml");
+	CHECK_EQUAL(readFile("editor-copy.xml"), original);
+}
+
+/**
+ * @brief Only what was changed is written again, and it can be saved twice
+ * over the file loaded.
+ */
+static void changed(void)
+{
+	XmlEditor editor(writeFile("editor.xml", original));
+	editor.node("record").element("price").text() = 3;
+	editor.save();
+	std::string expected = original;
+	expected.replace(expected.find("1.5"), 3, "3");
+	CHECK_EQUAL(readFile("editor.xml"), expected);
+
+	editor.backToRoot().node("record");
+	CHECK(editor.nextNode());
+	editor.attribute("id") = "c";
+	editor.save();
+	expected.replace(expected.find("<note>"), 6, "<note id=\"c\">");
+	CHECK_EQUAL(readFile("editor.xml"), expected);
+}
+
+/**
+ * @brief nextNode() moves to the next sibling whatever its name, as XmlLoader::nextNode().
+ */
+static void nextNode(void)
+{
+	writeFile("editor.xml", original);
+	XmlLoader loader("editor.xml");
+	XmlEditor editor("editor.xml");
+	loader.node("record");
+	editor.node("record");
+	while(loader.nextNode())
+	{
+		CHECK(editor.nextNode());
+		editor.attribute("seen") = true;
+	}
+	CHECK(!editor.nextNode());
+	editor.saveAs("editor-seen.xml");
+
+	XmlLoader seen("editor-seen.xml");
+	CHECK_EQUAL(seen.element("note").attribute<bool>("seen"), true);
+	CHECK_EQUAL(seen.text<std::string>(), std::string("keep   this"));
+	seen.backToRoot().node("record");
+	CHECK_EQUAL(seen.attribute<bool>("seen"), false);
+	CHECK(seen.nextNode());
+	CHECK(seen.nextNode());
+	CHECK_EQUAL(seen.attribute<std::string>("id"), std::string("b"));
+	CHECK_EQUAL(seen.attribute<bool>("seen"), true);
+}
+
+#ifdef RWXML_WITH_ZLIB
+/**
+ * @brief A compressed file is not replaced by plain xml : it has to be saved as another file.
+ */
+static void compressed(void)
+{
+	const std::string packed = readFile(writeGzip("editor.xml.gz", original));
+	XmlEditor editor("editor.xml.gz");
+	editor.node("record").element("price").text() = 3;
+	CHECK_THROWS(editor.save());
+	CHECK_EQUAL(readFile("editor.xml.gz"), packed);
+	editor.saveAs("editor-plain.xml");
+	std::string expected = original;
+	expected.replace(expected.find("1.5"), 3, "3");
+	CHECK_EQUAL(readFile("editor-plain.xml"), expected);
+}
+#endif
+
+int main(void)
+{
+	run("editor unchanged", unchanged);
+	run("editor changed", changed);
+	run("editor nextNode", nextNode);
+#ifdef RWXML_WITH_ZLIB
+	run("editor compressed", compressed);
+#endif
+	return summary();
+}
@@ -0,0 +1,73 @@
+/**
+ * @file test_flat.cpp
+ * @brief Tests that a frozen document is navigated as the document itself,
+ * and that its structural hashes tell equal subtrees apart from different ones.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+/**
+ * @brief What the loader reads of every record, through its current node.
+ */
+static std::string walk(XmlLoader &loader)
+{
+	std::string seen;
+	loader.forEachNodeNamed("record", [&]() {
+		seen += loader.attribute<std::string>("id") + "=" + loader.element("price").text<std::string>();
+		loader.node("tags").forEachElementNamed("tag", [&]() { seen += "," + loader.text<std::string>(); });
+		loader.prev();
+		seen += ";";
+	});
+	return seen;
+}
+
+/**
+ * @brief The frozen document reads the same, until the next reload().
+ */
+static void navigation(void)
+{
+	XmlLoader loader(writeFile("flat.xml", catalog(1000)));
+	const std::string expected = walk(loader);
+	loader.freeze();
+	CHECK(loader.frozen());
+	CHECK_EQUAL(walk(loader), expected);
+
+	loader.cursorMode(true);
+	CHECK_EQUAL(walk(loader), expected);
+	loader.cursorMode(false);
+
+	loader.reload("flat.xml");
+	CHECK(!loader.frozen());
+	CHECK_EQUAL(walk(loader), expected);
+}
+
+/**
+ * @brief Equal subtrees hash the same, in one document or in two, whatever the threads.
+ */
+static void hashes(void)
+{
+	writeFile("flat-a.xml", "<net><host name=\"a\"><ip>1</ip></host><host name=\"a\"><ip>1</ip></host><host name=\"a\"><ip>2</ip></host></net>");
+	writeFile("flat-b.xml", "<net><host name=\"a\"><ip>1</ip></host></net>");
+	XmlLoader a("flat-a.xml");
+	XmlLoader b("flat-b.xml");
+	a.hashAll(4);
+	b.hashAll();
+	std::vector<uint64_t> hosts;
+	a.forEachNodeNamed("host", [&]() { hosts.push_back(a.hash()); });
+	CHECK_EQUAL(hosts.size(), 3u);
+	CHECK_EQUAL(hosts[0], hosts[1]);
+	CHECK(hosts[0] != hosts[2]);
+	CHECK_EQUAL(b.node("host").hash(), hosts[0]);
+	CHECK(a.hash() != b.hash());
+}
+
+int main(void)
+{
+	run("flat navigation", navigation);
+	run("flat hashes", hashes);
+	return summary();
+}
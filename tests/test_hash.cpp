@@ -0,0 +1,68 @@
+/**
+ * @file test_hash.cpp
+ * @brief Tests that XmlLoader::hashAll() gives every element the same hash
+ * whatever the number of threads, on wide, deep and uneven documents.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <vector>
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+/**
+ * @brief The hash of every element of \a fname, in document order, hashed with \a threads.
+ */
+static std::vector<uint64_t> hashes(const std::string &fname, unsigned threads)
+{
+	XmlLoader loader(fname);
+	loader.hashAll(threads);
+	std::vector<uint64_t> all(1, loader.backToRoot().hash());
+	for (const XmlCursor &element : loader.select("//*"))
+		all.push_back(loader.hash(element));
+	return all;
+}
+
+/**
+ * @brief Every element hashes the same with 2, 3, 4, 8 threads or one per core
+ * as from this thread only, and none is left at 0.
+ */
+static void threads(void)
+{
+	std::string uneven("<root>");
+	for (int i = 0; i < 50; ++i)
+		uneven += (i % 10 == 0) ? bigRecords(20, 2000) : "<leaf n=\"" + std::to_string(i) + "\">x</leaf>";
+	uneven += deep(3000) + "</root>";
+
+	for (const std::string &xml : {catalog(20000), bigRecords(300, 5000), deep(5000), uneven,
+	                               std::string("<a><b/></a>"), std::string("<a/>")})
+	{
+		writeFile("hash.xml", xml);
+		const std::vector<uint64_t> expected = hashes("hash.xml", 1);
+		CHECK_EQUAL(expected.size(), XmlLoader("hash.xml").select("//*").size() + 1);
+		for (uint64_t hash : expected)
+			CHECK(hash != 0);
+		for (unsigned count : {2u, 3u, 4u, 8u, 0u})
+			CHECK(hashes("hash.xml", count) == expected);
+	}
+}
+
+/**
+ * @brief A second hashAll() keeps the hashes of the first, whatever it is asked.
+ */
+static void again(void)
+{
+	XmlLoader loader(writeFile("hash.xml", catalog(2000)));
+	loader.hashAll(4);
+	const uint64_t before = loader.node("record").hash();
+	CHECK_EQUAL(loader.hashAll(1).backToRoot().node("record").hash(), before);
+	CHECK_EQUAL(loader.hashAll(0).backToRoot().node("record").hash(), before);
+}
+
+int main(void)
+{
+	run("hash threads", threads);
+	run("hash again", again);
+	return summary();
+}
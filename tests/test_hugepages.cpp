@@ -0,0 +1,139 @@
+/**
+ * @file test_hugepages.cpp
+ * @brief Tests that documents allocated in huge page regions read as the ones
+ * allocated from the heap : loaded, reloaded, compacted, lazily or streamed.
+ * Where the system has no huge pages, the regions come from the heap, and are
+ * still used as regions.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const xml2::HugePages modes[] = {xml2::TRANSPARENT_HUGE_PAGES, xml2::RESERVED_HUGE_PAGES}; //!< The modes tested.
+
+/**
+ * @brief Everything \a loader reads of its catalog.
+ */
+static std::string dump(XmlLoader &loader)
+{
+	std::string out;
+	for (XmlCursor record : loader.backToRoot().children("record"))
+	{
+		out += record.attribute<std::string>("id") + " " + std::to_string(record.sourceBegin()) + " ";
+		out += record.element("name").text<std::string>() + " " + record.element("price").text<std::string>();
+		for (XmlCursor tag : record.element("tags").children("tag"))
+			out += " " + tag.text<std::string>();
+		out += "\n";
+	}
+	return out;
+}
+
+/**
+ * @brief The options with \a mode, the others as given.
+ */
+static XmlOptions with(xml2::HugePages mode, XmlOptions options = XmlOptions())
+{
+	options.hugePages = mode;
+	return options;
+}
+
+/**
+ * @brief A small and a big catalog, several regions of nodes and characters.
+ */
+static void load(void)
+{
+	for (size_t records : {10, 60000})
+	{
+		XmlLoader heap(writeFile("huge.xml", catalog(records)));
+		const std::string expected = dump(heap);
+		for (xml2::HugePages mode : modes)
+		{
+			XmlLoader huge("huge.xml", with(mode));
+			CHECK(dump(huge) == expected);
+		}
+	}
+}
+
+/**
+ * @brief Reloading bigger and smaller documents, from files and buffers, reuses the regions.
+ */
+static void reload(void)
+{
+	const std::string big = catalog(60000);
+	const std::string small = catalog(500);
+	XmlLoader heapBig(writeFile("huge-big.xml", big));
+	XmlLoader heapSmall(writeFile("huge-small.xml", small));
+	const std::string expectedBig = dump(heapBig);
+	const std::string expectedSmall = dump(heapSmall);
+	for (xml2::HugePages mode : modes)
+	{
+		XmlLoader huge("huge-small.xml", with(mode));
+		for (int i = 0; i < 3; ++i)
+		{
+			CHECK(dump(huge.reload("huge-big.xml")) == expectedBig);
+			CHECK(dump(huge.reload("huge-small.xml")) == expectedSmall);
+			CHECK(dump(huge.reload(big.data(), big.size())) == expectedBig);
+		}
+	}
+}
+
+/**
+ * @brief A document compacted into regions, loaded at once or lazily, reads as before,
+ * and the loader reloads after.
+ */
+static void compact(void)
+{
+	XmlLoader heap(writeFile("huge.xml", catalog(60000)));
+	const std::string expected = dump(heap);
+	XmlOptions lazy;
+	lazy.lazyDepth = 1;
+	for (xml2::HugePages mode : modes)
+	{
+		for (const XmlOptions &options : {with(mode), with(mode, lazy)})
+		{
+			XmlLoader huge("huge.xml", options);
+			CHECK(dump(huge.compact()) == expected);
+			CHECK(dump(huge.compact()) == expected);
+			CHECK(dump(huge.reload("huge.xml")) == expected);
+			CHECK(dump(huge.compact()) == expected);
+		}
+	}
+}
+
+/**
+ * @brief Records streamed one at a time into regions.
+ */
+static void streamed(void)
+{
+	XmlLoader heap(writeFile("huge.xml", catalog(20000)));
+	std::string expected;
+	heap.forEachNodeNamed("record", [&]() {
+		expected += heap.attribute<std::string>("id");
+		expected += heap.element("price").text<std::string>();
+	});
+	XmlOptions streaming;
+	streaming.streaming = true;
+	for (xml2::HugePages mode : modes)
+	{
+		XmlLoader huge("huge.xml", with(mode, streaming));
+		std::string seen;
+		huge.forEachNodeNamed("record", [&]() {
+			seen += huge.attribute<std::string>("id");
+			seen += huge.element("price").text<std::string>();
+		});
+		CHECK(!seen.empty());
+		CHECK(seen == expected);
+	}
+}
+
+int main(void)
+{
+	run("huge pages load", load);
+	run("huge pages reload", reload);
+	run("huge pages compact", compact);
+	run("huge pages streamed", streamed);
+	return summary();
+}
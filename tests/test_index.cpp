@@ -0,0 +1,67 @@
+/**
+ * @file test_index.cpp
+ * @brief Tests that the records opened through a sidecar index are the ones
+ * of the whole file, and that an index out of date is refused.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const size_t records = 2000; //!< The records of the catalog.
+
+/**
+ * @brief Each record, found by number or by key, reads as in the whole file.
+ */
+static void lookup(void)
+{
+	const std::string xml = writeFile("index.xml", catalog(records));
+	CHECK_EQUAL(XmlIndex::build("index.xml", "catalog/record", "id"), records);
+	XmlIndex index("index.xml");
+	CHECK_EQUAL(index.size(), records);
+	CHECK_EQUAL(index.find("sku-none"), XmlIndex::npos);
+
+	XmlLoader whole("index.xml");
+	size_t i = 0;
+	whole.forEachNodeNamed("record", [&]() {
+		CHECK_EQUAL(index.find("sku-" + std::to_string(i)), i);
+		const std::pair<size_t, size_t> range = index.range(i);
+		CHECK_EQUAL(range.first, whole.sourceBegin());
+		CHECK_EQUAL(range.second, whole.sourceEnd());
+		++i;
+	});
+
+	XmlLoader one(index, index.find("sku-1234"));
+	CHECK_EQUAL(one.name(), std::string("record"));
+	CHECK_EQUAL(one.attribute<std::string>("id"), std::string("sku-1234"));
+	CHECK_EQUAL(one.sourceBegin(), 0u);
+	CHECK_EQUAL(one.element("price").text<double>(), 1234.5);
+	one.reload(index, 7);
+	CHECK_EQUAL(one.element("name").text<std::string>(), std::string("item 7"));
+	CHECK_THROWS(one.reload(index, records));
+}
+
+/**
+ * @brief An index is refused once its file changed, or if there is none.
+ */
+static void stale(void)
+{
+	writeFile("index-stale.xml", catalog(100));
+	XmlIndex::build("index-stale.xml", "catalog/record", "id");
+	{
+		XmlIndex index("index-stale.xml");
+		CHECK_EQUAL(index.size(), 100u);
+	}
+	writeFile("index-stale.xml", catalog(101));
+	CHECK_THROWS(XmlIndex("index-stale.xml"));
+	CHECK_THROWS(XmlIndex("index-none.xml"));
+}
+
+int main(void)
+{
+	run("index lookup", lookup);
+	run("index stale", stale);
+	return summary();
+}
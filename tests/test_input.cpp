@@ -0,0 +1,139 @@
+/**
+ * @file test_input.cpp
+ * @brief Tests that a compressed (gzip or zstd) or UTF-16 file loads as the same file in plain UTF-8.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const size_t records = 3000; //!< The records of the catalog.
+
+/**
+ * @brief The price of every record, summed, and the number of tags.
+ */
+static double total(XmlLoader &loader)
+{
+	double sum = 0.0;
+	loader.forEachNodeNamed("record", [&]() {
+		sum += loader.element("price").text<double>();
+		sum += loader.node("tags").element("tag").text<std::string>().size();
+		loader.prev();
+	});
+	return sum;
+}
+
+/**
+ * @brief \a text, ASCII, in UTF-16 little endian with its byte order mark.
+ */
+static std::string utf16(const std::string &text)
+{
+	std::string out("\xFF\xFE", 2);
+	for (char c : text)
+	{
+		out += c;
+		out += '\0';
+	}
+	return out;
+}
+
+/**
+ * @brief A UTF-16 file loads as its UTF-8 version.
+ */
+static void unicode(void)
+{
+	XmlLoader plain(writeFile("input.xml", catalog(records)));
+	XmlLoader wide(writeFile("input-16.xml", utf16(catalog(records))));
+	CHECK_EQUAL(total(wide), total(plain));
+}
+
+#ifdef RWXML_WITH_ZLIB
+/**
+ * @brief A gzip file loads as the file it was made of, and so does a
+ * gzipped UTF-16 file, or a gzip file of several members.
+ */
+static void gzip(void)
+{
+	const std::string xml = catalog(records);
+	XmlLoader plain(writeFile("input.xml", xml));
+	const double expected = total(plain);
+
+	XmlLoader packed(writeGzip("input.xml.gz", xml));
+	CHECK_EQUAL(total(packed), expected);
+
+	XmlLoader wide(writeGzip("input-16.xml.gz", utf16(xml)));
+	CHECK_EQUAL(total(wide), expected);
+
+	const size_t half = xml.size() / 2;
+	const std::string members = readFile(writeGzip("input-a.gz", xml.substr(0, half)))
+	                          + readFile(writeGzip("input-b.gz", xml.substr(half)));
+	XmlLoader several(writeFile("input-members.xml.gz", members));
+	CHECK_EQUAL(total(several), expected);
+
+	// The offsets are the ones of the decompressed content.
+	packed.backToRoot().node("record");
+	plain.backToRoot().node("record");
+	CHECK_EQUAL(packed.sourceBegin(), plain.sourceBegin());
+	CHECK_EQUAL(packed.sourceEnd(), plain.sourceEnd());
+
+	packed.reload("input.xml");
+	CHECK_EQUAL(total(packed), expected);
+}
+
+/**
+ * @brief A truncated gzip file fails to load.
+ */
+static void truncated(void)
+{
+	const std::string packed = readFile(writeGzip("input.xml.gz", catalog(records)));
+	writeFile("input-cut.xml.gz", packed.substr(0, packed.size() / 2));
+	CHECK_THROWS(XmlLoader("input-cut.xml.gz"));
+}
+#endif
+
+#ifdef RWXML_WITH_ZSTD
+/**
+ * @brief A zstd file loads as the file it was made of, and so does a file
+ * of several frames ; a truncated one fails.
+ */
+static void zstd(void)
+{
+	const std::string xml = catalog(records);
+	XmlLoader plain(writeFile("input.xml", xml));
+	const double expected = total(plain);
+
+	XmlLoader packed(writeZstd("input.xml.zst", xml));
+	CHECK_EQUAL(total(packed), expected);
+
+	const size_t half = xml.size() / 2;
+	const std::string frames = readFile(writeZstd("input-a.zst", xml.substr(0, half)))
+	                         + readFile(writeZstd("input-b.zst", xml.substr(half)));
+	XmlLoader several(writeFile("input-frames.xml.zst", frames));
+	CHECK_EQUAL(total(several), expected);
+
+	// The offsets are the ones of the decompressed content.
+	packed.backToRoot().node("record");
+	plain.backToRoot().node("record");
+	CHECK_EQUAL(packed.sourceBegin(), plain.sourceBegin());
+	CHECK_EQUAL(packed.sourceEnd(), plain.sourceEnd());
+
+	const std::string whole = readFile("input.xml.zst");
+	writeFile("input-cut.xml.zst", whole.substr(0, whole.size() / 2));
+	CHECK_THROWS(XmlLoader("input-cut.xml.zst"));
+}
+#endif
+
+int main(void)
+{
+	run("input utf-16", unicode);
+#ifdef RWXML_WITH_ZLIB
+	run("input gzip", gzip);
+	run("input truncated", truncated);
+#endif
+#ifdef RWXML_WITH_ZSTD
+	run("input zstd", zstd);
+#endif
+	return summary();
+}
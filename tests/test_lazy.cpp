@@ -0,0 +1,117 @@
+/**
+ * @file test_lazy.cpp
+ * @brief Tests that every way to iterate over a document loaded with a lazy
+ * depth reads the same as over the document loaded at once.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <atomic>
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const size_t records = 500; //!< The records of the catalog.
+
+/**
+ * @brief What each record gives : its price and its last tag.
+ */
+static double read(const XmlCursor &record)
+{
+	double sum = record.element("price").text<double>();
+	for (XmlCursor tag : record.element("tags").children("tag"))
+		sum += tag.text<std::string>().size();
+	return sum;
+}
+
+/**
+ * @brief What the whole catalog gives.
+ */
+static double expected(void)
+{
+	XmlLoader loader(writeFile("lazy.xml", catalog(records)));
+	double sum = 0.0;
+	loader.forEachNodeNamed("record", [&](XmlCursor record) { sum += read(record); });
+	return sum;
+}
+
+/**
+ * @brief A loader of the catalog, with a lazy depth of \a depth.
+ */
+static XmlOptions lazy(unsigned depth)
+{
+	XmlOptions options;
+	options.lazyDepth = depth;
+	return options;
+}
+
+/**
+ * @brief The callable overloads get expanded cursors.
+ */
+static void callables(void)
+{
+	const double all = expected();
+	for (unsigned depth = 1; depth <= 3; ++depth)
+	{
+		XmlLoader loader("lazy.xml", lazy(depth));
+		double sum = 0.0;
+		loader.forEachNodeNamed("record", [&](XmlCursor record) { sum += read(record); });
+		CHECK_EQUAL(sum, all);
+
+		sum = 0.0;
+		loader.forEachElementNamed("record", [&](XmlCursor record) { sum += read(record); });
+		CHECK_EQUAL(sum, all);
+	}
+}
+
+/**
+ * @brief The std::function overloads expand what the loader enters.
+ */
+static void functions(void)
+{
+	const double all = expected();
+	XmlLoader loader("lazy.xml", lazy(1));
+	double sum = 0.0;
+	loader.forEachNodeNamed("record", [&]() {
+		sum += loader.element("price").text<double>();
+		loader.node("tags").forEachElementNamed("tag", [&]() {
+			sum += loader.text<std::string>().size();
+		});
+		loader.prev();
+	});
+	CHECK_EQUAL(sum, all);
+}
+
+/**
+ * @brief children(), select() and parallelForEachNodeNamed() give expanded cursors.
+ */
+static void cursors(void)
+{
+	const double all = expected();
+	XmlLoader loader("lazy.xml", lazy(1));
+	double sum = 0.0;
+	for (XmlCursor record : loader.children("record"))
+		sum += read(record);
+	CHECK_EQUAL(sum, all);
+
+	loader.reload("lazy.xml");
+	sum = 0.0;
+	for (const XmlCursor &record : loader.select("/catalog/record"))
+		sum += read(record);
+	CHECK_EQUAL(sum, all);
+
+	loader.reload("lazy.xml");
+	std::atomic<long> hundredths(0);
+	loader.parallelForEachNodeNamed("record", [&](XmlCursor record) {
+		hundredths += static_cast<long>(read(record) * 100.0);
+	}, 4);
+	CHECK_EQUAL(hundredths.load(), static_cast<long>(all * 100.0));
+}
+
+int main(void)
+{
+	run("lazy callables", callables);
+	run("lazy functions", functions);
+	run("lazy cursors", cursors);
+	return summary();
+}
@@ -0,0 +1,147 @@
+/**
+ * @file test_namespaces.cpp
+ * @brief Tests the namespaces resolved by XmlFlat::resolve(), and the lookups
+ * of XmlLoader by namespace and local name, whatever prefix binds them.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlFlat.hpp"
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const char *scopes =
+	"<root xmlns=\"urn:d\" xmlns:a=\"urn:a\">"
+	"<child/>"
+	"<a:x><y/></a:x>"
+	"<plain xmlns=\"\"><z/><a:w/></plain>"
+	"<a:r xmlns:a=\"urn:b\"><a:s/></a:r>"
+	"<a:t/>"
+	"<b:u/>"
+	"<xml:lang/>"
+	"<q xmlns:a=\"urn:a2\" xmlns=\"urn:d2\"><a:v/><e/></q>"
+	"</root>"; //!< Every kind of scope.
+
+/**
+ * @brief Each element of \a xml as {namespace}name, in document order : {?} for none.
+ */
+static std::string resolved(const std::string &xml)
+{
+	xml2::XMLDocument doc;
+	doc.Parse(xml.c_str());
+	XmlFlat flat(doc);
+	CHECK(!flat.resolved());
+	CHECK_EQUAL(flat.spaceOf(1), XmlAtoms::none);
+	flat.resolve();
+	CHECK(flat.resolved());
+	std::string out;
+	for (uint32_t index = 1; index < flat.size(); ++index)
+	{
+		const uint32_t space = flat.spaceOf(index);
+		out += "{" + (space == XmlAtoms::none ? std::string("?") : flat.name(space)) + "}" + flat.element(index)->Name() + " ";
+	}
+	return out;
+}
+
+/**
+ * @brief The default namespace, its undeclaration, a prefix rebound then back
+ * in scope, the xml prefix and an unbound prefix.
+ */
+static void resolve(void)
+{
+	CHECK_EQUAL(resolved(scopes), std::string(
+		"{urn:d}root {urn:d}child {urn:a}a:x {urn:d}y {}plain {}z {urn:a}a:w {urn:b}a:r {urn:b}a:s {urn:a}a:t {?}b:u "
+		"{http://www.w3.org/XML/1998/namespace}xml:lang {urn:d2}q {urn:a2}a:v {urn:d2}e "));
+	CHECK_EQUAL(resolved("<a><b/></a>"), std::string("{}a {}b "));
+}
+
+static const char *soap =
+	"<env xmlns:s=\"urn:soap\" xmlns:c=\"urn:catalog\">"
+	"<s:Body>"
+	"<c:item n=\"1\"><c:price>1</c:price></c:item>"
+	"<k:item n=\"2\" xmlns:k=\"urn:catalog\"><k:price>2</k:price></k:item>"
+	"<other/>"
+	"<item n=\"3\" xmlns=\"urn:catalog\"><price>3</price></item>"
+	"<item n=\"4\"><price>4</price></item>"
+	"<u:item n=\"5\"><u:price>5</u:price></u:item>"
+	"</s:Body>"
+	"</env>"; //!< The same namespace under several prefixes.
+
+/**
+ * @brief The same namespace under other prefixes, or as default, is found the
+ * same way ; an unknown URI, an unknown name or an unbound prefix are not.
+ */
+static void lookups(void)
+{
+	XmlLoader loader(writeFile("namespaces.xml", soap));
+	CHECK(!loader.frozen());
+	const XmlQName price = loader.qname("urn:catalog", "price");
+	CHECK(loader.frozen());
+
+	loader.node("urn:soap", "Body");
+	CHECK_EQUAL(loader.name(), std::string("s:Body"));
+	CHECK_EQUAL(loader.node("urn:catalog", "item").element(price).text<std::string>(), std::string("1"));
+	loader.prev();
+	CHECK_EQUAL(loader.node("", "item").element("", "price").text<std::string>(), std::string("4"));
+	loader.prev();
+	CHECK_EQUAL(loader.element("urn:catalog", "item").attribute<int>("n"), 1);
+	CHECK_EQUAL(loader.element("urn:catalog", "item").attribute<int>("n"), 1);
+
+	// Unknown URIs and names, and a prefix taken for a namespace, match nothing.
+	CHECK_EQUAL(loader.element("urn:other", "item").name(), std::string(""));
+	CHECK_EQUAL(loader.element("urn:catalog", "nothing").name(), std::string(""));
+	CHECK_EQUAL(loader.element("c", "item").name(), std::string(""));
+	CHECK_EQUAL(loader.element("u", "item").name(), std::string(""));
+	CHECK_EQUAL(loader.node("urn:other", "item").name(), std::string("s:Body"));
+	CHECK(loader.qname("urn:other", "item").space == XmlAtoms::none);
+}
+
+/**
+ * @brief In cursor mode, each lookup goes on from the last match, whatever
+ * prefix it had, and starts over once there is none after it.
+ */
+static void cursor(void)
+{
+	XmlLoader loader(writeFile("namespaces.xml", soap));
+	const XmlQName item = loader.qname("urn:catalog", "item");
+	loader.node("urn:soap", "Body").cursorMode(true);
+	std::string seen;
+	for (int i = 0; i < 5; ++i)
+		seen += std::to_string(loader.element(item).attribute<int>("n"));
+	CHECK_EQUAL(seen, std::string("12312"));
+	// A lookup by qualified name goes on from it too.
+	CHECK_EQUAL(loader.element("item").attribute<int>("n"), 3);
+	CHECK_EQUAL(loader.element(item).attribute<int>("n"), 1);
+	loader.cursorMode(false);
+	CHECK_EQUAL(loader.element(item).attribute<int>("n"), 1);
+	CHECK_EQUAL(loader.element(item).attribute<int>("n"), 1);
+}
+
+/**
+ * @brief The atoms of a document match nothing once another one is loaded,
+ * even resolved, and have to be asked again.
+ */
+static void reload(void)
+{
+	XmlLoader loader(writeFile("namespaces.xml", soap));
+	const XmlQName item = loader.qname("urn:catalog", "item");
+	writeFile("namespaces-2.xml", "<list xmlns=\"urn:catalog\"><first/><item n=\"7\"/></list>");
+	loader.reload("namespaces-2.xml");
+	CHECK(!loader.frozen());
+	CHECK_EQUAL(loader.element(item).name(), std::string(""));
+	const XmlQName again = loader.qname("urn:catalog", "item");
+	CHECK_EQUAL(loader.element(item).name(), std::string(""));
+	CHECK_EQUAL(loader.element(again).attribute<int>("n"), 7);
+	loader.reload("namespaces.xml");
+	CHECK_EQUAL(loader.element(again).name(), std::string(""));
+}
+
+int main(void)
+{
+	run("namespaces resolve", resolve);
+	run("namespaces lookups", lookups);
+	run("namespaces cursor", cursor);
+	run("namespaces reload", reload);
+	return summary();
+}
@@ -0,0 +1,91 @@
+/**
+ * @file test_parallel.cpp
+ * @brief Tests that the parallel methods visit every record once, whatever
+ * the number of threads, and that the pool runs every index once.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <atomic>
+#include <stdexcept>
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const size_t records = 5000; //!< The records of the catalog.
+
+/**
+ * @brief Every index is run once, and an exception of a task reaches run().
+ */
+static void pool(void)
+{
+	for (unsigned threads = 1; threads <= 4; ++threads)
+	{
+		XmlPool pool(threads);
+		CHECK_EQUAL(pool.size(), threads);
+		std::vector<std::atomic<int> > runs(10007);
+		for (std::atomic<int> &count : runs)
+			count = 0;
+		pool.run(runs.size(), 0, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+				++runs[i];
+		});
+		size_t once = 0;
+		for (const std::atomic<int> &count : runs)
+			once += (count == 1) ? 1 : 0;
+		CHECK_EQUAL(once, runs.size());
+
+		bool thrown = false;
+		try
+		{
+			pool.run(100, 1, [&](size_t begin, size_t) {
+				if (begin == 42)
+					throw std::runtime_error("task");
+			});
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+		CHECK(thrown);
+	}
+}
+
+/**
+ * @brief The records are visited once each, and mapped in document order.
+ */
+static void byRecord(void)
+{
+	XmlLoader loader(writeFile("parallel.xml", catalog(records)));
+	for (unsigned threads = 1; threads <= 4; ++threads)
+	{
+		std::atomic<long> halves(0);
+		std::atomic<size_t> tags(0);
+		loader.parallelForEachNodeNamed("record", [&](XmlCursor record) {
+			halves += static_cast<long>(record.element("price").text<double>() * 2.0);
+			for (XmlCursor tag : record.element("tags").children("tag"))
+			{
+				(void)tag;
+				++tags;
+			}
+		}, threads);
+		CHECK_EQUAL(halves.load(), static_cast<long>(records * records));
+		CHECK_EQUAL(tags.load(), 2 * records);
+
+		const std::vector<std::string> ids = loader.parallelMapNodeNamed<std::string>("record", [](XmlCursor record) {
+			return record.attribute<std::string>("id");
+		}, threads);
+		CHECK_EQUAL(ids.size(), records);
+		size_t ordered = 0;
+		for (size_t i = 0; i < ids.size(); ++i)
+			ordered += (ids[i] == "sku-" + std::to_string(i)) ? 1 : 0;
+		CHECK_EQUAL(ordered, records);
+	}
+}
+
+int main(void)
+{
+	run("parallel pool", pool);
+	run("parallel records", byRecord);
+	return summary();
+}
@@ -0,0 +1,161 @@
+/**
+ * @file test_pipeline.cpp
+ * @brief Tests that a file big enough to be read by another thread while it is
+ * parsed gives the same document as the file parsed from a single buffer.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlInput.hpp"
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const size_t MB = 1024 * 1024; //!< The reads of the other thread are of 1 MB, from 4 MB.
+
+/**
+ * @brief Print \a node, with the source offsets of every element.
+ */
+static void shape(const xml2::XMLNode *node, std::string &out)
+{
+	for (const xml2::XMLNode *child = node->FirstChild(); child != nullptr; child = child->NextSibling())
+	{
+		const xml2::XMLElement *element = child->ToElement();
+		if (element != nullptr)
+		{
+			out += std::to_string(element->SourceBegin()) + "-" + std::to_string(element->SourceEnd()) + " ";
+		}
+		shape(child, out);
+	}
+}
+
+/**
+ * @brief Print \a doc, and the offsets of its elements.
+ */
+static std::string shape(xml2::XMLDocument &doc)
+{
+	xml2::XMLPrinter printer;
+	doc.Print(&printer);
+	std::string out(printer.CStr());
+	shape(&doc, out);
+	return out;
+}
+
+/**
+ * @brief A catalog of exactly \a bytes, padded before its closing tag with \a pad.
+ */
+static std::string sized(size_t bytes, const std::string &pad = " ")
+{
+	std::string xml = catalog(bytes / 150);
+	xml.resize(xml.size() - std::string("</catalog>\n").size());
+	while (xml.size() + pad.size() + 11 <= bytes)
+		xml += pad;
+	xml.append(bytes - 11 - xml.size(), ' ');
+	return xml + "</catalog>\n";
+}
+
+/**
+ * @brief Parse \a xml written into a file, and from a single buffer : both give the same document.
+ */
+static void same(const std::string &xml, bool validate = false)
+{
+	writeFile("pipeline.xml", xml);
+	xml2::XMLDocument piped;
+	CHECK_EQUAL(XmlInput::open("pipeline.xml")->parse(piped, validate), xml2::XML_SUCCESS);
+	xml2::XMLDocument whole;
+	CHECK_EQUAL(whole.Parse(xml.data(), xml.size()), xml2::XML_SUCCESS);
+	CHECK(shape(piped) == shape(whole));
+}
+
+/**
+ * @brief Files around the size read by another thread, cut anywhere by its reads.
+ */
+static void sizes(void)
+{
+	for (size_t bytes : {4 * MB - 1, 4 * MB, 4 * MB + 1, 4 * MB + 37, 9 * MB + MB / 2})
+		same(sized(bytes));
+}
+
+/**
+ * @brief A text longer than a read, so reads without any '<'.
+ */
+static void longText(void)
+{
+	std::string xml = "<catalog><blob>";
+	xml.append(3 * MB + 5, 'x');
+	xml += "</blob><blob a=\"1\">";
+	xml.append(2 * MB, 'y');
+	same(xml + "</blob></catalog>");
+}
+
+/**
+ * @brief UTF-8 characters cut by the end of a read are still valid, an invalid
+ * byte fails wherever it is.
+ */
+static void unicode(void)
+{
+	same(sized(6 * MB, "<e>\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80</e>"), true);
+	for (size_t at : {MB - 1, 2 * MB, 5 * MB + 3})
+	{
+		std::string xml = sized(6 * MB, "<e>\xC3\xA9</e>");
+		xml[at] = '\xFF';
+		writeFile("pipeline.xml", xml);
+		xml2::XMLDocument doc;
+		CHECK_THROWS(XmlInput::open("pipeline.xml")->parse(doc, true));
+	}
+}
+
+/**
+ * @brief A big document not well formed fails as it does from a buffer.
+ */
+static void malformed(void)
+{
+	std::string xml = sized(5 * MB);
+	xml.resize(xml.size() - 5);
+	writeFile("pipeline.xml", xml);
+	xml2::XMLDocument piped;
+	xml2::XMLDocument whole;
+	const xml2::XMLError err = XmlInput::open("pipeline.xml")->parse(piped);
+	CHECK(err != xml2::XML_SUCCESS);
+	CHECK_EQUAL(err, whole.Parse(xml.data(), xml.size()));
+}
+
+/**
+ * @brief A loader on a big file reads as the same loader reloaded from a buffer,
+ * the characters being checked or not.
+ */
+static void loader(void)
+{
+	const std::string xml = sized(8 * MB);
+	writeFile("pipeline.xml", xml);
+	for (bool validate : {false, true})
+	{
+		XmlOptions options;
+		options.validateUtf8 = validate;
+		XmlLoader piped("pipeline.xml", options);
+		XmlLoader whole("pipeline.xml", options);
+		whole.reload(xml.data(), xml.size());
+		std::string a;
+		std::string b;
+		piped.forEachNodeNamed("record", [&]() {
+			a += piped.attribute<std::string>("id") + std::to_string(piped.sourceBegin());
+			a += piped.element("price").text<std::string>();
+		});
+		whole.forEachNodeNamed("record", [&]() {
+			b += whole.attribute<std::string>("id") + std::to_string(whole.sourceBegin());
+			b += whole.element("price").text<std::string>();
+		});
+		CHECK(!a.empty());
+		CHECK(a == b);
+	}
+}
+
+int main(void)
+{
+	run("pipeline sizes", sizes);
+	run("pipeline long text", longText);
+	run("pipeline unicode", unicode);
+	run("pipeline malformed", malformed);
+	run("pipeline loader", loader);
+	return summary();
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_projection.cpp
+ * @brief Tests that the paths kept by XmlOptions::keepPaths load as in the whole
+ * document, and that the subtrees skipped are stepped over whatever they hold.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <algorithm>
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+/**
+ * @brief The options keeping \a paths.
+ */
+static XmlOptions keep(const std::vector<std::string> &paths)
+{
+	XmlOptions options;
+	options.keepPaths = paths;
+	return options;
+}
+
+/**
+ * @brief The id of each record, with the offsets, names and tags it has loaded.
+ */
+static std::string dump(XmlLoader &loader)
+{
+	std::string out;
+	for (XmlCursor record : loader.backToRoot().children("record"))
+	{
+		out += record.attribute<std::string>("id") + " " + std::to_string(record.sourceBegin());
+		for (XmlCursor child : record.children())
+			out += " " + child.name() + "@" + std::to_string(child.sourceBegin()) + "=" + child.text<std::string>();
+		for (XmlCursor tag : record.element("tags").children("tag"))
+			out += " " + tag.text<std::string>();
+		out += "\n";
+	}
+	return out;
+}
+
+/**
+ * @brief What \a loader has of the whole catalog, without what \a drop names.
+ */
+static std::string without(XmlLoader &loader, const std::vector<std::string> &drop)
+{
+	std::string out;
+	for (XmlCursor record : loader.backToRoot().children("record"))
+	{
+		out += record.attribute<std::string>("id") + " " + std::to_string(record.sourceBegin());
+		for (XmlCursor child : record.children())
+		{
+			if (std::find(drop.begin(), drop.end(), child.name()) == drop.end())
+				out += " " + child.name() + "@" + std::to_string(child.sourceBegin()) + "=" + child.text<std::string>();
+		}
+		if (std::find(drop.begin(), drop.end(), "tags") == drop.end())
+		{
+			for (XmlCursor tag : record.element("tags").children("tag"))
+				out += " " + tag.text<std::string>();
+		}
+		out += "\n";
+	}
+	return out;
+}
+
+/**
+ * @brief The kept paths read as in the whole document, with their offsets ;
+ * \b * stands for any name, and several paths can be kept.
+ */
+static void kept(void)
+{
+	XmlLoader whole(writeFile("projection.xml", catalog(2000)));
+	const std::string names = without(whole, {"price", "tags"});
+	const std::string namesAndTags = without(whole, {"price"});
+
+	XmlLoader projected("projection.xml", keep({"catalog/record/name"}));
+	CHECK_EQUAL(dump(projected), names);
+	CHECK_EQUAL(dump(XmlLoader("projection.xml", keep({"catalog/*/name"})).backToRoot()), names);
+	CHECK_EQUAL(dump(XmlLoader("projection.xml", keep({"*/record/name"})).backToRoot()), names);
+	CHECK_EQUAL(dump(XmlLoader("projection.xml", keep({"catalog/record/name", "catalog/record/tags"})).backToRoot()), namesAndTags);
+	CHECK_EQUAL(dump(XmlLoader("projection.xml", keep({"catalog/record"})).backToRoot()), dump(whole));
+	CHECK_EQUAL(dump(XmlLoader("projection.xml", keep({"catalog/nothing"})).backToRoot()), std::string(""));
+
+	// The projection is kept for every reload.
+	writeFile("projection-2.xml", catalog(30));
+	XmlLoader other("projection-2.xml");
+	CHECK_EQUAL(dump(projected.reload("projection-2.xml")), without(other, {"price", "tags"}));
+}
+
+/**
+ * @brief A skipped subtree may hold comments, CDATA, processing instructions,
+ * quoted '>' and tags of the same name : none of them ends it early.
+ */
+static void skipped(void)
+{
+	const std::string xml =
+		"<catalog>\n"
+		"<record id=\"1\"><price note=\"a > b\" other='</price>'>"
+		"<!-- </price> <price> --><![CDATA[</price> <price>]]><?pi </price> > ?>"
+		"<price>nested<price/></price><x a=\"/\"></x>1</price><name>one</name></record>\n"
+		"<record id=\"2\"><skip><a/><b c='>'/><!----></skip><name>two</name></record>\n"
+		"</catalog>\n";
+	XmlLoader projected(writeFile("projection.xml", xml), keep({"catalog/record/name"}));
+	std::string seen;
+	for (XmlCursor record : projected.children("record"))
+	{
+		seen += record.attribute<std::string>("id") + "=" + record.element("name").text<std::string>() + " ";
+		CHECK(!record.element("price"));
+		CHECK(!record.element("skip"));
+	}
+	CHECK_EQUAL(seen, std::string("1=one 2=two "));
+}
+
+/**
+ * @brief A skipped subtree which never closes, or whose comment never closes, is refused.
+ */
+static void unclosed(void)
+{
+	for (const char *xml : {"<catalog><record><name>a</name><price><p>1</price></record>",
+	                        "<catalog><record><price>1",
+	                        "<catalog><record><price><!-- 1</price></record></catalog>",
+	                        "<catalog><record><price><![CDATA[1</price></record></catalog>",
+	                        "<catalog><record><price a=\"></price></record></catalog>"})
+	{
+		writeFile("projection-bad.xml", xml);
+		CHECK_THROWS(XmlLoader("projection-bad.xml", keep({"catalog/record/name"})));
+	}
+}
+
+int main(void)
+{
+	run("projection kept", kept);
+	run("projection skipped", skipped);
+	run("projection unclosed", unclosed);
+	return summary();
+}
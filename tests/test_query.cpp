@@ -0,0 +1,175 @@
+/**
+ * @file test_query.cpp
+ * @brief Tests the queries of XmlLoader::select() : steps, predicates, positions
+ * per parent, duplicates, and the queries which cannot be compiled.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <algorithm>
+#include <chrono>
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const char *shop =
+	"<shop>\n"
+	"\t<shelf id=\"s1\">\n"
+	"\t\t<item kind=\"a\"><name>one</name><price>1</price></item>\n"
+	"\t\t<item kind=\"b\"><name>two</name><price>2</price></item>\n"
+	"\t\t<item kind=\"a\"><name>three</name><price>3</price></item>\n"
+	"\t\t<item kind=\"a\" sale=\"\"><name>four</name><price>4</price></item>\n"
+	"\t</shelf>\n"
+	"\t<shelf id=\"s2\">\n"
+	"\t\t<item kind=\"b\"><name>five</name><price>5</price></item>\n"
+	"\t\t<item kind=\"a\"><name>six</name><price>1</price></item>\n"
+	"\t\t<box><item kind=\"a\"><name>seven</name><price>7</price></item></box>\n"
+	"\t</shelf>\n"
+	"\t<note>sale</note>\n"
+	"</shop>\n"; //!< The document of every test.
+
+/**
+ * @brief The text of the \b name child of each element selected, or its own text.
+ */
+static std::string names(const std::vector<XmlCursor> &selected)
+{
+	std::string out;
+	for (const XmlCursor &cursor : selected)
+	{
+		const XmlCursor name = cursor.element("name");
+		out += (name ? name.text<std::string>() : cursor.name() + "=" + cursor.text<std::string>()) + " ";
+	}
+	return out;
+}
+
+/**
+ * @brief Child and descendant steps, absolute or from the current node, any name.
+ */
+static void steps(void)
+{
+	XmlLoader loader(writeFile("query.xml", shop));
+	CHECK_EQUAL(names(loader.select("shelf/item")), std::string("one two three four five six "));
+	CHECK_EQUAL(names(loader.select("/shop/shelf/item")), std::string("one two three four five six "));
+	CHECK_EQUAL(names(loader.select("//item")), std::string("one two three four five six seven "));
+	CHECK_EQUAL(names(loader.select("shelf/*/item")), std::string("seven "));
+	CHECK_EQUAL(names(loader.select("*")), std::string("shelf= shelf= note=sale "));
+	CHECK(loader.select("item").empty());
+	CHECK(loader.select("/shelf").empty());
+
+	// Relative to the current node, which stays where it is ; absolute from anywhere.
+	loader.node("shelf").nextNode();
+	CHECK_EQUAL(names(loader.select("item")), std::string("five six "));
+	CHECK_EQUAL(names(loader.select("//box/item")), std::string("seven "));
+	CHECK_EQUAL(loader.attribute<std::string>("id"), std::string("s2"));
+}
+
+/**
+ * @brief The attribute, text and child text predicates, alone and chained.
+ */
+static void predicates(void)
+{
+	XmlLoader loader(writeFile("query.xml", shop));
+	CHECK_EQUAL(names(loader.select("//item[@sale]")), std::string("four "));
+	CHECK_EQUAL(names(loader.select("//item[@kind='b']")), std::string("two five "));
+	CHECK_EQUAL(names(loader.select("//item[@kind=\"b\"]")), std::string("two five "));
+	CHECK_EQUAL(names(loader.select("//item[ @kind = 'b' ]")), std::string("two five "));
+	CHECK_EQUAL(names(loader.select("//item[price='1']")), std::string("one six "));
+	CHECK_EQUAL(names(loader.select("//name[.='six']")), std::string("name=six "));
+	CHECK_EQUAL(names(loader.select("//name[text()='six']")), std::string("name=six "));
+	CHECK_EQUAL(names(loader.select("shelf[@id='s1']/item[@kind='a'][price='3']")), std::string("three "));
+	CHECK_EQUAL(names(loader.select("shelf[item='x']")), std::string(""));
+	CHECK(loader.select("//item[@kind='c']").empty());
+	CHECK(loader.select("//shelf[.='sale']").empty());
+	CHECK_EQUAL(names(loader.select("note[.='sale']")), std::string("note=sale "));
+}
+
+/**
+ * @brief Positions count per parent, among the candidates the previous predicates kept.
+ */
+static void positions(void)
+{
+	XmlLoader loader(writeFile("query.xml", shop));
+	CHECK_EQUAL(names(loader.select("shelf/item[2]")), std::string("two six "));
+	CHECK_EQUAL(names(loader.select("shelf/item[@kind='a'][2]")), std::string("three "));
+	CHECK_EQUAL(names(loader.select("shelf/item[2][@kind='a']")), std::string("six "));
+	CHECK_EQUAL(names(loader.select("shelf/item[@kind='a'][3]")), std::string("four "));
+	CHECK_EQUAL(names(loader.select("shelf/item[@kind='a'][1]")), std::string("one six "));
+	CHECK_EQUAL(names(loader.select("//item[1]")), std::string("one five seven "));
+	CHECK_EQUAL(names(loader.select("shelf[2]/*[3]/item")), std::string("seven "));
+	CHECK(loader.select("shelf/item[9]").empty());
+}
+
+/**
+ * @brief Once the position is reached, the next siblings are not looked at :
+ * the first of a million children is found long before the scan of all of them.
+ */
+static void early(void)
+{
+	std::string xml("<list>");
+	for (int i = 0; i < 1000000; ++i)
+		xml += "<c/>";
+	XmlLoader loader(writeFile("query-long.xml", xml + "</list>"));
+	const XmlQuery first("c[1]");
+	const XmlQuery none("c[@x]");
+	const auto time = [&](const XmlQuery &query) {
+		double best = 1e9;
+		for (int run = 0; run < 3; ++run)
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			loader.select(query);
+			best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		}
+		return best;
+	};
+	CHECK_EQUAL(loader.select(first).size(), 1u);
+	CHECK(time(first) * 20 < time(none));
+}
+
+/**
+ * @brief Descendant steps below nested matches select each node once, in document order.
+ */
+static void duplicates(void)
+{
+	XmlLoader loader(writeFile("query.xml",
+		"<a id=\"1\"><a id=\"2\"><b id=\"x\"/><a id=\"3\"><b id=\"y\"/></a></a><b id=\"z\"/></a>"));
+	std::string seen;
+	for (const XmlCursor &b : loader.select("//a//b"))
+		seen += b.attribute<std::string>("id");
+	CHECK_EQUAL(seen, std::string("xyz"));
+	seen.clear();
+	for (const XmlCursor &a : loader.select("//a"))
+		seen += a.attribute<std::string>("id");
+	CHECK_EQUAL(seen, std::string("123"));
+	CHECK_EQUAL(loader.select("//*").size(), 6u);
+	CHECK_EQUAL(loader.select("//a//*").size(), 5u);
+	CHECK_EQUAL(loader.select("a//b").size(), 2u);
+}
+
+/**
+ * @brief The queries outside of the subset, or not well formed, are refused.
+ */
+static void malformed(void)
+{
+	for (const char *query : {"", "/", "a/", "a//", "[1]", "a[", "a[0]", "a[1", "a[@]", "a[@id=]",
+	                          "a[@id='x]", "a[@id=x]", "a[name]", "a[.]", "a b", "a]", "a/@id"})
+	{
+		CHECK_THROWS(XmlQuery{query});
+	}
+	XmlLoader loader(writeFile("query.xml", shop));
+	CHECK_THROWS(loader.select("shelf["));
+	const XmlQuery query("//item[@kind='b']");
+	CHECK(query.absolute());
+	CHECK(!XmlQuery("item").absolute());
+	CHECK_EQUAL(query.str(), std::string("//item[@kind='b']"));
+}
+
+int main(void)
+{
+	run("query steps", steps);
+	run("query predicates", predicates);
+	run("query positions", positions);
+	run("query early", early);
+	run("query duplicates", duplicates);
+	run("query malformed", malformed);
+	return summary();
+}
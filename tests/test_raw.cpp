@@ -0,0 +1,177 @@
+/**
+ * @file test_raw.cpp
+ * @brief Tests the raw views on texts and attributes, of XmlLoader and XmlCursor,
+ * XmlView itself, and the options deciding what text() gives : XmlOptions::processEntities
+ * and XmlOptions::collapseWhitespace, and the XMLDocument setters behind them.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const char *crlf =
+	"<r>\r\n"
+	"<item a=\"x &amp; y\r\nz\" b=\"&#233;\">a &lt; b\r\nc &#233;</item>\r\n"
+	"<blank>  two \r\n  words  </blank>\r\n"
+	"<empty c=\"\"/>\r\n"
+	"</r>\r\n"; //!< Entities, and CRLF in a text and in an attribute.
+
+static const char *rawItem = "a &lt; b\r\nc &#233;";  //!< The text of item, as written.
+static const char *rawA    = "x &amp; y\r\nz";        //!< The attribute a of item, as written.
+
+/**
+ * @brief The views of the loader are on the characters as written, then on the
+ * decoded ones once text() or attribute() has read them.
+ */
+static void loader(void)
+{
+	XmlLoader loader(writeFile("raw.xml", crlf));
+	loader.element("item");
+	CHECK(loader.rawText() == rawItem);
+	CHECK(loader.rawAttribute("a") == rawA);
+	CHECK(loader.rawAttribute("b") == "&#233;");
+	CHECK(loader.rawText() == rawItem);
+
+	CHECK_EQUAL(loader.text<std::string>(), std::string("a < b\nc \xC3\xA9"));
+	CHECK_EQUAL(loader.rawText().str(), std::string("a < b\nc \xC3\xA9"));
+	CHECK_EQUAL(loader.attribute<std::string>("a"), std::string("x & y\nz"));
+	CHECK_EQUAL(loader.rawAttribute("a").str(), std::string("x & y\nz"));
+	CHECK(loader.rawAttribute("b") == "&#233;");
+
+	// No text, no attribute, no selection.
+	loader.backToRoot().element("empty");
+	CHECK(loader.rawText().empty());
+	CHECK(loader.rawText().data == nullptr);
+	CHECK(loader.rawAttribute("c").empty());
+	CHECK(loader.rawAttribute("c").data != nullptr);
+	CHECK(loader.rawAttribute("none").data == nullptr);
+	loader.backToRoot().element("nothing");
+	CHECK(loader.rawText().empty());
+	CHECK(loader.rawAttribute("a").empty());
+}
+
+/**
+ * @brief The views of a cursor are the same, and it reads the same buffer as the loader.
+ */
+static void cursor(void)
+{
+	XmlLoader loader(writeFile("raw.xml", crlf));
+	const std::vector<XmlCursor> items = loader.select("//item");
+	CHECK_EQUAL(items.size(), size_t(1));
+	const XmlCursor item = items.front();
+	CHECK(item.rawText() == rawItem);
+	CHECK(item.rawAttribute("a") == rawA);
+	CHECK(item.rawAttribute("none").data == nullptr);
+	CHECK(XmlCursor().rawText().empty());
+	CHECK(XmlCursor().rawAttribute("a").empty());
+
+	CHECK_EQUAL(item.text<std::string>(), std::string("a < b\nc \xC3\xA9"));
+	CHECK(item.rawText() == "a < b\nc \xC3\xA9");
+	CHECK(loader.element("item").rawText() == "a < b\nc \xC3\xA9");
+}
+
+/**
+ * @brief The views of a compacted document are still on the characters as written,
+ * in the new buffer : the ones decoded before are still decoded.
+ */
+static void compacted(void)
+{
+	XmlLoader loader(writeFile("raw.xml", crlf));
+	CHECK_EQUAL(loader.element("blank").text<std::string>(), std::string("  two \n  words  "));
+	loader.compact();
+	CHECK(loader.element("item").rawText() == rawItem);
+	CHECK(loader.rawAttribute("a") == rawA);
+	CHECK_EQUAL(loader.text<std::string>(), std::string("a < b\nc \xC3\xA9"));
+	CHECK(loader.rawText() == "a < b\nc \xC3\xA9");
+	CHECK(loader.backToRoot().element("blank").rawText() == "  two \n  words  ");
+}
+
+/**
+ * @brief What a view holds, copies and compares to.
+ */
+static void view(void)
+{
+	const XmlView none;
+	CHECK(none.empty());
+	CHECK_EQUAL(none.str(), std::string(""));
+	CHECK(none == "");
+	CHECK(!(none == "a"));
+
+	const char *text = "abcdef";
+	XmlView some;
+	some.data = text + 1;
+	some.size = 3;
+	CHECK(!some.empty());
+	CHECK_EQUAL(some.str(), std::string("bcd"));
+	CHECK(some == "bcd");
+	CHECK(!(some == "bc"));
+	CHECK(!(some == "bcde"));
+	CHECK(!(some == "bce"));
+#if __cplusplus >= 201703L
+	const std::string_view seen = some;
+	CHECK(seen == "bcd");
+#endif
+}
+
+/**
+ * @brief Without XmlOptions::processEntities, the entities are read as written ;
+ * with XmlOptions::collapseWhitespace, the blanks are collapsed. Both go on after a reload.
+ */
+static void options(void)
+{
+	const std::string fname = writeFile("raw.xml", crlf);
+	XmlLoader plain(fname);
+	CHECK_EQUAL(plain.element("blank").text<std::string>(), std::string("  two \n  words  "));
+
+	XmlOptions verbatim;
+	verbatim.processEntities = false;
+	XmlLoader entities(fname, verbatim);
+	CHECK_EQUAL(entities.element("item").text<std::string>(), std::string("a &lt; b\nc &#233;"));
+	CHECK_EQUAL(entities.attribute<std::string>("a"), std::string("x &amp; y\nz"));
+	entities.reload(fname);
+	CHECK_EQUAL(entities.element("item").text<std::string>(), std::string("a &lt; b\nc &#233;"));
+
+	XmlOptions collapsed;
+	collapsed.collapseWhitespace = true;
+	XmlLoader blanks(fname, collapsed);
+	CHECK_EQUAL(blanks.element("blank").text<std::string>(), std::string("two words"));
+	CHECK_EQUAL(blanks.backToRoot().element("item").text<std::string>(), std::string("a < b c \xC3\xA9"));
+	blanks.reload(fname);
+	CHECK_EQUAL(blanks.element("blank").text<std::string>(), std::string("two words"));
+}
+
+/**
+ * @brief The setters of XMLDocument change the modes its constructor sets, for the next parse.
+ */
+static void document(void)
+{
+	xml2::XMLDocument doc;
+	CHECK(doc.ProcessEntities());
+	CHECK(doc.WhitespaceMode() == xml2::PRESERVE_WHITESPACE);
+	doc.SetProcessEntities(false);
+	doc.SetWhitespaceMode(xml2::COLLAPSE_WHITESPACE);
+	CHECK(!doc.ProcessEntities());
+	CHECK(doc.WhitespaceMode() == xml2::COLLAPSE_WHITESPACE);
+	doc.Parse(crlf);
+	CHECK_EQUAL(std::string(doc.RootElement()->FirstChildElement("item")->GetText()), std::string("a &lt; b c &#233;"));
+	CHECK_EQUAL(std::string(doc.RootElement()->FirstChildElement("blank")->GetText()), std::string("two words"));
+
+	doc.SetProcessEntities(true);
+	doc.SetWhitespaceMode(xml2::PRESERVE_WHITESPACE);
+	doc.Parse(crlf);
+	CHECK_EQUAL(std::string(doc.RootElement()->FirstChildElement("item")->GetText()), std::string("a < b\nc \xC3\xA9"));
+	CHECK_EQUAL(std::string(doc.RootElement()->FirstChildElement("blank")->GetText()), std::string("  two \n  words  "));
+}
+
+int main(void)
+{
+	run("raw loader", loader);
+	run("raw cursor", cursor);
+	run("raw compacted", compacted);
+	run("raw view", view);
+	run("raw options", options);
+	run("raw document", document);
+	return summary();
+}
@@ -0,0 +1,112 @@
+/**
+ * @file test_reload.cpp
+ * @brief Tests that reloading keeps the memory pools and the character buffer
+ * of the previous document, so that reloading documents of the same shape
+ * stops allocating.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <cstdlib>
+#include <new>
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static size_t allocations = 0; //!< The number of calls to operator new so far.
+
+void* operator new(size_t size)
+{
+	++allocations;
+	if (void *p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+/**
+ * @brief The price of every record, summed, to check what was loaded.
+ */
+static double total(XmlLoader &loader)
+{
+	double sum = 0.0;
+	loader.forEachNodeNamed("record", [&]() {
+		sum += loader.element("price").text<double>();
+	});
+	return sum;
+}
+
+/**
+ * @brief Reloading a buffer of the same shape allocates nothing once warm.
+ */
+static void reloadBuffer(void)
+{
+	const std::string small = catalog(100);
+	const std::string large = catalog(2000);
+	XmlLoader loader(writeFile("reload.xml", large));
+	CHECK_EQUAL(total(loader), 2000.0 * 2000.0 / 2.0);
+	loader.reload(small.data(), small.size());
+	CHECK_EQUAL(total(loader), 100.0 * 100.0 / 2.0);
+
+	const size_t before = allocations;
+	loader.reload(large.data(), large.size());
+	const size_t reloading = allocations - before;
+	CHECK_EQUAL(reloading, 0u);
+	CHECK_EQUAL(total(loader), 2000.0 * 2000.0 / 2.0);
+}
+
+/**
+ * @brief Reloading a file allocates the same, whatever the number of records,
+ * once the biggest one has been loaded.
+ */
+static void reloadFile(void)
+{
+	writeFile("reload-small.xml", catalog(100));
+	writeFile("reload-large.xml", catalog(5000));
+	XmlLoader loader("reload-large.xml");
+	loader.reload("reload-small.xml");
+
+	size_t before = allocations;
+	loader.reload("reload-small.xml");
+	const size_t small = allocations - before;
+	before = allocations;
+	loader.reload("reload-large.xml");
+	const size_t large = allocations - before;
+	CHECK_EQUAL(small, large);
+	CHECK(large < 64);
+	CHECK_EQUAL(total(loader), 5000.0 * 5000.0 / 2.0);
+}
+
+/**
+ * @brief The state of the previous document is dropped.
+ */
+static void reloadResets(void)
+{
+	writeFile("reload-a.xml", "<a><x>1</x></a>");
+	writeFile("reload-b.xml", "<b><y>2</y></b>");
+	XmlLoader loader("reload-a.xml");
+	CHECK_EQUAL(loader.element("x").text<int>(), 1);
+	loader.freeze();
+	loader.reload("reload-b.xml");
+	CHECK(!loader.frozen());
+	CHECK_EQUAL(loader.name(), std::string("b"));
+	CHECK_EQUAL(loader.element("y").text<int>(), 2);
+	CHECK_THROWS(loader.reload("reload-missing.xml"));
+}
+
+int main(void)
+{
+	run("reload buffer", reloadBuffer);
+	run("reload file", reloadFile);
+	run("reload resets", reloadResets);
+	return summary();
+}
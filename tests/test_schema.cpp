@@ -0,0 +1,316 @@
+/**
+ * @file test_schema.cpp
+ * @brief Tests XmlSchema : the content models, the attributes and the facets
+ * it checks, the schemas it refuses, where its errors are, and the checks of
+ * the loader, streamed, lazy or projected.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <memory>
+#include "XmlLoader.hpp"
+#include "XmlSchema.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const char *xsd =
+	"<xs:schema xmlns:xs=\"http://www.w3.org/2001/XMLSchema\">\n"
+	"<xs:simpleType name=\"code\"><xs:restriction base=\"xs:string\">"
+	"<xs:pattern value=\"[A-Z]{2}-[0-9]+\"/><xs:minLength value=\"4\"/><xs:maxLength value=\"8\"/>"
+	"</xs:restriction></xs:simpleType>\n"
+	"<xs:simpleType name=\"kind\"><xs:restriction base=\"xs:string\">"
+	"<xs:enumeration value=\"book\"/><xs:enumeration value=\"disc\"/>"
+	"</xs:restriction></xs:simpleType>\n"
+	"<xs:simpleType name=\"price\"><xs:restriction base=\"xs:decimal\">"
+	"<xs:minInclusive value=\"0\"/><xs:maxExclusive value=\"1000\"/>"
+	"</xs:restriction></xs:simpleType>\n"
+	"<xs:simpleType name=\"label\"><xs:restriction base=\"xs:string\">"
+	"<xs:whiteSpace value=\"collapse\"/><xs:length value=\"3\"/>"
+	"</xs:restriction></xs:simpleType>\n"
+	"<xs:simpleType name=\"raw\"><xs:restriction base=\"xs:string\"><xs:length value=\"3\"/></xs:restriction></xs:simpleType>\n"
+	"<xs:element name=\"catalog\"><xs:complexType><xs:sequence>\n"
+	"<xs:element name=\"record\" minOccurs=\"0\" maxOccurs=\"unbounded\"><xs:complexType>\n"
+	"<xs:sequence>\n"
+	"<xs:element name=\"name\" type=\"xs:string\"/>\n"
+	"<xs:choice minOccurs=\"1\" maxOccurs=\"2\"><xs:element name=\"price\" type=\"price\"/><xs:element name=\"free\"/></xs:choice>\n"
+	"<xs:element name=\"tag\" type=\"label\" minOccurs=\"0\" maxOccurs=\"3\"/>\n"
+	"<xs:element name=\"stock\" type=\"xs:unsignedByte\" minOccurs=\"0\"/>\n"
+	"<xs:element name=\"delta\" type=\"xs:byte\" minOccurs=\"0\"/>\n"
+	"<xs:element name=\"note\" type=\"raw\" minOccurs=\"0\"/>\n"
+	"</xs:sequence>\n"
+	"<xs:attribute name=\"id\" type=\"code\" use=\"required\"/>\n"
+	"<xs:attribute name=\"kind\" type=\"kind\"/>\n"
+	"</xs:complexType></xs:element>\n"
+	"</xs:sequence></xs:complexType></xs:element>\n"
+	"</xs:schema>\n"; //!< The schema of every test.
+
+/**
+ * @brief The schema of every test, compiled.
+ */
+static std::shared_ptr<const XmlSchema> compiled(void)
+{
+	return std::make_shared<XmlSchema>(writeFile("schema.xsd", xsd));
+}
+
+/**
+ * @brief What is wrong with \a xml, "" if it is valid.
+ */
+static std::string errorOf(const XmlSchema &schema, const std::string &xml)
+{
+	xml2::XMLDocument doc;
+	CHECK_EQUAL(doc.Parse(xml.c_str()), xml2::XML_SUCCESS);
+	std::string error;
+	const bool valid = schema.validate(doc.RootElement(), error);
+	CHECK_EQUAL(valid, error.empty());
+	return error;
+}
+
+/**
+ * @brief What is wrong with a catalog of one record with \a attributes and the content \a content, "" if it is valid.
+ */
+static std::string recordError(const XmlSchema &schema, const std::string &content, const std::string &attributes = "id=\"AB-1\"")
+{
+	return errorOf(schema, "<catalog><record " + attributes + ">" + content + "</record></catalog>");
+}
+
+/**
+ * @brief Tell if \a text holds \a part.
+ */
+static bool has(const std::string &text, const std::string &part)
+{
+	return text.find(part) != std::string::npos;
+}
+
+/**
+ * @brief The sequence, the choice between two elements and their occurrences.
+ */
+static void content(void)
+{
+	const std::shared_ptr<const XmlSchema> schema = compiled();
+	CHECK_EQUAL(errorOf(*schema, "<catalog/>"), std::string(""));
+	CHECK_EQUAL(errorOf(*schema, "<catalog>\n  <!-- none -->\n</catalog>"), std::string(""));
+	CHECK_EQUAL(recordError(*schema, "<name>a</name><price>1</price>"), std::string(""));
+	CHECK_EQUAL(recordError(*schema, "<name>a</name><free><any x=\"1\">thing</any></free><price>1</price>"), std::string(""));
+	CHECK_EQUAL(recordError(*schema, "<name>a</name><price>1</price><tag>abc</tag><tag>abc</tag><tag>abc</tag>"
+	                                 "<stock>3</stock><delta>-3</delta><note>abc</note>"), std::string(""));
+	CHECK_EQUAL(recordError(*schema, "<name>a</name><free/><note>abc</note>"), std::string(""));
+
+	// The sequence, in order, each element as many times as it may.
+	CHECK(has(recordError(*schema, "<price>1</price>"), "<price> is not allowed here"));
+	CHECK(has(recordError(*schema, "<name>a</name>"), "the content ends too early, <price> or <free> was expected"));
+	CHECK(has(recordError(*schema, "<name>a</name><tag>abc</tag>"), "<tag> is not allowed here"));
+	CHECK(has(recordError(*schema, "<name>a</name><price>1</price><free/><price>1</price>"), "<price> is not allowed here"));
+	CHECK(has(recordError(*schema, "<name>a</name><name>b</name><price>1</price>"), "<name> is not allowed here"));
+	CHECK(has(recordError(*schema, "<name>a</name><price>1</price><tag>abc</tag><tag>abc</tag><tag>abc</tag><tag>abc</tag>"),
+	          "<tag> is not allowed here"));
+	CHECK(has(recordError(*schema, "<name>a</name><price>1</price><stock>3</stock><tag>abc</tag>"), "<tag> is not allowed here"));
+	CHECK(has(recordError(*schema, "<name>a</name><price>1</price><other/>"), "<other> is not allowed here"));
+	CHECK(has(recordError(*schema, "<name>a</name>text<price>1</price>"), "text is not allowed in <record>"));
+	CHECK(has(recordError(*schema, "<name><b/></name><price>1</price>"), "<name> cannot have child elements"));
+	CHECK(has(errorOf(*schema, "<list/>"), "<list> is not declared as a global element"));
+}
+
+/**
+ * @brief The required, undeclared and typed attributes.
+ */
+static void attributes(void)
+{
+	const std::shared_ptr<const XmlSchema> schema = compiled();
+	const std::string body = "<name>a</name><price>1</price>";
+	CHECK_EQUAL(recordError(*schema, body, "id=\"AB-1\" kind=\"book\""), std::string(""));
+	CHECK(has(recordError(*schema, body, ""), "the attribute id is required"));
+	CHECK(has(recordError(*schema, body, "kind=\"book\""), "the attribute id is required"));
+	CHECK(has(recordError(*schema, body, "id=\"AB-1\" color=\"red\""), "the attribute color is not declared"));
+	CHECK(has(recordError(*schema, body, "id=\"AB-1\" kind=\"cd\""), "the attribute kind : "));
+}
+
+/**
+ * @brief Each family of facets, and the ranges of the integer builtins.
+ */
+static void facets(void)
+{
+	const std::shared_ptr<const XmlSchema> schema = compiled();
+	const auto price = [&](const std::string &value) { return recordError(*schema, "<name>a</name><price>" + value + "</price>"); };
+	const auto field = [&](const std::string &name, const std::string &value) {
+		return recordError(*schema, "<name>a</name><free/><" + name + ">" + value + "</" + name + ">");
+	};
+	const auto id = [&](const std::string &value) {
+		return recordError(*schema, "<name>a</name><free/>", "id=\"" + value + "\"");
+	};
+
+	// Enumeration.
+	CHECK_EQUAL(recordError(*schema, "<name>a</name><free/>", "id=\"AB-1\" kind=\"disc\""), std::string(""));
+	CHECK(has(recordError(*schema, "<name>a</name><free/>", "id=\"AB-1\" kind=\"Book\""), "is not one of the values of kind"));
+
+	// Numeric bounds, inclusive and exclusive, and the syntax of a decimal.
+	for (const char *valid : {"0", "0.0", "999.99", "+5", " 12.5 "})
+		CHECK_EQUAL(price(valid), std::string(""));
+	CHECK(has(price("-0.01"), "is below the minimum of price"));
+	CHECK(has(price("1000"), "is above the maximum of price"));
+	CHECK(has(price("1e2"), "is not a valid price"));
+	CHECK(has(price("abc"), "is not a valid price"));
+	CHECK(has(price(""), "is not a valid price"));
+
+	// Lengths and pattern.
+	for (const char *valid : {"AB-1", "AB-12345", "ZZ-0"})
+		CHECK_EQUAL(id(valid), std::string(""));
+	CHECK(has(id("AB-"), "does not have the length of code"));
+	CHECK(has(id("AB-123456"), "does not have the length of code"));
+	CHECK(has(id("ab-1234"), "does not match the pattern of code"));
+	CHECK(has(id("AB-12x"), "does not match the pattern of code"));
+
+	// whiteSpace : collapsed, the blanks around are dropped and each run within is one space ; preserved, they count.
+	for (const char *valid : {"abc", "  abc  ", "a b", "a   b", "\ta\n\tb ", "\xC3\xA9t\xC3\xA9"})
+		CHECK_EQUAL(field("tag", valid), std::string(""));
+	CHECK(has(field("tag", "abcd"), "does not have the length of label"));
+	CHECK(has(field("tag", " a  b  c "), "does not have the length of label"));
+	for (const char *valid : {"abc", " ab", "a b", "a\t\t"})
+		CHECK_EQUAL(field("note", valid), std::string(""));
+	CHECK(has(field("note", " abc "), "does not have the length of raw"));
+
+	// The integer builtins.
+	for (const char *valid : {"0", "255", " 12 ", "+7"})
+		CHECK_EQUAL(field("stock", valid), std::string(""));
+	CHECK(has(field("stock", "256"), "is above the maximum of xs:unsignedByte"));
+	CHECK(has(field("stock", "-1"), "is below the minimum of xs:unsignedByte"));
+	CHECK(has(field("stock", "1.5"), "is not a valid xs:unsignedByte"));
+	for (const char *valid : {"-128", "127"})
+		CHECK_EQUAL(field("delta", valid), std::string(""));
+	CHECK(has(field("delta", "-129"), "is below the minimum of xs:byte"));
+	CHECK(has(field("delta", "128"), "is above the maximum of xs:byte"));
+}
+
+/**
+ * @brief What is out of the subset makes the schema fail to load.
+ */
+static void refused(void)
+{
+	const std::string head = "<xs:schema xmlns:xs=\"http://www.w3.org/2001/XMLSchema\"><xs:element name=\"a\"><xs:complexType>";
+	const std::string tail = "</xs:complexType></xs:element></xs:schema>";
+	for (const std::string &body : {std::string("<xs:all><xs:element name=\"b\"/></xs:all>"),
+	                                std::string("<xs:sequence><xs:any/></xs:sequence>"),
+	                                std::string("<xs:sequence><xs:element name=\"b\"><xs:unique name=\"u\"><xs:selector xpath=\"c\"/>"
+	                                            "<xs:field xpath=\"@id\"/></xs:unique></xs:element></xs:sequence>"),
+	                                std::string("<xs:sequence><xs:element name=\"b\"><xs:key name=\"k\"><xs:selector xpath=\"c\"/>"
+	                                            "<xs:field xpath=\"@id\"/></xs:key></xs:element></xs:sequence>")})
+	{
+		CHECK_THROWS(XmlSchema(writeFile("schema-bad.xsd", head + body + tail)));
+	}
+	CHECK_THROWS(XmlSchema(writeFile("schema-bad.xsd", "<xs:element xmlns:xs=\"http://www.w3.org/2001/XMLSchema\" name=\"a\"/>")));
+	CHECK_THROWS(XmlSchema("schema-missing.xsd"));
+	// The same schema, in the subset, loads.
+	XmlSchema(writeFile("schema-good.xsd", head + "<xs:sequence><xs:element name=\"b\"/></xs:sequence>" + tail));
+}
+
+/**
+ * @brief An error gives the path of the element, with the position among the
+ * siblings of its name, and its line, or its offset if the lines are not counted.
+ */
+static void errors(void)
+{
+	const std::shared_ptr<const XmlSchema> schema = compiled();
+	const std::string xml =
+		"<catalog>\n"
+		"<record id=\"AB-1\"><name>a</name><price>1</price></record>\n"
+		"<record id=\"AB-2\">\n"
+		"\t<name>b</name>\n"
+		"\t<price>1</price><price>-1</price>\n"
+		"</record>\n"
+		"</catalog>\n";
+	xml2::XMLDocument doc;
+	doc.SetTrackLines(true);
+	doc.Parse(xml.c_str());
+	std::string error;
+	CHECK(!schema->validate(doc.RootElement(), error));
+	CHECK_EQUAL(error, std::string("/catalog/record[2]/price[2] (line 5) : '-1' is below the minimum of price"));
+	CHECK_EQUAL(errorOf(*schema, xml), "/catalog/record[2]/price[2] (byte " + std::to_string(xml.find("<price>-1")) + ") : '-1' is below the minimum of price");
+
+	doc.Parse("<catalog>\n\n<record><name>a</name><free/></record></catalog>");
+	CHECK(!schema->validate(doc.RootElement(), error));
+	CHECK_EQUAL(error, std::string("/catalog/record (line 3) : the attribute id is required"));
+}
+
+/**
+ * @brief The loader checks each document it loads, and each record it streams
+ * as it is read : the records before an invalid one are read.
+ */
+static void loader(void)
+{
+	XmlOptions options;
+	options.schema = compiled();
+	std::string valid("<catalog>\n");
+	for (int i = 0; i < 5; ++i)
+		valid += "<record id=\"AB-" + std::to_string(i) + "\"><name>r</name><price>" + std::to_string(i) + "</price></record>\n";
+	const std::string invalid = valid.substr(0, valid.size() - 1) + "<record id=\"AB-5\"><name>r</name></record>\n"
+	                            "<record id=\"AB-6\"><name>r</name><free/></record>\n";
+	CHECK_EQUAL(XmlLoader(writeFile("schema.xml", valid + "</catalog>\n"), options).name(), std::string("catalog"));
+	CHECK_THROWS(XmlLoader(writeFile("schema-invalid.xml", invalid + "</catalog>\n"), options));
+	XmlLoader reloaded("schema.xml", options);
+	CHECK_THROWS(reloaded.reload("schema-invalid.xml"));
+
+	options.streaming = true;
+	size_t records = 0;
+	XmlLoader streamed("schema.xml", options);
+	streamed.forEachNodeNamed("record", [&]() { ++records; });
+	CHECK_EQUAL(records, 5u);
+	records = 0;
+	XmlLoader broken("schema-invalid.xml", options);
+	CHECK_THROWS(broken.forEachNodeNamed("record", [&]() { ++records; }));
+	CHECK_EQUAL(records, 5u);
+}
+
+/**
+ * @brief A record checked alone : its root and its own content, not the number of records.
+ */
+static void records(void)
+{
+	const std::shared_ptr<const XmlSchema> schema = compiled();
+	xml2::XMLDocument doc;
+	std::string error;
+	doc.Parse("<catalog><record id=\"AB-1\"><name>a</name><free/></record></catalog>");
+	CHECK(schema->validateRecord(doc.RootElement(), error));
+	doc.Parse("<catalog/>");
+	CHECK(schema->validateRecord(doc.RootElement(), error));
+	doc.Parse("<catalog><record id=\"AB-1\"><name>a</name></record></catalog>");
+	CHECK(!schema->validateRecord(doc.RootElement(), error));
+	CHECK(has(error, "/catalog/record (byte 9) : the content ends too early"));
+	doc.Parse("<catalog><name>a</name></catalog>");
+	CHECK(!schema->validateRecord(doc.RootElement(), error));
+	CHECK(has(error, "<name> is not allowed here"));
+	doc.Parse("<list><record/></list>");
+	CHECK(!schema->validateRecord(doc.RootElement(), error));
+}
+
+/**
+ * @brief A lazy load is parsed whole to be checked ; keepPaths and a schema are refused together.
+ */
+static void lazy(void)
+{
+	XmlOptions options;
+	options.schema    = compiled();
+	options.lazyDepth = 2;
+	writeFile("schema.xml", "<catalog><record id=\"AB-1\"><name>a</name><price>1</price></record></catalog>");
+	writeFile("schema-invalid.xml", "<catalog><record id=\"AB-1\"><name>a</name><price>-1</price></record></catalog>");
+	XmlLoader loader("schema.xml", options);
+	CHECK_EQUAL(loader.node("record").element("price").text<int>(), 1);
+	CHECK_THROWS(XmlLoader("schema-invalid.xml", options));
+	options.schema.reset();
+	CHECK_EQUAL(XmlLoader("schema-invalid.xml", options).node("record").element("price").text<int>(), -1);
+
+	options.schema = compiled();
+	options.keepPaths = {"catalog/record/name"};
+	CHECK_THROWS(XmlLoader("schema.xml", options));
+}
+
+int main(void)
+{
+	run("schema content", content);
+	run("schema attributes", attributes);
+	run("schema facets", facets);
+	run("schema refused", refused);
+	run("schema errors", errors);
+	run("schema loader", loader);
+	run("schema records", records);
+	run("schema lazy", lazy);
+	return summary();
+}
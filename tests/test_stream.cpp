@@ -0,0 +1,99 @@
+/**
+ * @file test_stream.cpp
+ * @brief Tests that a file streamed record by record reads as the file loaded
+ * at once, with records smaller and larger than the window, compressed or not.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <vector>
+#include "XmlLoader.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+/**
+ * @brief The id and the number of items of every record.
+ */
+static std::string summarize(XmlLoader &loader)
+{
+	std::string seen;
+	loader.forEachNodeNamed("record", [&](XmlCursor record) {
+		size_t items = 0;
+		for (XmlCursor item : record.children("item"))
+			items += (item.attribute<unsigned int>("n") == items) ? 1 : 0;
+		seen += record.attribute<std::string>("id") + ":" + std::to_string(items) + ";";
+	});
+	return seen;
+}
+
+/**
+ * @brief A streamed loader.
+ */
+static XmlOptions streaming(void)
+{
+	XmlOptions options;
+	options.streaming = true;
+	return options;
+}
+
+/**
+ * @brief Records of 1 MB, four times the window, then of 100 bytes.
+ */
+static void sizes(void)
+{
+	for (size_t bytes : {1024 * 1024, 100})
+	{
+		writeFile("stream.xml", bigRecords(bytes > 1000 ? 6 : 5000, bytes));
+		XmlLoader whole("stream.xml");
+		XmlLoader streamed("stream.xml", streaming());
+		const std::string expected = summarize(whole);
+		CHECK(!expected.empty());
+		CHECK_EQUAL(summarize(streamed), expected);
+
+		// Streamed again from the start, the offsets being the ones in each record.
+		std::vector<size_t> spans;
+		whole.forEachNodeNamed("record", [&]() {
+			spans.push_back(whole.sourceEnd() - whole.sourceBegin());
+		});
+		size_t records = 0;
+		streamed.forEachNodeNamed("record", [&]() {
+			CHECK_EQUAL(streamed.sourceBegin(), 0u);
+			CHECK(records < spans.size() && streamed.sourceEnd() == spans[records]);
+			++records;
+		});
+		CHECK_EQUAL(records, bytes > 1000 ? 6u : 5000u);
+	}
+}
+
+#ifdef RWXML_WITH_ZLIB
+/**
+ * @brief A gzip file streams as its content.
+ */
+static void compressed(void)
+{
+	const std::string xml = bigRecords(4, 600 * 1024);
+	XmlLoader whole(writeFile("stream.xml", xml));
+	XmlLoader streamed(writeGzip("stream.xml.gz", xml), streaming());
+	CHECK_EQUAL(summarize(streamed), summarize(whole));
+}
+#endif
+
+/**
+ * @brief A record cut by the end of the file fails.
+ */
+static void truncated(void)
+{
+	const std::string xml = bigRecords(3, 400 * 1024);
+	XmlLoader streamed(writeFile("stream-cut.xml", xml.substr(0, xml.size() - 1000)), streaming());
+	CHECK_THROWS(summarize(streamed));
+}
+
+int main(void)
+{
+	run("stream sizes", sizes);
+#ifdef RWXML_WITH_ZLIB
+	run("stream compressed", compressed);
+#endif
+	run("stream truncated", truncated);
+	return summary();
+}
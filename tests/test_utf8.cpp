@@ -0,0 +1,172 @@
+/**
+ * @file test_utf8.cpp
+ * @brief Tests XmlUnicode::validUtf8() : the offset of the first invalid byte
+ * of each kind of error, wherever it falls in the blocks checked at once, and
+ * the option XmlOptions::validateUtf8 of the loader.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ */
+#include <random>
+#include "XmlLoader.hpp"
+#include "XmlUnicode.hpp"
+#include "check.hpp"
+#include "fixtures.hpp"
+
+static const size_t valid = std::string::npos; //!< The offset of a text with no error.
+
+/**
+ * @brief A text, and the offset of its first invalid byte.
+ */
+struct Case
+{
+	std::string text;  //!< The bytes to check.
+	size_t      error; //!< The offset of the first invalid byte, or \b valid.
+};
+
+static const Case cases[] = {
+	{"", valid}, {"a", valid}, {"\xC2\x80", valid}, {"\xDF\xBF", valid},
+	{"\xE0\xA0\x80", valid}, {"\xED\x9F\xBF", valid}, {"\xEE\x80\x80", valid}, {"\xEF\xBF\xBF", valid},
+	{"\xF0\x90\x80\x80", valid}, {"\xF4\x8F\xBF\xBF", valid}, {"\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80", valid},
+	// Stray continuations.
+	{"\x80", 0}, {"a\xBF", 1}, {"\xC2\x80\x80", 2}, {"\xE2\x82\xAC\x80", 3}, {"\xF0\x9F\x98\x80\x80", 4},
+	// Leads not followed by enough continuations.
+	{"\xC2" "a", 0}, {"\xE2\x82" "a", 0}, {"\xE2" "a\x82", 0}, {"\xF0\x9F\x98" "a", 0}, {"\xC2\xC2\x80", 0},
+	// Overlong forms.
+	{"\xC0\x80", 0}, {"\xC1\xBF", 0}, {"a\xC0\xAF", 1},
+	{"\xE0\x80\x80", 0}, {"\xE0\x9F\xBF", 0}, {"\xC3\xA9\xE0\x80\xAF", 2},
+	{"\xF0\x80\x80\x80", 0}, {"\xF0\x8F\xBF\xBF", 0},
+	// Surrogates.
+	{"\xED\xA0\x80", 0}, {"\xED\xBF\xBF", 0}, {"a\xED\xB0\x80", 1},
+	// Above U+10FFFF, and the bytes which never start a character.
+	{"\xF4\x90\x80\x80", 0}, {"\xF5\x80\x80\x80", 0}, {"\xF7\xBF\xBF\xBF", 0},
+	{"\xF8\x88\x80\x80\x80", 0}, {"\xFE", 0}, {"\xFF", 0},
+	// Characters truncated by the end.
+	{"\xC2", 0}, {"a\xE2\x82", 1}, {"\xF0\x9F\x98", 0}, {"\xF0", 0},
+};
+
+/**
+ * @brief The size of the longest valid beginning of \a text, decoded one code point at a time.
+ */
+static size_t reference(const std::string &text)
+{
+	static const uint32_t least[5] = {0, 0, 0x80, 0x800, 0x10000};
+	size_t at = 0;
+	while (at < text.size())
+	{
+		const unsigned char lead = static_cast<unsigned char>(text[at]);
+		size_t   size = 1;
+		uint32_t code = lead;
+		if (lead >= 0x80)
+		{
+			if ((lead & 0xE0) == 0xC0)      { size = 2; code = lead & 0x1F; }
+			else if ((lead & 0xF0) == 0xE0) { size = 3; code = lead & 0x0F; }
+			else if ((lead & 0xF8) == 0xF0) { size = 4; code = lead & 0x07; }
+			else return at;
+			if (at + size > text.size())
+				return at;
+			for (size_t i = 1; i < size; ++i)
+			{
+				const unsigned char next = static_cast<unsigned char>(text[at + i]);
+				if ((next & 0xC0) != 0x80)
+					return at;
+				code = (code << 6) | (next & 0x3F);
+			}
+			if (code < least[size] || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF))
+				return at;
+		}
+		at += size;
+	}
+	return at;
+}
+
+/**
+ * @brief \a count times \a piece.
+ */
+static std::string times(const std::string &piece, size_t count)
+{
+	std::string out;
+	for (size_t i = 0; i < count; ++i)
+		out += piece;
+	return out;
+}
+
+/**
+ * @brief Each case gives its exact offset alone, after ASCII or other characters,
+ * and followed by ASCII or other characters : the error falls at every place of
+ * the blocks, and across two of them.
+ */
+static void table(void)
+{
+	std::vector<std::string> before, after;
+	for (size_t n = 0; n <= 50; ++n)
+		before.push_back(std::string(n, 'x'));
+	for (size_t n : {1u, 5u, 11u, 16u, 30u})
+		before.push_back(times("\xC3\xA9", n) + times("\xE2\x82\xAC", n % 3) + times("\xF0\x9F\x98\x80", n % 4));
+	for (size_t n : {0u, 1u, 15u, 16u, 17u, 31u, 32u, 33u, 47u, 48u, 64u, 100u})
+		after.push_back(std::string(n, 'y'));
+	after.push_back(times("\xE2\x82\xAC", 20));
+
+	for (const Case &test : cases)
+	{
+		CHECK_EQUAL(reference(test.text), (test.error == valid) ? test.text.size() : test.error);
+		for (const std::string &head : before)
+		{
+			for (const std::string &tail : after)
+			{
+				const std::string text = head + test.text + tail;
+				const size_t expected = (test.error == valid) ? text.size() : head.size() + test.error;
+				CHECK_EQUAL(XmlUnicode::validUtf8(text.data(), text.size()), expected);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Random texts, mostly valid, give the offset a decoder finds.
+ */
+static void decoded(void)
+{
+	static const char *pieces[] = {"a", "bcdefghijklmnopqrstuvwxyz0123456789", "\xC3\xA9", "\xDF\xBF", "\xE2\x82\xAC",
+	                               "\xEF\xBF\xBF", "\xF0\x9F\x98\x80", "\xF4\x8F\xBF\xBF", "<tag attr=\"value\">"};
+	std::mt19937 generator(2026);
+	for (int run = 0; run < 20000; ++run)
+	{
+		std::string text;
+		const size_t count = generator() % 60;
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (generator() % 40 == 0)
+				text += static_cast<char>(0x80 + generator() % 0x80);
+			else
+				text += pieces[generator() % (sizeof(pieces) / sizeof(pieces[0]))];
+		}
+		if (generator() % 10 == 0 && !text.empty())
+			text.resize(generator() % text.size());
+		CHECK_EQUAL(XmlUnicode::validUtf8(text.data(), text.size()), reference(text));
+	}
+}
+
+/**
+ * @brief With XmlOptions::validateUtf8, the load fails on an invalid byte ; without, it does not.
+ */
+static void loader(void)
+{
+	XmlOptions options;
+	options.validateUtf8 = true;
+	const std::string good = "<r><a b=\"\xC3\xA9\">" + times("\xE2\x82\xAC", 100) + "</a></r>";
+	const std::string bad  = "<r><a b=\"\xC3\xA9\">" + times("\xE2\x82\xAC", 100) + "\xED\xA0\x80</a></r>";
+	CHECK_EQUAL(XmlLoader(writeFile("utf8.xml", good), options).element("a").text<std::string>(), times("\xE2\x82\xAC", 100));
+	CHECK_THROWS(XmlLoader(writeFile("utf8.xml", bad), options));
+	CHECK_EQUAL(XmlLoader(writeFile("utf8.xml", bad)).name(), std::string("r"));
+	XmlLoader reloaded(writeFile("utf8.xml", good), options);
+	CHECK_THROWS(reloaded.reload(bad.data(), bad.size()));
+}
+
+int main(void)
+{
+	run("utf8 table", table);
+	run("utf8 decoded", decoded);
+	run("utf8 loader", loader);
+	return summary();
+}
@@ -0,0 +1,79 @@
+/**
+ * @file xmlindex.cpp
+ * @brief Build the sidecar index of a xml file, or print a record from it.
+ * @author MTLCRBN
+ * @version 1.0
+ * @date October 19th 2026
+ *
+ * @code
+ * xmlindex build catalog.xml catalog/record id   # writes catalog.xml.idx
+ * xmlindex get   catalog.xml 12                  # the 13th record
+ * xmlindex find  catalog.xml sku-42              # the record whose id is sku-42
+ * @endcode
+ * Build it with the sources of src : g++ -std=c++11 -Isrc tools/xmlindex.cpp and every src .cpp file.
+ */
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#include "XmlIndex.hpp"
+
+
+namespace
+{
+	//! @brief Print how to use the tool.
+	int usage(void)
+	{
+		std::cerr << "usage : xmlindex build <file> <record path> [key attribute]" << std::endl
+		          << "        xmlindex get   <file> <record number>"                << std::endl
+		          << "        xmlindex find  <file> <key>"                          << std::endl;
+		return 2;
+	}
+
+	//! @brief Print the record \a record of \a index as it is in the file.
+	int print(const XmlIndex &index, size_t record)
+	{
+		if (record == XmlIndex::npos)
+		{
+			std::cerr << "[WARNING] : No such record." << std::endl;
+			return 1;
+		}
+		const std::pair<size_t, size_t> range = index.range(record);
+		std::cout.write(index.data() + range.first, range.second - range.first);
+		std::cout << std::endl;
+		return 0;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 4)
+	{
+		return usage();
+	}
+	const std::string command = argv[1];
+	const std::string fname   = argv[2];
+	try
+	{
+		if (command == "build")
+		{
+			const size_t count = XmlIndex::build(fname, argv[3], (argc > 4) ? argv[4] : "");
+			std::cout << count << " records indexed in " << XmlIndex::sidecar(fname) << std::endl;
+			return 0;
+		}
+		if (command == "get")
+		{
+			return print(XmlIndex(fname), std::strtoull(argv[3], nullptr, 10));
+		}
+		if (command == "find")
+		{
+			const XmlIndex index(fname);
+			return print(index, index.find(argv[3]));
+		}
+	}
+	catch(const std::string &)
+	{
+		return 1;
+	}
+	return usage();
+}